@@ -1,33 +1,84 @@
 #include "cryptopals/analysis/aes_block_analyzer.h"
 
+#include <algorithm>
+#include <bit>
+#include <cstring>
 #include <vector>
 
+#include "absl/hash/hash.h"
 #include "cryptopals/util/aes.h"
-#include "cryptopals/util/bytes_util.h"
 
 namespace cryptopals::analysis {
+namespace {
 
 using cryptopals::util::AesState;
-using cryptopals::util::Bytes;
-using cryptopals::util::SplitBytes;
-
-double AesBlockAnalyzer::AnalyzeBytes(const Bytes& input) {
-  double matching_blocks_count = 0;
-  std::vector<Bytes> ciphertext_blocks =
-      SplitBytes(input, AesState::SIZE_BYTES);
-
-  for (auto b1 = ciphertext_blocks.begin(); b1 != ciphertext_blocks.end();
-       ++b1) {
-    for (auto b2 = b1 + 1; b2 != ciphertext_blocks.end(); ++b2) {
-      if (*b1 == *b2) {
-        matching_blocks_count++;
-      }
-    }
+using cryptopals::util::BytesView;
+
+// A distinct block and the number of times it has been seen. A slot that has
+// never been filled has a count of 0.
+struct BlockSlot {
+  uint64_t low;
+  uint64_t high;
+  size_t count;
+};
+
+// Returns the number of slots in a table for `num_blocks` blocks. The table is
+// a power of two at most half full, which keeps probe sequences short.
+size_t TableSize(size_t num_blocks) {
+  return std::bit_ceil(std::max<size_t>(2 * num_blocks, 16));
+}
+
+}  // namespace
+
+double AesBlockAnalyzer::AnalyzeBytes(BytesView input) {
+  const AesBlockRepeats repeats = CountRepeats(input);
+  if (repeats.num_blocks < 2) {
+    return 0.0;
   }
 
   // Normalize by dividing by the total number of pairs of blocks.
-  return matching_blocks_count /
-         (ciphertext_blocks.size() * (ciphertext_blocks.size() - 1) / 2);
+  return static_cast<double>(repeats.identical_pairs) /
+         (static_cast<double>(repeats.num_blocks) * (repeats.num_blocks - 1) /
+          2);
+}
+
+AesBlockRepeats AesBlockAnalyzer::CountRepeats(BytesView input) const {
+  const size_t num_whole_blocks = input.size() / AesState::SIZE_BYTES;
+  AesBlockRepeats repeats = {
+      .num_blocks =
+          (input.size() + AesState::SIZE_BYTES - 1) / AesState::SIZE_BYTES,
+  };
+
+  // Each block is read as two 64-bit words and looked up in an open
+  // addressing table with linear probing. A block that is already present
+  // forms an identical pair with every earlier copy of it.
+  std::vector<BlockSlot> table(TableSize(num_whole_blocks),
+                               BlockSlot{.count = 0});
+  const size_t slot_mask = table.size() - 1;
+  std::vector<size_t> block_slots(num_whole_blocks);
+  for (size_t block = 0; block < num_whole_blocks; ++block) {
+    uint64_t words[2];
+    std::memcpy(words, input.data() + block * AesState::SIZE_BYTES,
+                sizeof(words));
+
+    size_t slot = absl::HashOf(words[0], words[1]) & slot_mask;
+    while (table[slot].count != 0 &&
+           (table[slot].low != words[0] || table[slot].high != words[1])) {
+      slot = (slot + 1) & slot_mask;
+    }
+    if (table[slot].count == 0) {
+      table[slot].low = words[0];
+      table[slot].high = words[1];
+    }
+    repeats.identical_pairs += table[slot].count++;
+    block_slots[block] = slot;
+  }
+
+  repeats.repeat_counts.reserve(num_whole_blocks);
+  for (size_t slot : block_slots) {
+    repeats.repeat_counts.push_back(table[slot].count);
+  }
+  return repeats;
 }
 
 }  // namespace cryptopals::analysis
@@ -1,17 +1,39 @@
 #ifndef CRYPTOPALS_ANALYSIS_AES_BLOCK_ANALYZER_H_
 #define CRYPTOPALS_ANALYSIS_AES_BLOCK_ANALYZER_H_
 
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
 #include "cryptopals/analysis/analyzer.h"
 
 namespace cryptopals::analysis {
 
+// The repeated AES blocks found in an input.
+struct AesBlockRepeats {
+  // The number of blocks in the input, counting a trailing partial block.
+  size_t num_blocks = 0;
+
+  // The number of pairs of blocks that are identical.
+  uint64_t identical_pairs = 0;
+
+  // The number of times the contents of each block occur in the input, in the
+  // order of the blocks. Every whole block occurs at least once; a trailing
+  // partial block has no entry.
+  std::vector<size_t> repeat_counts;
+};
+
 // An analyzer that detects AES encryption in ECB mode.
 class AesBlockAnalyzer : public AnalyzerInterface {
  public:
   // Implements AnalyzeBytes from AnalyzerInterface. The score returned is the
   // number of pairs of AES blocks that are identical, scaled to the range
-  // [0-1].
-  double AnalyzeBytes(const cryptopals::util::Bytes& input) override;
+  // [0-1]. Inputs with fewer than two blocks score 0.
+  double AnalyzeBytes(cryptopals::util::BytesView input) override;
+
+  // Finds the repeated blocks in `input` with a single pass over a hash table
+  // of its blocks, so the cost is linear in the size of `input`.
+  AesBlockRepeats CountRepeats(cryptopals::util::BytesView input) const;
 };
 
 }  // namespace cryptopals::analysis
@@ -0,0 +1,70 @@
+#include "cryptopals/analysis/aes_block_analyzer.h"
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "cryptopals/util/bytes.h"
+#include "gtest/gtest.h"
+
+namespace cryptopals::analysis {
+
+using cryptopals::util::Bytes;
+
+// Joins one 16-byte block per char of `pattern`, each filled with that char.
+Bytes Blocks(std::string_view pattern) {
+  std::string raw;
+  for (char c : pattern) {
+    raw.append(16, c);
+  }
+  return Bytes::CreateFromRaw(raw);
+}
+
+TEST(AesBlockAnalyzerTest, AnalyzeBytesTest) {
+  AesBlockAnalyzer aes_block_analyzer;
+  // 2 identical pairs among the 10 pairs of 5 blocks.
+  EXPECT_DOUBLE_EQ(aes_block_analyzer.AnalyzeBytes(Blocks("abacb")), 0.2);
+  EXPECT_DOUBLE_EQ(aes_block_analyzer.AnalyzeBytes(Blocks("abcde")), 0.0);
+  EXPECT_DOUBLE_EQ(aes_block_analyzer.AnalyzeBytes(Blocks("aaaa")), 1.0);
+}
+
+TEST(AesBlockAnalyzerTest, AnalyzeBytesFewBlocksTest) {
+  AesBlockAnalyzer aes_block_analyzer;
+  EXPECT_EQ(aes_block_analyzer.AnalyzeBytes(Bytes()), 0.0);
+  EXPECT_EQ(aes_block_analyzer.AnalyzeBytes(Blocks("a")), 0.0);
+  EXPECT_EQ(aes_block_analyzer.AnalyzeBytes(Bytes::CreateFromRaw("abc")), 0.0);
+}
+
+TEST(AesBlockAnalyzerTest, CountRepeatsTest) {
+  // A trailing partial block counts towards the pairs but never matches.
+  Bytes input =
+      Bytes::CreateFromRaw(std::string(Blocks("abacbaa").ToRaw()) + "aaaa");
+
+  AesBlockAnalyzer aes_block_analyzer;
+  AesBlockRepeats repeats = aes_block_analyzer.CountRepeats(input);
+  EXPECT_EQ(repeats.num_blocks, 8);
+  // 6 pairs among the 4 copies of 'a', and 1 pair of 'b'.
+  EXPECT_EQ(repeats.identical_pairs, 7);
+  EXPECT_EQ(repeats.repeat_counts,
+            std::vector<size_t>({4, 2, 4, 1, 2, 4, 4}));
+}
+
+TEST(AesBlockAnalyzerTest, CountRepeatsManyBlocksTest) {
+  // Blocks that differ only in their second word, and repeats far apart.
+  std::string raw;
+  for (size_t i = 0; i < 3000; ++i) {
+    std::string block(16, '\0');
+    block[12] = static_cast<char>(i % 1000);
+    block[13] = static_cast<char>(i % 1000 >> 8);
+    raw += block;
+  }
+
+  AesBlockAnalyzer aes_block_analyzer;
+  AesBlockRepeats repeats =
+      aes_block_analyzer.CountRepeats(Bytes::CreateFromRaw(raw));
+  EXPECT_EQ(repeats.num_blocks, 3000);
+  EXPECT_EQ(repeats.identical_pairs, 3000);
+  EXPECT_EQ(repeats.repeat_counts, std::vector<size_t>(3000, 3));
+}
+
+}  // namespace cryptopals::analysis
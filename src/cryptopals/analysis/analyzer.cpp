@@ -4,13 +4,13 @@
 
 namespace cryptopals::analysis {
 
-double AnalyzerInterface::AnalyzeBytes(const cryptopals::util::Bytes& input) {
+double AnalyzerInterface::AnalyzeBytes(cryptopals::util::BytesView input) {
   LOG(ERROR) << "Invoked base implementation, use derived method instead";
   return 0.0;
 }
 
-double AnalyzerInterface::CompareBytes(const cryptopals::util::Bytes& lhs,
-                                       const cryptopals::util::Bytes& rhs) {
+double AnalyzerInterface::CompareBytes(cryptopals::util::BytesView lhs,
+                                       cryptopals::util::BytesView rhs) {
   LOG(ERROR) << "Invoked base implementation, use derived method instead";
   return 0.0;
 }
@@ -1,7 +1,7 @@
 #ifndef CRYPTOPALS_ANALYSIS_ANALYZER_H_
 #define CRYPTOPALS_ANALYSIS_ANALYZER_H_
 
-#include "cryptopals/util/bytes.h"
+#include "cryptopals/util/bytes_view.h"
 
 namespace cryptopals::analysis {
 
@@ -15,13 +15,13 @@ class AnalyzerInterface {
 
   // Calculate the match of `input` and return a score, represented as a double.
   // The derived class is responsible for determining the meaning of the score.
-  virtual double AnalyzeBytes(const cryptopals::util::Bytes& input);
+  virtual double AnalyzeBytes(cryptopals::util::BytesView input);
 
   // Calculate the comparison between `lhs` and `rhs` and return a score,
   // represented as a double. The derived class is responsbile for determining
   // the meaning of the score.
-  virtual double CompareBytes(const cryptopals::util::Bytes& lhs,
-                              const cryptopals::util::Bytes& rhs);
+  virtual double CompareBytes(cryptopals::util::BytesView lhs,
+                              cryptopals::util::BytesView rhs);
 };
 
 }  // namespace cryptopals::analysis
@@ -0,0 +1,112 @@
+#include "cryptopals/analysis/frequency_analyzer.h"
+
+#include <array>
+#include <cstdint>
+#include <memory>
+
+#include "absl/memory/memory.h"
+#include "cryptopals/analysis/data/oanc_english.h"
+#include "cryptopals/encoding/ascii.h"
+#include "cryptopals/util/bytes.h"
+#include "gtest/gtest.h"
+
+namespace cryptopals::analysis {
+namespace {
+
+using cryptopals::analysis::data::oanc_english::code_point_frequency;
+using cryptopals::util::Bytes;
+
+// Treats every byte as a 16-bit code point so that the generic analyzer can
+// be checked against the byte specialization.
+class WideByteEncoding
+    : public cryptopals::encoding::EncodingInterface<uint16_t> {
+ public:
+  HistogramType GenerateHistogram(
+      cryptopals::util::BytesView input) const override {
+    HistogramType histogram;
+    for (uint8_t byte : input) {
+      ++histogram[byte];
+    }
+    return histogram;
+  }
+};
+
+TEST(FrequencyAnalyzerTest, ChiSquared) {
+  FrequencyAnalyzer<uint8_t> analyzer(
+      absl::make_unique<cryptopals::encoding::AsciiEncoding>(),
+      {{'a', 0.5}, {'b', 0.5}, {'z', 0.0}});
+
+  // Expects a = 2.5 and b = 2.5 against a = 2, b = 1, z = 1 and c = 1. Code
+  // points that are never expected contribute the square of their count.
+  EXPECT_DOUBLE_EQ(analyzer.AnalyzeBytes(Bytes::CreateFromRaw("abazc")),
+                   0.25 / 2.5 + 2.25 / 2.5 + 1.0 + 1.0);
+  EXPECT_DOUBLE_EQ(analyzer.AnalyzeBytes(Bytes::CreateFromRaw("abab")), 0.0);
+  EXPECT_DOUBLE_EQ(analyzer.AnalyzeBytes(Bytes()), 0.0);
+}
+
+TEST(FrequencyAnalyzerTest, MatchesGenericAnalyzer) {
+  FrequencyAnalyzer<uint8_t> byte_analyzer(
+      absl::make_unique<cryptopals::encoding::AsciiEncoding>(),
+      code_point_frequency.begin(), code_point_frequency.end());
+  FrequencyAnalyzer<uint16_t> generic_analyzer(
+      absl::make_unique<WideByteEncoding>(), code_point_frequency.begin(),
+      code_point_frequency.end());
+
+  for (const Bytes& input :
+       {Bytes::CreateFromRaw("Now that the party is jumping"),
+        Bytes::CreateFromHex("1b37373331363f78151b7f2b783431333d78397828372d"
+                             "363c78373e783a393b3736"),
+        Bytes::CreateFromRaw("\x01\xff\x80 zzz")}) {
+    double expected = generic_analyzer.AnalyzeBytes(input);
+    EXPECT_NEAR(byte_analyzer.AnalyzeBytes(input), expected, expected * 1e-12)
+        << input;
+  }
+}
+
+TEST(FrequencyAnalyzerTest, AnalyzeHistogramAppliesXorMask) {
+  FrequencyAnalyzer<uint8_t> analyzer(
+      absl::make_unique<cryptopals::encoding::AsciiEncoding>(),
+      code_point_frequency.begin(), code_point_frequency.end());
+  cryptopals::encoding::AsciiEncoding encoding;
+
+  Bytes plaintext = Bytes::CreateFromRaw("Now that the party is jumping");
+  Bytes key = Bytes::CreateFromIntegral(uint8_t{0x35});
+  EXPECT_DOUBLE_EQ(
+      analyzer.AnalyzeHistogram(
+          encoding.GenerateDenseHistogram(plaintext ^ key), 0x35),
+      analyzer.AnalyzeBytes(plaintext));
+}
+
+TEST(FrequencyAnalyzerTest, AnalyzeHistogramXorMasksMatchesEachMask) {
+  FrequencyAnalyzer<uint8_t> analyzer(
+      absl::make_unique<cryptopals::encoding::AsciiEncoding>(),
+      code_point_frequency.begin(), code_point_frequency.end());
+  cryptopals::encoding::AsciiEncoding encoding;
+
+  for (const Bytes& input :
+       {Bytes(), Bytes::CreateFromRaw("Now that the party is jumping"),
+        Bytes::CreateFromRaw("\x01\xff\x80 zzz")}) {
+    const auto histogram = encoding.GenerateDenseHistogram(input);
+    std::array<double, 256> scores;
+    analyzer.AnalyzeHistogramXorMasks(histogram, scores);
+    for (size_t mask = 0; mask < scores.size(); ++mask) {
+      const double expected = analyzer.AnalyzeHistogram(histogram, mask);
+      EXPECT_NEAR(scores[mask], expected, expected * 1e-9)
+          << input << " ^ " << mask;
+    }
+  }
+}
+
+TEST(FrequencyAnalyzerTest, PrefersEnglish) {
+  FrequencyAnalyzer<uint8_t> analyzer(
+      absl::make_unique<cryptopals::encoding::AsciiEncoding>(),
+      code_point_frequency.begin(), code_point_frequency.end());
+
+  EXPECT_LT(analyzer.AnalyzeBytes(Bytes::CreateFromRaw(
+                "Cooking MC's like a pound of bacon")),
+            analyzer.AnalyzeBytes(Bytes::CreateFromRaw(
+                "Dhhlnib@KD:t@knlb@f@uhrkc@ha@gfdhk")));
+}
+
+}  // namespace
+}  // namespace cryptopals::analysis
@@ -12,8 +12,8 @@ namespace cryptopals::analysis {
 class HammingDistanceAnalyzer : public AnalyzerInterface {
  public:
   // Implements CompareBytes from AnalyzerInterface.
-  double CompareBytes(const cryptopals::util::Bytes& lhs,
-                      const cryptopals::util::Bytes& rhs) override;
+  double CompareBytes(cryptopals::util::BytesView lhs,
+                      cryptopals::util::BytesView rhs) override;
 };
 
 }  // namespace cryptopals::analysis
@@ -0,0 +1,171 @@
+#include "cryptopals/analysis/keysize_estimator.h"
+
+#include <algorithm>
+#include <array>
+#include <random>
+#include <span>
+#include <tuple>
+
+#include "absl/status/status.h"
+#include "absl/status/status_macros.h"
+#include "cryptopals/util/hamming_distance.h"
+
+namespace cryptopals::analysis {
+namespace {
+
+using cryptopals::util::BytesView;
+using cryptopals::util::HammingDistance;
+
+constexpr size_t BITS_PER_BYTE = 8;
+constexpr size_t NUM_BYTE_VALUES = 256;
+
+// The total distance between the compared blocks and the number of pairs it
+// was measured over.
+struct PairDistances {
+  uint64_t distance;
+  uint64_t num_pairs;
+};
+
+// Sums the distance between every pair of `num_blocks` blocks of `keysize`
+// bytes at the start of `ciphertext`. A bit position that is set in `ones` of
+// the blocks differs in exactly `ones * (num_blocks - ones)` pairs, so only the
+// number of blocks with each bit set is needed. Those numbers are read off a
+// histogram of the byte values at each offset in a block, which takes one pass
+// over the ciphertext instead of one pass per pair.
+PairDistances AllPairDistances(BytesView ciphertext, size_t keysize,
+                               size_t num_blocks) {
+  std::vector<std::array<uint64_t, NUM_BYTE_VALUES>> histograms(keysize);
+  for (std::array<uint64_t, NUM_BYTE_VALUES>& histogram : histograms) {
+    histogram.fill(0);
+  }
+  const uint8_t* block = ciphertext.data();
+  for (size_t i = 0; i < num_blocks; ++i, block += keysize) {
+    for (size_t offset = 0; offset < keysize; ++offset) {
+      ++histograms[offset][block[offset]];
+    }
+  }
+
+  uint64_t distance = 0;
+  for (const std::array<uint64_t, NUM_BYTE_VALUES>& histogram : histograms) {
+    std::array<uint64_t, BITS_PER_BYTE> ones = {};
+    for (size_t value = 0; value < NUM_BYTE_VALUES; ++value) {
+      for (size_t bit = 0; bit < BITS_PER_BYTE; ++bit) {
+        ones[bit] += (value >> bit & 1) * histogram[value];
+      }
+    }
+    for (uint64_t bit_ones : ones) {
+      distance += bit_ones * (num_blocks - bit_ones);
+    }
+  }
+  return {.distance = distance,
+          .num_pairs = uint64_t{num_blocks} * (num_blocks - 1) / 2};
+}
+
+// Sums the distance between every block and the block after it. Consecutive
+// pairs together compare the whole buffer with itself shifted by one block.
+PairDistances AdjacentPairDistances(BytesView ciphertext, size_t keysize,
+                                    size_t num_blocks) {
+  std::span<const uint8_t> blocks = ciphertext.first(num_blocks * keysize);
+  const size_t size = (num_blocks - 1) * keysize;
+  return {.distance = HammingDistance(blocks.first(size), blocks.last(size)),
+          .num_pairs = num_blocks - 1};
+}
+
+// Sums the distance between `num_pairs` pairs of distinct blocks chosen
+// uniformly at random by a generator seeded with `seed`.
+PairDistances RandomPairDistances(BytesView ciphertext, size_t keysize,
+                                  size_t num_blocks, size_t num_pairs,
+                                  uint64_t seed) {
+  std::mt19937_64 generator(seed);
+  std::uniform_int_distribution<size_t> first_block(0, num_blocks - 1);
+  std::uniform_int_distribution<size_t> second_block(0, num_blocks - 2);
+  std::span<const uint8_t> blocks = ciphertext;
+
+  uint64_t distance = 0;
+  for (size_t i = 0; i < num_pairs; ++i) {
+    const size_t first = first_block(generator);
+    size_t second = second_block(generator);
+    if (second >= first) {
+      ++second;
+    }
+    distance += HammingDistance(blocks.subspan(first * keysize, keysize),
+                                blocks.subspan(second * keysize, keysize));
+  }
+  return {.distance = distance, .num_pairs = num_pairs};
+}
+
+}  // namespace
+
+absl::StatusOr<KeysizeEstimator> KeysizeEstimator::Create(
+    const KeysizeEstimatorOptions& options, cryptopals::util::ThreadPool& pool) {
+  if (options.min_keysize == 0 || options.min_keysize > options.max_keysize) {
+    return absl::InvalidArgumentErrorBuilder()
+           << "Invalid key size range [" << options.min_keysize << ", "
+           << options.max_keysize << "]";
+  }
+  switch (options.sampling) {
+    case cryptopals::KeysizeSampling::ALL_PAIRS:
+    case cryptopals::KeysizeSampling::ADJACENT_PAIRS:
+      break;
+    case cryptopals::KeysizeSampling::RANDOM_PAIRS:
+      if (options.num_random_pairs == 0) {
+        return absl::InvalidArgumentError(
+            "RANDOM_PAIRS sampling requires at least one pair");
+      }
+      break;
+    default:
+      return absl::InvalidArgumentErrorBuilder()
+             << "Unsupported key size sampling: "
+             << cryptopals::KeysizeSampling_Name(options.sampling);
+  }
+  return KeysizeEstimator(options, pool);
+}
+
+std::vector<KeysizeScore> KeysizeEstimator::Estimate(
+    BytesView ciphertext) const {
+  const size_t max_keysize =
+      std::min(options_.max_keysize, ciphertext.size() / 2);
+  if (max_keysize < options_.min_keysize) {
+    return {};
+  }
+
+  std::vector<KeysizeScore> scores(max_keysize - options_.min_keysize + 1);
+  cryptopals::util::ParallelFor(
+      scores.size(), /*min_items_per_task=*/1,
+      [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+          const size_t keysize = options_.min_keysize + i;
+          scores[i] = {.score = Score(ciphertext, keysize), .keysize = keysize};
+        }
+      },
+      *pool_);
+
+  std::sort(scores.begin(), scores.end(),
+            [](const KeysizeScore& lhs, const KeysizeScore& rhs) {
+              return std::tie(lhs.score, lhs.keysize) <
+                     std::tie(rhs.score, rhs.keysize);
+            });
+  return scores;
+}
+
+double KeysizeEstimator::Score(BytesView ciphertext, size_t keysize) const {
+  const size_t num_blocks = ciphertext.size() / keysize;
+  PairDistances pair_distances;
+  switch (options_.sampling) {
+    case cryptopals::KeysizeSampling::ADJACENT_PAIRS:
+      pair_distances = AdjacentPairDistances(ciphertext, keysize, num_blocks);
+      break;
+    case cryptopals::KeysizeSampling::RANDOM_PAIRS:
+      pair_distances =
+          RandomPairDistances(ciphertext, keysize, num_blocks,
+                              options_.num_random_pairs, options_.seed + keysize);
+      break;
+    default:
+      pair_distances = AllPairDistances(ciphertext, keysize, num_blocks);
+      break;
+  }
+  return static_cast<double>(pair_distances.distance) /
+         pair_distances.num_pairs / keysize;
+}
+
+}  // namespace cryptopals::analysis
@@ -0,0 +1,76 @@
+#ifndef CRYPTOPALS_ANALYSIS_KEYSIZE_ESTIMATOR_H_
+#define CRYPTOPALS_ANALYSIS_KEYSIZE_ESTIMATOR_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "absl/status/statusor.h"
+#include "cryptopals/proto/cryptopals_enums.pb.h"
+#include "cryptopals/util/bytes_view.h"
+#include "cryptopals/util/thread_pool.h"
+
+namespace cryptopals::analysis {
+
+struct KeysizeEstimatorOptions {
+  // The smallest and largest key sizes to score, inclusive. Key sizes that
+  // leave fewer than two whole blocks of ciphertext are skipped.
+  size_t min_keysize = 2;
+  size_t max_keysize = 40;
+
+  // The pairs of blocks compared for each key size.
+  cryptopals::KeysizeSampling sampling = cryptopals::KeysizeSampling::ALL_PAIRS;
+
+  // The number of pairs compared for each key size with RANDOM_PAIRS.
+  size_t num_random_pairs = 1024;
+
+  // Seeds the choice of pairs with RANDOM_PAIRS, so that estimates can be
+  // repeated.
+  uint64_t seed = 0;
+};
+
+struct KeysizeScore {
+  // The mean number of bits per byte that differ between the compared blocks.
+  // Blocks encrypted with the same key bytes differ no more than their
+  // plaintexts do, so the most likely key sizes have the lowest scores.
+  double score;
+
+  // The key size that was scored.
+  size_t keysize;
+};
+
+// Estimates the size of the key that encrypted a ciphertext with a repeating
+// key, by measuring the Hamming distance between blocks of the ciphertext the
+// size of each candidate key. Only whole blocks are compared, and distances
+// are computed straight from offsets into the ciphertext.
+class KeysizeEstimator {
+ public:
+  // Creates an estimator that scores key sizes concurrently on `pool`.
+  // Returns an error status for an empty or reversed range of key sizes, an
+  // unspecified sampling, or RANDOM_PAIRS without any pairs.
+  static absl::StatusOr<KeysizeEstimator> Create(
+      const KeysizeEstimatorOptions& options,
+      cryptopals::util::ThreadPool& pool =
+          cryptopals::util::ThreadPool::Default());
+
+  // Returns the score of every candidate key size for `ciphertext`, best
+  // first. Ties go to the smaller key size.
+  std::vector<KeysizeScore> Estimate(
+      cryptopals::util::BytesView ciphertext) const;
+
+ private:
+  KeysizeEstimator(const KeysizeEstimatorOptions& options,
+                   cryptopals::util::ThreadPool& pool)
+      : options_(options), pool_(&pool) {}
+
+  // Returns the score of `keysize`, which leaves at least two whole blocks of
+  // `ciphertext`.
+  double Score(cryptopals::util::BytesView ciphertext, size_t keysize) const;
+
+  KeysizeEstimatorOptions options_;
+  cryptopals::util::ThreadPool* pool_;
+};
+
+}  // namespace cryptopals::analysis
+
+#endif  // CRYPTOPALS_ANALYSIS_KEYSIZE_ESTIMATOR_H_
@@ -0,0 +1,161 @@
+#include "cryptopals/analysis/keysize_estimator.h"
+
+#include <bit>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "cryptopals/util/bytes.h"
+#include "googletest/status_matchers.h"
+#include "gtest/gtest.h"
+
+namespace cryptopals::analysis {
+namespace {
+
+using cryptopals::util::Bytes;
+using cryptopals::util::BytesView;
+
+constexpr char PLAINTEXT[] =
+    "I'm back and I'm ringin' the bell\n"
+    "A rockin' on the mike while the fly girls yell\n"
+    "In ecstasy in the back of me\n"
+    "Well that's my DJ Deshay cuttin' all them Z's\n"
+    "Hittin' hard and the girlies goin' crazy\n"
+    "Vanilla's on the mike, man I'm not lazy.\n"
+    "I'm lettin' my drug kick in\n"
+    "It controls my mouth and I begin\n"
+    "To just let it flow, let my concepts go\n"
+    "My posse's to the side yellin', Go Vanilla Go!\n"
+    "Smooth 'cause that's the way I will be\n"
+    "And if you don't give a damn, then\n"
+    "Why you starin' at me\n"
+    "So get off 'cause I control the stage\n"
+    "There's no dissin' allowed\n"
+    "I'm in my own phase\n"
+    "The girlies sa y they love me and that is ok\n"
+    "And I can dance better than any kid n' play\n";
+
+Bytes TestCiphertext() {
+  return Bytes::CreateFromRaw(PLAINTEXT) ^
+         Bytes::CreateFromRaw("Terminator X: Bring the noise");
+}
+
+// The mean distance per byte between the pairs of blocks given by `pairs`.
+double ReferenceScore(BytesView ciphertext, size_t keysize,
+                      const std::vector<std::pair<size_t, size_t>>& pairs) {
+  uint64_t distance = 0;
+  for (const auto& [first, second] : pairs) {
+    for (size_t i = 0; i < keysize; ++i) {
+      distance += std::popcount(static_cast<uint8_t>(
+          ciphertext[first * keysize + i] ^ ciphertext[second * keysize + i]));
+    }
+  }
+  return static_cast<double>(distance) / pairs.size() / keysize;
+}
+
+TEST(KeysizeEstimatorTest, AllPairsMatchesPairwiseDistances) {
+  cryptopals::util::ThreadPool pool(2);
+  ASSERT_OK_AND_ASSIGN(KeysizeEstimator estimator,
+                       KeysizeEstimator::Create({}, pool));
+  const Bytes ciphertext = TestCiphertext();
+  const std::vector<KeysizeScore> scores = estimator.Estimate(ciphertext);
+  ASSERT_EQ(scores.size(), 39);
+
+  for (const KeysizeScore& score : scores) {
+    const size_t num_blocks = ciphertext.size() / score.keysize;
+    std::vector<std::pair<size_t, size_t>> pairs;
+    for (size_t first = 0; first < num_blocks; ++first) {
+      for (size_t second = first + 1; second < num_blocks; ++second) {
+        pairs.push_back({first, second});
+      }
+    }
+    EXPECT_NEAR(score.score, ReferenceScore(ciphertext, score.keysize, pairs),
+                1e-9)
+        << "keysize=" << score.keysize;
+  }
+
+  EXPECT_EQ(scores.front().keysize, 29);
+  for (size_t i = 1; i < scores.size(); ++i) {
+    EXPECT_LE(scores[i - 1].score, scores[i].score);
+  }
+}
+
+TEST(KeysizeEstimatorTest, AdjacentPairsMatchesPairwiseDistances) {
+  ASSERT_OK_AND_ASSIGN(
+      KeysizeEstimator estimator,
+      KeysizeEstimator::Create(
+          {.sampling = cryptopals::KeysizeSampling::ADJACENT_PAIRS}));
+  const Bytes ciphertext = TestCiphertext();
+
+  for (const KeysizeScore& score : estimator.Estimate(ciphertext)) {
+    const size_t num_blocks = ciphertext.size() / score.keysize;
+    std::vector<std::pair<size_t, size_t>> pairs;
+    for (size_t first = 0; first + 1 < num_blocks; ++first) {
+      pairs.push_back({first, first + 1});
+    }
+    EXPECT_NEAR(score.score, ReferenceScore(ciphertext, score.keysize, pairs),
+                1e-9)
+        << "keysize=" << score.keysize;
+  }
+}
+
+TEST(KeysizeEstimatorTest, RandomPairsIsRepeatable) {
+  const KeysizeEstimatorOptions options = {
+      .sampling = cryptopals::KeysizeSampling::RANDOM_PAIRS,
+      .num_random_pairs = 2000,
+      .seed = 7,
+  };
+  ASSERT_OK_AND_ASSIGN(KeysizeEstimator estimator,
+                       KeysizeEstimator::Create(options));
+  const Bytes ciphertext = TestCiphertext();
+  const std::vector<KeysizeScore> scores = estimator.Estimate(ciphertext);
+  ASSERT_EQ(scores.size(), 39);
+  EXPECT_EQ(scores.front().keysize, 29);
+
+  const std::vector<KeysizeScore> repeated_scores =
+      estimator.Estimate(ciphertext);
+  for (size_t i = 0; i < scores.size(); ++i) {
+    EXPECT_EQ(scores[i].keysize, repeated_scores[i].keysize);
+    EXPECT_EQ(scores[i].score, repeated_scores[i].score);
+  }
+}
+
+TEST(KeysizeEstimatorTest, SkipsKeysizesWithoutTwoBlocks) {
+  ASSERT_OK_AND_ASSIGN(KeysizeEstimator estimator,
+                       KeysizeEstimator::Create({}));
+  EXPECT_TRUE(estimator.Estimate(Bytes::CreateFromRaw("abc")).empty());
+
+  const std::vector<KeysizeScore> scores =
+      estimator.Estimate(Bytes::CreateFromRaw("abcdefghi"));
+  ASSERT_EQ(scores.size(), 3);
+  for (const KeysizeScore& score : scores) {
+    EXPECT_GE(score.keysize, 2);
+    EXPECT_LE(score.keysize, 4);
+  }
+}
+
+TEST(KeysizeEstimatorTest, CreateRejectsInvalidOptions) {
+  EXPECT_EQ(KeysizeEstimator::Create({.min_keysize = 0}).status().code(),
+            absl::StatusCode::kInvalidArgument);
+  EXPECT_EQ(KeysizeEstimator::Create({.min_keysize = 10, .max_keysize = 9})
+                .status()
+                .code(),
+            absl::StatusCode::kInvalidArgument);
+  EXPECT_EQ(
+      KeysizeEstimator::Create(
+          {.sampling = cryptopals::KeysizeSampling::KEYSIZE_SAMPLING_UNSPECIFIED})
+          .status()
+          .code(),
+      absl::StatusCode::kInvalidArgument);
+  EXPECT_EQ(
+      KeysizeEstimator::Create(
+          {.sampling = cryptopals::KeysizeSampling::RANDOM_PAIRS,
+           .num_random_pairs = 0})
+          .status()
+          .code(),
+      absl::StatusCode::kInvalidArgument);
+}
+
+}  // namespace
+}  // namespace cryptopals::analysis
@@ -0,0 +1,189 @@
+// Benchmarks for the AES block operations, each engine, and the ECB and CBC
+// modes of operation.
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "absl/status/statusor.h"
+#include "benchmark/benchmark.h"
+#include "cryptopals/benchmarks/benchmark_util.h"
+#include "cryptopals/cipher/aes_cbc.h"
+#include "cryptopals/cipher/aes_ecb.h"
+#include "cryptopals/proto/cryptopals_enums.pb.h"
+#include "cryptopals/util/aes.h"
+#include "cryptopals/util/aes_engine.h"
+#include "cryptopals/util/bytes.h"
+
+namespace cryptopals::benchmarks {
+namespace {
+
+using cryptopals::util::AesEngineInterface;
+using cryptopals::util::AesKeySchedule;
+using cryptopals::util::AesState;
+using cryptopals::util::Bytes;
+
+// The number of bytes encrypted by each iteration of the engine benchmarks.
+constexpr size_t ENGINE_BATCH_BYTES = 4096;
+
+const AesKeySchedule& TestKeySchedule() {
+  static const AesKeySchedule* const key_schedule = new AesKeySchedule(
+      AesKeySchedule::Create(Bytes::CreateFromRaw("YELLOW SUBMARINE")).value());
+  return *key_schedule;
+}
+
+void BM_EncryptBlock(benchmark::State& state) {
+  std::vector<uint8_t> block = RandomBytes(AesState::SIZE_BYTES);
+  cryptopals::util::aes_mutable_block_span span(block.data(),
+                                                AesState::SIZE_BYTES);
+  for (auto _ : state) {
+    cryptopals::util::EncryptBlock(span, TestKeySchedule(), span);
+    benchmark::DoNotOptimize(block.data());
+  }
+  SetThroughput(state, AesState::SIZE_BYTES, 1);
+}
+BENCHMARK(BM_EncryptBlock);
+
+void BM_DecryptBlock(benchmark::State& state) {
+  std::vector<uint8_t> block = RandomBytes(AesState::SIZE_BYTES);
+  cryptopals::util::aes_mutable_block_span span(block.data(),
+                                                AesState::SIZE_BYTES);
+  for (auto _ : state) {
+    cryptopals::util::DecryptBlock(span, TestKeySchedule(), span);
+    benchmark::DoNotOptimize(block.data());
+  }
+  SetThroughput(state, AesState::SIZE_BYTES, 1);
+}
+BENCHMARK(BM_DecryptBlock);
+
+// Returns the engine for the backend in the first argument of `state`, or
+// nullptr after skipping the benchmark if this machine does not support it.
+const AesEngineInterface* EngineOrSkip(benchmark::State& state) {
+  const auto backend = static_cast<cryptopals::AesBackend>(state.range(0));
+  state.SetLabel(cryptopals::AesBackend_Name(backend));
+  absl::StatusOr<const AesEngineInterface*> engine =
+      cryptopals::util::GetAesEngine(backend);
+  if (SkipIfError(state, engine.status())) {
+    return nullptr;
+  }
+  return *engine;
+}
+
+void AesBackendArguments(benchmark::internal::Benchmark* benchmark) {
+  for (cryptopals::AesBackend backend :
+       {cryptopals::AesBackend::REFERENCE, cryptopals::AesBackend::T_TABLE,
+        cryptopals::AesBackend::AES_NI, cryptopals::AesBackend::BITSLICED}) {
+    benchmark->Arg(backend);
+  }
+}
+
+void BM_EngineEncryptBlocks(benchmark::State& state) {
+  const AesEngineInterface* engine = EngineOrSkip(state);
+  if (engine == nullptr) {
+    return;
+  }
+  std::vector<uint8_t> blocks = RandomBytes(ENGINE_BATCH_BYTES);
+  for (auto _ : state) {
+    engine->EncryptBlocks(blocks, TestKeySchedule(), blocks);
+    benchmark::DoNotOptimize(blocks.data());
+  }
+  SetThroughput(state, ENGINE_BATCH_BYTES,
+                ENGINE_BATCH_BYTES / AesState::SIZE_BYTES);
+}
+BENCHMARK(BM_EngineEncryptBlocks)->Apply(AesBackendArguments);
+
+void BM_EngineDecryptBlocks(benchmark::State& state) {
+  const AesEngineInterface* engine = EngineOrSkip(state);
+  if (engine == nullptr) {
+    return;
+  }
+  std::vector<uint8_t> blocks = RandomBytes(ENGINE_BATCH_BYTES);
+  for (auto _ : state) {
+    engine->DecryptBlocks(blocks, TestKeySchedule(), blocks);
+    benchmark::DoNotOptimize(blocks.data());
+  }
+  SetThroughput(state, ENGINE_BATCH_BYTES,
+                ENGINE_BATCH_BYTES / AesState::SIZE_BYTES);
+}
+BENCHMARK(BM_EngineDecryptBlocks)->Apply(AesBackendArguments);
+
+// The modes of operation are benchmarked from one KiB to one GiB. CBC
+// decryption splits large messages across the thread pool, so they are timed
+// by the wall clock rather than the CPU time of the calling thread.
+void MessageSizes(benchmark::internal::Benchmark* benchmark) {
+  benchmark->RangeMultiplier(32)
+      ->Range(MIN_MESSAGE_BYTES, MAX_MESSAGE_BYTES)
+      ->UseRealTime();
+}
+
+void BM_AesEcbEncrypt(benchmark::State& state) {
+  const size_t size = state.range(0);
+  std::vector<uint8_t> message = RandomBytes(size);
+  cryptopals::cipher::AesEcb cipher;
+  for (auto _ : state) {
+    if (SkipIfError(state, cipher.EncryptBlocks(message, TestKeySchedule(),
+                                                message))) {
+      return;
+    }
+    benchmark::DoNotOptimize(message.data());
+  }
+  SetThroughput(state, size, size / AesState::SIZE_BYTES);
+}
+BENCHMARK(BM_AesEcbEncrypt)->Apply(MessageSizes);
+
+void BM_AesEcbDecrypt(benchmark::State& state) {
+  const size_t size = state.range(0);
+  std::vector<uint8_t> message = RandomBytes(size);
+  cryptopals::cipher::AesEcb cipher;
+  for (auto _ : state) {
+    if (SkipIfError(state, cipher.DecryptBlocks(message, TestKeySchedule(),
+                                                message))) {
+      return;
+    }
+    benchmark::DoNotOptimize(message.data());
+  }
+  SetThroughput(state, size, size / AesState::SIZE_BYTES);
+}
+BENCHMARK(BM_AesEcbDecrypt)->Apply(MessageSizes);
+
+// Returns a CBC cipher with a fixed initialization vector.
+cryptopals::cipher::AesCbc CreateAesCbc() {
+  cryptopals::cipher::AesCbc cipher;
+  cipher.SetIv(Bytes::CreateFromRaw("0123456789abcdef")).IgnoreError();
+  return cipher;
+}
+
+void BM_AesCbcEncrypt(benchmark::State& state) {
+  const size_t size = state.range(0);
+  std::vector<uint8_t> message = RandomBytes(size);
+  cryptopals::cipher::AesCbc cipher = CreateAesCbc();
+  for (auto _ : state) {
+    if (SkipIfError(state, cipher.EncryptBlocks(message, TestKeySchedule(),
+                                                message))) {
+      return;
+    }
+    benchmark::DoNotOptimize(message.data());
+  }
+  SetThroughput(state, size, size / AesState::SIZE_BYTES);
+}
+BENCHMARK(BM_AesCbcEncrypt)->Apply(MessageSizes);
+
+void BM_AesCbcDecrypt(benchmark::State& state) {
+  const size_t size = state.range(0);
+  std::vector<uint8_t> ciphertext = RandomBytes(size);
+  // Decryption must not be done in place.
+  std::vector<uint8_t> plaintext(size);
+  cryptopals::cipher::AesCbc cipher = CreateAesCbc();
+  for (auto _ : state) {
+    if (SkipIfError(state, cipher.DecryptBlocks(ciphertext, TestKeySchedule(),
+                                                plaintext))) {
+      return;
+    }
+    benchmark::DoNotOptimize(plaintext.data());
+  }
+  SetThroughput(state, size, size / AesState::SIZE_BYTES);
+}
+BENCHMARK(BM_AesCbcDecrypt)->Apply(MessageSizes);
+
+}  // namespace
+}  // namespace cryptopals::benchmarks
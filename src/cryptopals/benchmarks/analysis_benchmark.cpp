@@ -0,0 +1,92 @@
+// Benchmarks for the analyzers and for cracking the XOR ciphers.
+
+#include <cstdint>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "benchmark/benchmark.h"
+#include "cryptopals/analysis/aes_block_analyzer.h"
+#include "cryptopals/analysis/data/oanc_english.h"
+#include "cryptopals/analysis/frequency_analyzer.h"
+#include "cryptopals/benchmarks/benchmark_util.h"
+#include "cryptopals/cipher/repeating_key_xor.h"
+#include "cryptopals/cipher/single_byte_xor.h"
+#include "cryptopals/encoding/ascii.h"
+#include "cryptopals/util/aes.h"
+#include "cryptopals/util/bytes.h"
+
+namespace cryptopals::benchmarks {
+namespace {
+
+using cryptopals::util::Bytes;
+
+Bytes EnglishBytes(size_t size) {
+  return Bytes::CreateFromRaw(EnglishText(size));
+}
+
+void BM_FrequencyAnalyzer(benchmark::State& state) {
+  using cryptopals::analysis::data::oanc_english::code_point_frequency;
+  const size_t size = state.range(0);
+  const Bytes text = EnglishBytes(size);
+  cryptopals::analysis::FrequencyAnalyzer<uint8_t> analyzer(
+      absl::make_unique<cryptopals::encoding::AsciiEncoding>(),
+      code_point_frequency.begin(), code_point_frequency.end());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(analyzer.AnalyzeBytes(text));
+  }
+  SetThroughput(state, size, 1);
+}
+BENCHMARK(BM_FrequencyAnalyzer)->RangeMultiplier(16)->Range(1 << 6, 1 << 22);
+
+// Each iteration cracks one ciphertext, so items are ciphertexts cracked.
+// Large ciphertexts are cracked on the shared thread pool, so the crackers are
+// timed by wall clock rather than by the CPU time of the calling thread.
+void BM_SingleByteXorCrack(benchmark::State& state) {
+  const size_t size = state.range(0);
+  cryptopals::cipher::SingleByteXor cipher;
+  const Bytes ciphertext = cipher.Encrypt(EnglishBytes(size), 0x35);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(cipher.Crack(ciphertext));
+  }
+  SetThroughput(state, size, 1);
+}
+BENCHMARK(BM_SingleByteXorCrack)
+    ->RangeMultiplier(16)
+    ->Range(1 << 6, 1 << 22)
+    ->UseRealTime();
+
+void BM_RepeatingKeyXorCrack(benchmark::State& state) {
+  const size_t size = state.range(0);
+  cryptopals::cipher::RepeatingKeyXor cipher;
+  const Bytes ciphertext =
+      cipher.Encrypt(EnglishBytes(size),
+                     Bytes::CreateFromRaw("Terminator X: Bring the noise"));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(cipher.Crack(ciphertext));
+  }
+  SetThroughput(state, size, 1);
+}
+BENCHMARK(BM_RepeatingKeyXorCrack)
+    ->RangeMultiplier(8)
+    ->Range(1 << 10, 1 << 19)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+// Noise has no repeated blocks, so every block is a new entry in the table of
+// blocks that the analyzer builds.
+void BM_AesBlockAnalyzer(benchmark::State& state) {
+  const size_t size = state.range(0);
+  std::vector<uint8_t> noise = RandomBytes(size);
+  const Bytes input(noise.begin(), noise.end());
+  cryptopals::analysis::AesBlockAnalyzer analyzer;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(analyzer.AnalyzeBytes(input));
+  }
+  SetThroughput(state, size, size / cryptopals::util::AesState::SIZE_BYTES);
+}
+BENCHMARK(BM_AesBlockAnalyzer)
+    ->RangeMultiplier(32)
+    ->Range(MIN_MESSAGE_BYTES, int64_t{1} << 25);
+
+}  // namespace
+}  // namespace cryptopals::benchmarks
@@ -0,0 +1,5 @@
+#include "benchmark/benchmark.h"
+
+// Runs the benchmarks selected by the --benchmark_* flags. Pass
+// --benchmark_out=<file> --benchmark_out_format=json to record the results.
+BENCHMARK_MAIN();
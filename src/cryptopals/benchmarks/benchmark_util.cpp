@@ -0,0 +1,57 @@
+#include "cryptopals/benchmarks/benchmark_util.h"
+
+#include <random>
+#include <string_view>
+
+namespace cryptopals::benchmarks {
+namespace {
+
+// A passage of English text, long enough to give the analyzers realistic
+// frequencies.
+constexpr std::string_view ENGLISH_PASSAGE =
+    "It was the best of times, it was the worst of times, it was the age of "
+    "wisdom, it was the age of foolishness, it was the epoch of belief, it was "
+    "the epoch of incredulity, it was the season of Light, it was the season "
+    "of Darkness, it was the spring of hope, it was the winter of despair, we "
+    "had everything before us, we had nothing before us, we were all going "
+    "direct to Heaven, we were all going direct the other way.\n";
+
+}  // namespace
+
+std::vector<uint8_t> RandomBytes(size_t size, uint64_t seed) {
+  std::mt19937_64 generator(seed);
+  std::vector<uint8_t> bytes(size);
+  for (uint8_t& byte : bytes) {
+    byte = static_cast<uint8_t>(generator());
+  }
+  return bytes;
+}
+
+std::string EnglishText(size_t size) {
+  std::string text;
+  text.reserve(size + ENGLISH_PASSAGE.size());
+  while (text.size() < size) {
+    text.append(ENGLISH_PASSAGE);
+  }
+  text.resize(size);
+  return text;
+}
+
+void SetThroughput(benchmark::State& state, size_t bytes, size_t items) {
+  SetThroughput(state, bytes);
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * items));
+}
+
+void SetThroughput(benchmark::State& state, size_t bytes) {
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes));
+}
+
+bool SkipIfError(benchmark::State& state, const absl::Status& status) {
+  if (status.ok()) {
+    return false;
+  }
+  state.SkipWithError(status.ToString().c_str());
+  return true;
+}
+
+}  // namespace cryptopals::benchmarks
@@ -0,0 +1,39 @@
+// Inputs and counters shared by the benchmarks.
+
+#ifndef CRYPTOPALS_BENCHMARKS_BENCHMARK_UTIL_H_
+#define CRYPTOPALS_BENCHMARKS_BENCHMARK_UTIL_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "benchmark/benchmark.h"
+
+namespace cryptopals::benchmarks {
+
+// The smallest and largest messages encrypted by the cipher benchmarks.
+inline constexpr int64_t MIN_MESSAGE_BYTES = int64_t{1} << 10;
+inline constexpr int64_t MAX_MESSAGE_BYTES = int64_t{1} << 30;
+
+// Returns `size` bytes of noise, which is the same for every run with the same
+// `seed`.
+std::vector<uint8_t> RandomBytes(size_t size, uint64_t seed = 0);
+
+// Returns `size` bytes of English text, repeating a passage as needed.
+std::string EnglishText(size_t size);
+
+// Reports the throughput of `state` as `bytes` and `items` processed by every
+// iteration. The overload without `items` reports bytes only, for benchmarks
+// whose only natural unit is the byte.
+void SetThroughput(benchmark::State& state, size_t bytes, size_t items);
+void SetThroughput(benchmark::State& state, size_t bytes);
+
+// Stops `state` with the message of `status` if it is an error. Returns whether
+// it was.
+bool SkipIfError(benchmark::State& state, const absl::Status& status);
+
+}  // namespace cryptopals::benchmarks
+
+#endif  // CRYPTOPALS_BENCHMARKS_BENCHMARK_UTIL_H_
@@ -0,0 +1,113 @@
+// Benchmarks for the hex and base64 codecs and for XOR of Bytes objects.
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "absl/status/statusor.h"
+#include "benchmark/benchmark.h"
+#include "cryptopals/benchmarks/benchmark_util.h"
+#include "cryptopals/util/bytes.h"
+#include "cryptopals/util/codecs.h"
+
+namespace cryptopals::benchmarks {
+namespace {
+
+using cryptopals::util::Bytes;
+
+// The codecs are benchmarked from one KiB to 32 MiB of decoded bytes.
+void CodecSizes(benchmark::internal::Benchmark* benchmark) {
+  benchmark->RangeMultiplier(32)->Range(MIN_MESSAGE_BYTES, int64_t{1} << 25);
+}
+
+// Throughput is measured in decoded bytes for both directions, so that
+// encoding and decoding the same message report comparable rates. Items are
+// the encoded characters.
+
+void BM_EncodeHex(benchmark::State& state) {
+  const size_t size = state.range(0);
+  std::vector<uint8_t> input = RandomBytes(size);
+  std::string output(cryptopals::util::HexEncodedSize(size), '\0');
+  for (auto _ : state) {
+    cryptopals::util::EncodeHex(input, output);
+    benchmark::DoNotOptimize(output.data());
+  }
+  SetThroughput(state, size, cryptopals::util::HexEncodedSize(size));
+}
+BENCHMARK(BM_EncodeHex)->Apply(CodecSizes);
+
+void BM_DecodeHex(benchmark::State& state) {
+  const size_t size = state.range(0);
+  std::vector<uint8_t> output = RandomBytes(size);
+  std::string input(cryptopals::util::HexEncodedSize(size), '\0');
+  cryptopals::util::EncodeHex(output, input);
+  for (auto _ : state) {
+    absl::StatusOr<size_t> decoded = cryptopals::util::DecodeHex(input, output);
+    if (SkipIfError(state, decoded.status())) {
+      return;
+    }
+    benchmark::DoNotOptimize(output.data());
+  }
+  SetThroughput(state, size, cryptopals::util::HexEncodedSize(size));
+}
+BENCHMARK(BM_DecodeHex)->Apply(CodecSizes);
+
+void BM_EncodeBase64(benchmark::State& state) {
+  const size_t size = state.range(0);
+  std::vector<uint8_t> input = RandomBytes(size);
+  std::string output(cryptopals::util::Base64EncodedSize(size), '\0');
+  for (auto _ : state) {
+    cryptopals::util::EncodeBase64(input, output);
+    benchmark::DoNotOptimize(output.data());
+  }
+  SetThroughput(state, size, cryptopals::util::Base64EncodedSize(size));
+}
+BENCHMARK(BM_EncodeBase64)->Apply(CodecSizes);
+
+void BM_DecodeBase64(benchmark::State& state) {
+  const size_t size = state.range(0);
+  std::vector<uint8_t> output = RandomBytes(size);
+  std::string input(cryptopals::util::Base64EncodedSize(size), '\0');
+  cryptopals::util::EncodeBase64(output, input);
+  for (auto _ : state) {
+    absl::StatusOr<size_t> decoded =
+        cryptopals::util::DecodeBase64(input, output);
+    if (SkipIfError(state, decoded.status())) {
+      return;
+    }
+    benchmark::DoNotOptimize(output.data());
+  }
+  SetThroughput(state, size, cryptopals::util::Base64EncodedSize(size));
+}
+BENCHMARK(BM_DecodeBase64)->Apply(CodecSizes);
+
+// XOR is benchmarked over the codec sizes with keys of one byte, of a size
+// that divides the vector width, of a size that does not, and as long as the
+// data, which each take a different path through the XOR kernel.
+void XorSizes(benchmark::internal::Benchmark* benchmark) {
+  benchmark->ArgNames({"size", "key"});
+  for (int64_t size = MIN_MESSAGE_BYTES; size <= int64_t{1} << 25; size *= 32) {
+    for (int64_t key_size : {int64_t{1}, int64_t{16}, int64_t{29}, size}) {
+      benchmark->Args({size, key_size});
+    }
+  }
+}
+
+// Includes the copy of the left operand that operator^ makes.
+void BM_XorBytes(benchmark::State& state) {
+  const size_t size = state.range(0);
+  const size_t key_size = state.range(1);
+  std::vector<uint8_t> lhs_bytes = RandomBytes(size);
+  std::vector<uint8_t> rhs_bytes = RandomBytes(key_size, /*seed=*/1);
+  const Bytes lhs(lhs_bytes.begin(), lhs_bytes.end());
+  const Bytes rhs(rhs_bytes.begin(), rhs_bytes.end());
+  for (auto _ : state) {
+    Bytes result = lhs ^ rhs;
+    benchmark::DoNotOptimize(result);
+  }
+  SetThroughput(state, size);
+}
+BENCHMARK(BM_XorBytes)->Apply(XorSizes);
+
+}  // namespace
+}  // namespace cryptopals::benchmarks
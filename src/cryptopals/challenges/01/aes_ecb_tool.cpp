@@ -1,19 +1,27 @@
 #include <fstream>
 #include <iostream>
 #include <sstream>
+#include <span>
 #include <string>
+#include <string_view>
 
 #include "absl/flags/flag.h"
 #include "absl/flags/parse.h"
 #include "absl/flags/usage.h"
 #include "absl/status/status.h"
 #include "absl/status/status_macros.h"
+#include "absl/strings/str_cat.h"
 #include "cryptopals/analysis/aes_block_analyzer.h"
 #include "cryptopals/cipher/aes_ecb.h"
+#include "cryptopals/cipher/aes_stream_cipher.h"
+#include "cryptopals/cipher/cipher_stream.h"
 #include "cryptopals/proto/cryptopals_enums.pb.h"
+#include "cryptopals/util/aes.h"
 #include "cryptopals/util/bytes.h"
 #include "cryptopals/util/init_cryptopals.h"
 #include "cryptopals/util/logging.h"
+#include "cryptopals/util/record_pipeline.h"
+#include "cryptopals/util/record_reader.h"
 #include "cryptopals/util/status_adaptors.h"
 #include "cryptopals/util/tool_helpers.h"
 
@@ -28,64 +36,105 @@ namespace {
 
 using cryptopals::util::Bytes;
 
-absl::Status Encrypt(std::string_view encoded_text,
-                     cryptopals::BytesEncodedFormat format) {
+absl::Status Encrypt(const Bytes& plaintext,
+                     cryptopals::BytesEncodedFormat format,
+                     std::string* output) {
   std::string key_flag = absl::GetFlag(FLAGS_key);
   if (key_flag.empty()) {
     return absl::InvalidArgumentError("Action ENCRYPT requires --key flag");
   }
   Bytes key = Bytes::CreateFromFormat(key_flag, format);
-  Bytes plaintext = Bytes::CreateFromRaw(encoded_text);
 
   cryptopals::cipher::AesEcb aes_ecb;
   Bytes ciphertext = aes_ecb.Encrypt(plaintext, key);
-  std::cout << ciphertext.ToFormat(format) << std::endl;
+  absl::StrAppend(output, ciphertext.ToFormat(format), "\n");
 
   return absl::OkStatus();
 }
 
-absl::Status Decrypt(std::string_view encoded_text,
-                     cryptopals::BytesEncodedFormat format) {
+absl::Status Decrypt(const Bytes& ciphertext,
+                     cryptopals::BytesEncodedFormat format,
+                     std::string* output) {
   std::string key_flag = absl::GetFlag(FLAGS_key);
   if (key_flag.empty()) {
     return absl::InvalidArgumentError("Action DECRYPT requires --key flag");
   }
   Bytes key = Bytes::CreateFromFormat(key_flag, format);
-  Bytes ciphertext = Bytes::CreateFromFormat(encoded_text, format);
 
   cryptopals::cipher::AesEcb aes_ecb;
   Bytes plaintext = aes_ecb.Decrypt(ciphertext, key);
-  std::cout << plaintext.ToRaw() << std::endl;
+  absl::StrAppend(output, plaintext.ToRaw(), "\n");
 
   return absl::OkStatus();
 }
 
-absl::Status Crack(std::string_view encoded_text,
-                   cryptopals::BytesEncodedFormat format) {
+// Encrypts or decrypts each record of `records`, a whole file, through an
+// AesStreamCipher a chunk at a time, so that neither the file nor its output
+// is held in memory at once.
+absl::Status StreamRecords(cryptopals::util::RecordReader& records,
+                           cryptopals::CipherAction action,
+                           cryptopals::BytesEncodedFormat format) {
+  std::string key_flag = absl::GetFlag(FLAGS_key);
+  if (key_flag.empty()) {
+    return absl::InvalidArgumentErrorBuilder()
+           << "Action " << CipherAction_Name(action) << " requires --key flag";
+  }
+  ASSIGN_OR_RETURN(cryptopals::util::AesKeySchedule key_schedule,
+                   cryptopals::util::AesKeySchedule::Create(
+                       Bytes::CreateFromFormat(key_flag, format)));
+
+  // Plaintext is raw, and ciphertext is in --format.
+  const bool encrypt = action == cryptopals::CipherAction::ENCRYPT;
+  const cryptopals::BytesEncodedFormat input_format =
+      encrypt ? cryptopals::BytesEncodedFormat::RAW : format;
+  const cryptopals::BytesEncodedFormat output_format =
+      encrypt ? format : cryptopals::BytesEncodedFormat::RAW;
+  return cryptopals::util::ForEachRecord(
+      records, [&](std::string_view record) -> absl::Status {
+        ASSIGN_OR_RETURN(cryptopals::cipher::AesStreamCipher cipher,
+                         cryptopals::cipher::AesStreamCipher::Create(
+                             action, cryptopals::AesMode::ECB, key_schedule,
+                             Bytes(), {.pkcs7_padding = false}));
+        RETURN_IF_ERROR(cryptopals::cipher::StreamThroughCipher(
+            cipher, record, input_format, output_format, std::cout));
+        std::cout << "\n";
+        return absl::OkStatus();
+      });
+}
+
+absl::Status Crack(const Bytes& ciphertext,
+                   cryptopals::BytesEncodedFormat format,
+                   std::string* output) {
   return absl::UnimplementedError("I don't know how to crack this yet");
 }
 
-// Detects the most likely text in `encoded_texts` encrypted with the AES ECB
-// cipher.
-absl::Status Detect(const std::vector<std::string>& encoded_texts,
+// Detects the most likely record in `records` encrypted with the AES ECB
+// cipher. Records are scored as they are read, and only the best one so far is
+// kept.
+absl::Status Detect(cryptopals::util::RecordReader& records,
                     cryptopals::BytesEncodedFormat format) {
-  std::string_view most_likely_result;
+  std::string most_likely_result;
   double high_score = std::numeric_limits<double>::min();
+  size_t num_inputs = 0;
 
-  LOG(INFO) << "Detecting AES in ECB mode from " << encoded_texts.size()
-            << " inputs.";
+  LOG(INFO) << "Detecting AES in ECB mode.";
 
   cryptopals::analysis::AesBlockAnalyzer aes_block_analyzer;
-  for (std::string_view encoded_text : encoded_texts) {
-    Bytes ciphertext = Bytes::CreateFromFormat(encoded_text, format);
-    double score = aes_block_analyzer.AnalyzeBytes(ciphertext);
-
-    if (score > high_score) {
-      high_score = score;
-      most_likely_result = encoded_text;
-    }
-  }
+  RETURN_IF_ERROR(cryptopals::util::ForEachRecord(
+      records, [&](std::string_view encoded_text) -> absl::Status {
+        ++num_inputs;
+        ASSIGN_OR_RETURN(Bytes ciphertext,
+                         Bytes::DecodeFromFormat(encoded_text, format));
+        double score = aes_block_analyzer.AnalyzeBytes(ciphertext);
+
+        if (score > high_score) {
+          high_score = score;
+          most_likely_result = encoded_text;
+        }
+        return absl::OkStatus();
+      }));
 
+  LOG(INFO) << "Scored " << num_inputs << " inputs.";
   std::cout << "Most likely result: " << most_likely_result << std::endl;
   std::cout << "Score: " << high_score << std::endl;
 
@@ -124,43 +173,65 @@ int main(int argc, char** argv) {
     return static_cast<int>(absl::StatusCode::kInvalidArgument);
   }
 
-  std::vector<std::string> inputs = cryptopals::util::GetInputsForMethod(
-      std::vector<char*>(positional_args.begin() + 1, positional_args.end()),
-      input);
+  ASSIGN_OR_RETURN(
+      cryptopals::util::RecordReader records,
+      cryptopals::util::RecordReader::Create(
+          std::span<char* const>(positional_args).subspan(1), input),
+      _.LogError().With(cryptopals::util::Return(EXIT_FAILURE)));
+
+  if (input == cryptopals::InputMethod::CIPHERTEXT_FILE &&
+      (action == cryptopals::CipherAction::ENCRYPT ||
+       action == cryptopals::CipherAction::DECRYPT)) {
+    absl::Status status = StreamRecords(records, action, format);
+    if (!status.ok()) {
+      LOG(ERROR) << status;
+      return static_cast<int>(status.code());
+    }
+    return 0;
+  }
 
   switch (action) {
     case cryptopals::CipherAction::ENCRYPT: {
-      for (std::string input : inputs) {
-        absl::Status status = Encrypt(input, format);
-        if (!status.ok()) {
-          LOG(ERROR) << status;
-          return static_cast<int>(status.code());
-        }
+      absl::Status status = cryptopals::util::RunRecordPipeline(
+          records, cryptopals::util::DecodeRawRecord,
+          [format](const Bytes& plaintext, std::string* output) {
+            return Encrypt(plaintext, format, output);
+          },
+          std::cout);
+      if (!status.ok()) {
+        LOG(ERROR) << status;
+        return static_cast<int>(status.code());
       }
       break;
     }
     case cryptopals::CipherAction::DECRYPT: {
-      for (std::string input : inputs) {
-        absl::Status status = Decrypt(input, format);
-        if (!status.ok()) {
-          LOG(ERROR) << status;
-          return static_cast<int>(status.code());
-        }
+      absl::Status status = cryptopals::util::RunRecordPipeline(
+          records, cryptopals::util::DecodeRecordFromFormat(format),
+          [format](const Bytes& ciphertext, std::string* output) {
+            return Decrypt(ciphertext, format, output);
+          },
+          std::cout);
+      if (!status.ok()) {
+        LOG(ERROR) << status;
+        return static_cast<int>(status.code());
       }
       break;
     }
     case cryptopals::CipherAction::CRACK: {
-      for (std::string input : inputs) {
-        absl::Status status = Crack(input, format);
-        if (!status.ok()) {
-          LOG(ERROR) << status;
-          return static_cast<int>(status.code());
-        }
+      absl::Status status = cryptopals::util::RunRecordPipeline(
+          records, cryptopals::util::DecodeRecordFromFormat(format),
+          [format](const Bytes& ciphertext, std::string* output) {
+            return Crack(ciphertext, format, output);
+          },
+          std::cout);
+      if (!status.ok()) {
+        LOG(ERROR) << status;
+        return static_cast<int>(status.code());
       }
       break;
     }
     case cryptopals::CipherAction::DETECT: {
-      absl::Status status = Detect(inputs, format);
+      absl::Status status = Detect(records, format);
       if (!status.ok()) {
         LOG(ERROR) << status;
         return static_cast<int>(status.code());
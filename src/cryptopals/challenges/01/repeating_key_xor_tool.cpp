@@ -1,18 +1,23 @@
 #include <fstream>
 #include <iostream>
 #include <sstream>
+#include <span>
 #include <string>
+#include <string_view>
 
 #include "absl/flags/flag.h"
 #include "absl/flags/parse.h"
 #include "absl/flags/usage.h"
 #include "absl/status/status.h"
 #include "absl/status/status_macros.h"
+#include "absl/strings/str_cat.h"
 #include "cryptopals/cipher/repeating_key_xor.h"
 #include "cryptopals/proto/cryptopals_enums.pb.h"
 #include "cryptopals/util/bytes.h"
 #include "cryptopals/util/init_cryptopals.h"
 #include "cryptopals/util/logging.h"
+#include "cryptopals/util/record_pipeline.h"
+#include "cryptopals/util/record_reader.h"
 #include "cryptopals/util/status_adaptors.h"
 #include "cryptopals/util/tool_helpers.h"
 
@@ -27,47 +32,49 @@ namespace {
 
 using cryptopals::util::Bytes;
 
-absl::Status Encrypt(std::string_view encoded_text,
-                     cryptopals::BytesEncodedFormat format) {
+absl::Status Encrypt(const Bytes& plaintext,
+                     cryptopals::BytesEncodedFormat format,
+                     std::string* output) {
   std::string key_flag = absl::GetFlag(FLAGS_key);
   if (key_flag.empty()) {
     return absl::InvalidArgumentError("Action ENCRYPT requires --key flag");
   }
   Bytes key = Bytes::CreateFromFormat(key_flag, format);
-  Bytes plaintext = Bytes::CreateFromRaw(encoded_text);
 
   cryptopals::cipher::RepeatingKeyXor repeating_key_xor;
   Bytes ciphertext = repeating_key_xor.Encrypt(plaintext, key);
-  std::cout << ciphertext.ToFormat(format) << std::endl;
+  absl::StrAppend(output, ciphertext.ToFormat(format), "\n");
 
   return absl::OkStatus();
 }
 
-absl::Status Decrypt(std::string_view encoded_text,
-                     cryptopals::BytesEncodedFormat format) {
+absl::Status Decrypt(const Bytes& ciphertext,
+                     cryptopals::BytesEncodedFormat format,
+                     std::string* output) {
   std::string key_flag = absl::GetFlag(FLAGS_key);
   if (key_flag.empty()) {
     return absl::InvalidArgumentError("Action DECRYPT requires --key flag");
   }
   Bytes key = Bytes::CreateFromFormat(key_flag, format);
-  Bytes ciphertext = Bytes::CreateFromFormat(encoded_text, format);
 
   cryptopals::cipher::RepeatingKeyXor repeating_key_xor;
   Bytes plaintext = repeating_key_xor.Decrypt(ciphertext, key);
-  std::cout << plaintext.ToRaw() << std::endl;
+  absl::StrAppend(output, plaintext.ToRaw(), "\n");
 
   return absl::OkStatus();
 }
 
-absl::Status Crack(std::string_view encoded_text,
-                   cryptopals::BytesEncodedFormat format) {
-  const Bytes ciphertext = Bytes::CreateFromFormat(encoded_text, format);
+absl::Status Crack(const Bytes& ciphertext,
+                   cryptopals::BytesEncodedFormat format,
+                   std::string* output) {
   cryptopals::cipher::RepeatingKeyXor repeating_key_xor;
   cryptopals::cipher::RepeatingKeyXor::DecryptionResultType decryption_result =
       repeating_key_xor.Crack(ciphertext);
   decryption_result.key.SetFormat(format);
 
-  std::cout << std::hex << std::showbase << decryption_result << std::endl;
+  std::ostringstream result;
+  result << std::hex << std::showbase << decryption_result << "\n";
+  absl::StrAppend(output, result.str());
 
   return absl::OkStatus();
 }
@@ -104,38 +111,49 @@ int main(int argc, char** argv) {
     return static_cast<int>(absl::StatusCode::kInvalidArgument);
   }
 
-  std::vector<std::string> inputs = cryptopals::util::GetInputsForMethod(
-      std::vector<char*>(positional_args.begin() + 1, positional_args.end()),
-      input);
+  ASSIGN_OR_RETURN(
+      cryptopals::util::RecordReader records,
+      cryptopals::util::RecordReader::Create(
+          std::span<char* const>(positional_args).subspan(1), input),
+      _.LogError().With(cryptopals::util::Return(EXIT_FAILURE)));
 
   switch (action) {
     case cryptopals::CipherAction::ENCRYPT: {
-      for (std::string input : inputs) {
-        absl::Status status = Encrypt(input, format);
-        if (!status.ok()) {
-          LOG(ERROR) << status;
-          return static_cast<int>(status.code());
-        }
+      absl::Status status = cryptopals::util::RunRecordPipeline(
+          records, cryptopals::util::DecodeRawRecord,
+          [format](const Bytes& plaintext, std::string* output) {
+            return Encrypt(plaintext, format, output);
+          },
+          std::cout);
+      if (!status.ok()) {
+        LOG(ERROR) << status;
+        return static_cast<int>(status.code());
       }
       break;
     }
     case cryptopals::CipherAction::DECRYPT: {
-      for (std::string input : inputs) {
-        absl::Status status = Decrypt(input, format);
-        if (!status.ok()) {
-          LOG(ERROR) << status;
-          return static_cast<int>(status.code());
-        }
+      absl::Status status = cryptopals::util::RunRecordPipeline(
+          records, cryptopals::util::DecodeRecordFromFormat(format),
+          [format](const Bytes& ciphertext, std::string* output) {
+            return Decrypt(ciphertext, format, output);
+          },
+          std::cout);
+      if (!status.ok()) {
+        LOG(ERROR) << status;
+        return static_cast<int>(status.code());
       }
       break;
     }
     case cryptopals::CipherAction::CRACK: {
-      for (std::string input : inputs) {
-        absl::Status status = Crack(input, format);
-        if (!status.ok()) {
-          LOG(ERROR) << status;
-          return static_cast<int>(status.code());
-        }
+      absl::Status status = cryptopals::util::RunRecordPipeline(
+          records, cryptopals::util::DecodeRecordFromFormat(format),
+          [format](const Bytes& ciphertext, std::string* output) {
+            return Crack(ciphertext, format, output);
+          },
+          std::cout);
+      if (!status.ok()) {
+        LOG(ERROR) << status;
+        return static_cast<int>(status.code());
       }
       break;
     }
@@ -1,5 +1,7 @@
 #include <algorithm>
+#include <span>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "absl/flags/flag.h"
@@ -7,31 +9,41 @@
 #include "absl/flags/usage.h"
 #include "absl/status/status.h"
 #include "absl/status/status_macros.h"
+#include "absl/strings/str_cat.h"
 #include "cryptopals/analysis/data/oanc_english.h"
 #include "cryptopals/analysis/frequency_analyzer.h"
 #include "cryptopals/cipher/decryption_result.h"
 #include "cryptopals/cipher/single_byte_xor.h"
+#include "cryptopals/cipher/single_byte_xor_detector.h"
 #include "cryptopals/encoding/ascii.h"
 #include "cryptopals/proto/cryptopals_enums.pb.h"
 #include "cryptopals/util/bytes.h"
 #include "cryptopals/util/init_cryptopals.h"
 #include "cryptopals/util/logging.h"
+#include "cryptopals/util/record_pipeline.h"
+#include "cryptopals/util/record_reader.h"
 #include "cryptopals/util/status_adaptors.h"
 #include "cryptopals/util/tool_helpers.h"
 
 ABSL_FLAG(std::string, action, "",
-          "the action to perform (encrypt, decrypt, crack)");
+          "the action to perform (encrypt, decrypt, crack, detect)");
 ABSL_FLAG(std::string, format, "", "format of the operands and output");
 ABSL_FLAG(std::string, key, "", "the key used to encrypt/decrypt a message");
 ABSL_FLAG(std::string, input, "stdin",
           "the input method (stdin, ciphertext_file, multi_ciphertext_file)");
+ABSL_FLAG(size_t, num_results, 1,
+          "the number of most likely inputs reported by the detect action");
+ABSL_FLAG(double, max_score, 0,
+          "the highest score of a result reported by the crack action; 0 "
+          "reports every result");
 
 namespace {
 
 using cryptopals::util::Bytes;
 
-absl::Status Encrypt(std::string_view encoded_text,
-                     cryptopals::BytesEncodedFormat format) {
+absl::Status Encrypt(const Bytes& plaintext,
+                     cryptopals::BytesEncodedFormat format,
+                     std::string* output) {
   std::string key_flag = absl::GetFlag(FLAGS_key);
   if (key_flag.empty()) {
     return absl::InvalidArgumentError("Action ENCRYPT requires --key flag");
@@ -43,17 +55,16 @@ absl::Status Encrypt(std::string_view encoded_text,
   }
   uint8_t key = key_bytes.at(0);
 
-  Bytes plaintext = Bytes::CreateFromRaw(encoded_text);
-
   cryptopals::cipher::SingleByteXor single_byte_xor;
   Bytes ciphertext = single_byte_xor.Encrypt(plaintext, key);
-  std::cout << ciphertext.ToFormat(format) << std::endl;
+  absl::StrAppend(output, ciphertext.ToFormat(format), "\n");
 
   return absl::OkStatus();
 }
 
-absl::Status Decrypt(std::string_view encoded_text,
-                     cryptopals::BytesEncodedFormat format) {
+absl::Status Decrypt(const Bytes& ciphertext,
+                     cryptopals::BytesEncodedFormat format,
+                     std::string* output) {
   std::string key_flag = absl::GetFlag(FLAGS_key);
   if (key_flag.empty()) {
     return absl::InvalidArgumentError("Action DECRYPT requires --key flag");
@@ -65,23 +76,53 @@ absl::Status Decrypt(std::string_view encoded_text,
   }
   uint8_t key = key_bytes.at(0);
 
-  Bytes ciphertext = Bytes::CreateFromFormat(encoded_text, format);
-
   cryptopals::cipher::SingleByteXor single_byte_xor;
   Bytes plaintext = single_byte_xor.Decrypt(ciphertext, key);
-  std::cout << plaintext.ToRaw() << std::endl;
+  absl::StrAppend(output, plaintext.ToRaw(), "\n");
 
   return absl::OkStatus();
 }
 
-absl::Status Crack(std::string_view encoded_text,
-                   cryptopals::BytesEncodedFormat format) {
-  const Bytes ciphertext = Bytes::CreateFromFormat(encoded_text, format);
+absl::Status Crack(const Bytes& ciphertext, double max_score,
+                   std::string* output) {
   cryptopals::cipher::SingleByteXor single_byte_xor;
   cryptopals::cipher::SingleByteXor::DecryptionResultType decryption_result =
       single_byte_xor.Crack(ciphertext);
-  if (decryption_result.score < 200) {
-    std::cout << std::hex << std::showbase << decryption_result << std::endl;
+  if (max_score == 0 || decryption_result.score <= max_score) {
+    std::ostringstream result;
+    result << std::hex << std::showbase << decryption_result << "\n";
+    absl::StrAppend(output, result.str());
+  }
+
+  return absl::OkStatus();
+}
+
+// Detects the records in `records` most likely to be encrypted with a
+// single-byte XOR cipher. Records are cracked in parallel in batches, as they
+// arrive, and every record that enters the best --num_results is logged as soon
+// as it is found.
+absl::Status Detect(cryptopals::util::RecordReader& records,
+                    cryptopals::BytesEncodedFormat format) {
+  LOG(INFO) << "Detecting single-byte XOR.";
+
+  using Detection = cryptopals::cipher::SingleByteXorDetector::Detection;
+  cryptopals::cipher::SingleByteXorDetector detector(
+      absl::GetFlag(FLAGS_num_results));
+  while (true) {
+    ASSIGN_OR_RETURN(std::vector<std::string_view> batch, records.NextBatch());
+    if (batch.empty()) {
+      break;
+    }
+    RETURN_IF_ERROR(
+        detector.Add(batch, format, [](const Detection& detection) {
+          LOG(INFO) << "Candidate at input " << detection.index << ": "
+                    << detection.decryption_result.score;
+        }));
+  }
+
+  for (const Detection& detection : detector.results()) {
+    std::cout << detection.index << ": " << std::hex << std::showbase
+              << detection.decryption_result << std::dec << std::endl;
   }
 
   return absl::OkStatus();
@@ -119,38 +160,58 @@ int main(int argc, char** argv) {
     return static_cast<int>(absl::StatusCode::kInvalidArgument);
   }
 
-  std::vector<std::string> inputs = cryptopals::util::GetInputsForMethod(
-      std::vector<char*>(positional_args.begin() + 1, positional_args.end()),
-      input);
+  ASSIGN_OR_RETURN(
+      cryptopals::util::RecordReader records,
+      cryptopals::util::RecordReader::Create(
+          std::span<char* const>(positional_args).subspan(1), input),
+      _.LogError().With(cryptopals::util::Return(EXIT_FAILURE)));
 
   switch (action) {
     case cryptopals::CipherAction::ENCRYPT: {
-      for (std::string input : inputs) {
-        absl::Status status = Encrypt(input, format);
-        if (!status.ok()) {
-          LOG(ERROR) << status;
-          return static_cast<int>(status.code());
-        }
+      absl::Status status = cryptopals::util::RunRecordPipeline(
+          records, cryptopals::util::DecodeRawRecord,
+          [format](const Bytes& plaintext, std::string* output) {
+            return Encrypt(plaintext, format, output);
+          },
+          std::cout);
+      if (!status.ok()) {
+        LOG(ERROR) << status;
+        return static_cast<int>(status.code());
       }
       break;
     }
     case cryptopals::CipherAction::DECRYPT: {
-      for (std::string input : inputs) {
-        absl::Status status = Decrypt(input, format);
-        if (!status.ok()) {
-          LOG(ERROR) << status;
-          return static_cast<int>(status.code());
-        }
+      absl::Status status = cryptopals::util::RunRecordPipeline(
+          records, cryptopals::util::DecodeRecordFromFormat(format),
+          [format](const Bytes& ciphertext, std::string* output) {
+            return Decrypt(ciphertext, format, output);
+          },
+          std::cout);
+      if (!status.ok()) {
+        LOG(ERROR) << status;
+        return static_cast<int>(status.code());
       }
       break;
     }
     case cryptopals::CipherAction::CRACK: {
-      for (std::string input : inputs) {
-        absl::Status status = Crack(input, format);
-        if (!status.ok()) {
-          LOG(ERROR) << status;
-          return static_cast<int>(status.code());
-        }
+      const double max_score = absl::GetFlag(FLAGS_max_score);
+      absl::Status status = cryptopals::util::RunRecordPipeline(
+          records, cryptopals::util::DecodeRecordFromFormat(format),
+          [max_score](const Bytes& ciphertext, std::string* output) {
+            return Crack(ciphertext, max_score, output);
+          },
+          std::cout);
+      if (!status.ok()) {
+        LOG(ERROR) << status;
+        return static_cast<int>(status.code());
+      }
+      break;
+    }
+    case cryptopals::CipherAction::DETECT: {
+      absl::Status status = Detect(records, format);
+      if (!status.ok()) {
+        LOG(ERROR) << status;
+        return static_cast<int>(status.code());
       }
       break;
     }
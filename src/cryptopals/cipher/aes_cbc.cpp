@@ -4,91 +4,187 @@
 #include "cryptopals/cipher/aes_cbc.h"
 
 #include <algorithm>
+#include <array>
+#include <functional>
 #include <span>
 
+#include "absl/status/status.h"
 #include "absl/status/status_macros.h"
 #include "absl/status/statusor.h"
 #include "cryptopals/analysis/aes_block_analyzer.h"
 #include "cryptopals/util/aes.h"
+#include "cryptopals/util/aes_engine.h"
 #include "cryptopals/util/algorithm.h"
 #include "cryptopals/util/logging.h"
+#include "cryptopals/util/thread_pool.h"
 
 namespace cryptopals::cipher {
 
+using cryptopals::util::AesKeySchedule;
 using cryptopals::util::AesState;
 using cryptopals::util::Bytes;
+using cryptopals::util::BytesView;
+using cryptopals::util::GetDefaultAesEngine;
+using cryptopals::util::ParallelFor;
 
-Bytes AesCbc::Encrypt(const Bytes& plaintext, const Bytes& key) const {
-  if (plaintext.size() % AesState::SIZE_BYTES != 0) {
-    LOG(ERROR) << "Error: plaintext is not a multiple of AES block size ("
-               << AesState::SIZE_BYTES << " bytes)";
+namespace {
+
+// The smallest number of blocks decrypted by a single task. Smaller chunks
+// cost more in scheduling than they gain from running concurrently.
+constexpr size_t PARALLEL_MIN_BLOCKS = 4096;
+
+}  // namespace
+
+Bytes AesCbc::Encrypt(BytesView plaintext, const Bytes& key) const {
+  absl::StatusOr<AesKeySchedule> key_schedule = AesKeySchedule::Create(key);
+  if (!key_schedule.ok()) {
+    LOG(ERROR) << "Error expanding key: " << key_schedule.status();
     return Bytes();
   }
-  if (iv_.size() != AesState::SIZE_BYTES) {
-    LOG(ERROR)
-        << "Error: iv is not initialized (use SetIv() before encrypting)";
+  return Encrypt(plaintext, key_schedule.value());
+}
+
+Bytes AesCbc::Decrypt(BytesView ciphertext, const Bytes& key) const {
+  absl::StatusOr<AesKeySchedule> key_schedule = AesKeySchedule::Create(key);
+  if (!key_schedule.ok()) {
+    LOG(ERROR) << "Error expanding key: " << key_schedule.status();
     return Bytes();
   }
+  return Decrypt(ciphertext, key_schedule.value());
+}
 
-  Bytes ciphertext;
-  Bytes mixing_block = iv_;
-
-  for (size_t i = 0; i < plaintext.size(); i += AesState::SIZE_BYTES) {
-    mixing_block ^= Bytes(plaintext.begin() + i,
-                          plaintext.begin() + i + AesState::SIZE_BYTES);
-
-    absl::StatusOr<Bytes> encrypted_block = cryptopals::util::EncryptBlock(
-        cryptopals::util::aes_block_span(mixing_block.begin(),
-                                         AesState::SIZE_BYTES),
-        key);
-    if (!encrypted_block.ok()) {
-      LOG(ERROR) << "Error encrypting block at offset " << i << ": "
-                 << encrypted_block.status();
-      return Bytes();
-    }
-    mixing_block = encrypted_block.value();
-    ciphertext.Append(encrypted_block.value());
+Bytes AesCbc::Encrypt(BytesView plaintext,
+                      const AesKeySchedule& key_schedule) const {
+  Bytes ciphertext(plaintext.size());
+  absl::Status status = EncryptBlocks(
+      plaintext, key_schedule,
+      std::span<uint8_t>(ciphertext.begin(), ciphertext.size()));
+  if (!status.ok()) {
+    LOG(ERROR) << "Error encrypting plaintext: " << status;
+    return Bytes();
   }
-
   return ciphertext;
 }
 
-Bytes AesCbc::Decrypt(const Bytes& ciphertext, const Bytes& key) const {
-  if (ciphertext.size() % AesState::SIZE_BYTES != 0) {
-    LOG(ERROR) << "Error: ciphertext is not a multiple of AES block size ("
-               << AesState::SIZE_BYTES << " bytes)";
+Bytes AesCbc::Decrypt(BytesView ciphertext,
+                      const AesKeySchedule& key_schedule) const {
+  Bytes plaintext(ciphertext.size());
+  absl::Status status = DecryptBlocks(
+      ciphertext, key_schedule,
+      std::span<uint8_t>(plaintext.begin(), plaintext.size()));
+  if (!status.ok()) {
+    LOG(ERROR) << "Error decrypting ciphertext: " << status;
     return Bytes();
   }
+  return plaintext;
+}
+
+absl::Status AesCbc::EncryptBlocks(std::span<const uint8_t> plaintext,
+                                   const AesKeySchedule& key_schedule,
+                                   std::span<uint8_t> ciphertext) const {
+  if (plaintext.size() % AesState::SIZE_BYTES != 0) {
+    return absl::InvalidArgumentErrorBuilder()
+           << "plaintext is not a multiple of AES block size ("
+           << AesState::SIZE_BYTES << " bytes)";
+  }
   if (iv_.size() != AesState::SIZE_BYTES) {
-    LOG(ERROR)
-        << "Error: iv is not initialized (use SetIv() before decrypting)";
-    return Bytes();
+    return absl::FailedPreconditionError(
+        "iv is not initialized (use SetIv() before encrypting)");
+  }
+  if (ciphertext.size() != plaintext.size()) {
+    return absl::InvalidArgumentErrorBuilder()
+           << "ciphertext size (" << ciphertext.size()
+           << " bytes) does not match plaintext size (" << plaintext.size()
+           << " bytes)";
+  }
+  const bool overlaps =
+      plaintext.data() < ciphertext.data() + ciphertext.size() &&
+      ciphertext.data() < plaintext.data() + plaintext.size();
+  if (overlaps && plaintext.data() != ciphertext.data()) {
+    return absl::InvalidArgumentError(
+        "plaintext and ciphertext must be identical or must not overlap");
   }
 
-  Bytes plaintext;
-  Bytes mixing_block = iv_;
+  const cryptopals::util::AesEngineInterface& engine = GetDefaultAesEngine();
+  std::array<uint8_t, AesState::SIZE_BYTES> mixing_block;
+  std::copy_n(iv_.begin(), AesState::SIZE_BYTES, mixing_block.begin());
 
-  for (size_t i = 0; i < ciphertext.size(); i += AesState::SIZE_BYTES) {
-    cryptopals::util::aes_block_span block(ciphertext.begin() + i,
-                                           AesState::SIZE_BYTES);
+  // Every block depends on the ciphertext of the block before it, so blocks
+  // are encrypted one at a time.
+  for (size_t i = 0; i < plaintext.size(); i += AesState::SIZE_BYTES) {
+    std::transform(mixing_block.begin(), mixing_block.end(),
+                   plaintext.begin() + i, mixing_block.begin(),
+                   std::bit_xor<uint8_t>());
+    engine.EncryptBlocks(mixing_block, key_schedule, mixing_block);
+    std::copy_n(mixing_block.begin(), AesState::SIZE_BYTES,
+                ciphertext.begin() + i);
+  }
 
-    absl::StatusOr<Bytes> decrypted_block =
-        cryptopals::util::DecryptBlock(block, key);
-    if (!decrypted_block.ok()) {
-      LOG(ERROR) << "Error decrypting block at offset " << i << ": "
-                 << decrypted_block.status();
-      return Bytes();
-    }
-    mixing_block ^= decrypted_block.value();
-    plaintext.Append(mixing_block);
+  return absl::OkStatus();
+}
 
-    mixing_block = Bytes::CreateFromRange(block.begin(), block.end());
+absl::Status AesCbc::DecryptBlocks(std::span<const uint8_t> ciphertext,
+                                   const AesKeySchedule& key_schedule,
+                                   std::span<uint8_t> plaintext) const {
+  if (ciphertext.size() % AesState::SIZE_BYTES != 0) {
+    return absl::InvalidArgumentErrorBuilder()
+           << "ciphertext is not a multiple of AES block size ("
+           << AesState::SIZE_BYTES << " bytes)";
+  }
+  if (iv_.size() != AesState::SIZE_BYTES) {
+    return absl::FailedPreconditionError(
+        "iv is not initialized (use SetIv() before decrypting)");
+  }
+  if (plaintext.size() != ciphertext.size()) {
+    return absl::InvalidArgumentErrorBuilder()
+           << "plaintext size (" << plaintext.size()
+           << " bytes) does not match ciphertext size (" << ciphertext.size()
+           << " bytes)";
+  }
+  if (ciphertext.data() < plaintext.data() + plaintext.size() &&
+      plaintext.data() < ciphertext.data() + ciphertext.size()) {
+    // Decrypting in place would overwrite ciphertext blocks that the next
+    // block still has to be mixed with.
+    return absl::InvalidArgumentError(
+        "ciphertext and plaintext must not overlap");
   }
 
-  return plaintext;
+  const cryptopals::util::AesEngineInterface& engine = GetDefaultAesEngine();
+  ParallelFor(
+      ciphertext.size() / AesState::SIZE_BYTES, PARALLEL_MIN_BLOCKS,
+      [&](size_t begin_block, size_t end_block) {
+        const size_t begin = begin_block * AesState::SIZE_BYTES;
+        const size_t size = (end_block - begin_block) * AesState::SIZE_BYTES;
+        std::span<const uint8_t> ciphertext_chunk =
+            ciphertext.subspan(begin, size);
+        std::span<uint8_t> plaintext_chunk = plaintext.subspan(begin, size);
+
+        // Decrypting a block does not depend on any other block, so the whole
+        // chunk is decrypted at once to let the engine process several blocks
+        // in parallel.
+        engine.DecryptBlocks(ciphertext_chunk, key_schedule, plaintext_chunk);
+
+        // The first block of the message is mixed with the iv, and every other
+        // block is mixed with the previous block of ciphertext, which for the
+        // first block of a chunk lies in the chunk before it.
+        std::span<const uint8_t> mixing_block =
+            begin == 0 ? std::span<const uint8_t>(iv_.begin(), iv_.size())
+                       : ciphertext.subspan(begin - AesState::SIZE_BYTES,
+                                            AesState::SIZE_BYTES);
+        std::transform(mixing_block.begin(), mixing_block.end(),
+                       plaintext_chunk.begin(), plaintext_chunk.begin(),
+                       std::bit_xor<uint8_t>());
+        std::transform(ciphertext_chunk.begin(),
+                       ciphertext_chunk.end() - AesState::SIZE_BYTES,
+                       plaintext_chunk.begin() + AesState::SIZE_BYTES,
+                       plaintext_chunk.begin() + AesState::SIZE_BYTES,
+                       std::bit_xor<uint8_t>());
+      });
+
+  return absl::OkStatus();
 }
 
-AesCbc::DecryptionResultType AesCbc::Crack(const Bytes& ciphertext) {
+AesCbc::DecryptionResultType AesCbc::Crack(BytesView ciphertext) {
   DecryptionResultType decryption_result = {
       .score = std::numeric_limits<double>::max()};
 
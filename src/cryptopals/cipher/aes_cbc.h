@@ -4,8 +4,14 @@
 #ifndef CRYPTOPALS_CIPHER_AES_CBC_H_
 #define CRYPTOPALS_CIPHER_AES_CBC_H_
 
+#include <cstdint>
+#include <span>
+
 #include "absl/status/status.h"
 #include "cryptopals/cipher/symmetric_cipher.h"
+#include "cryptopals/util/aes.h"
+#include "cryptopals/util/bytes.h"
+#include "cryptopals/util/bytes_view.h"
 
 namespace cryptopals::cipher {
 
@@ -13,16 +19,46 @@ class AesCbc : public SymmetricCipherInterface<cryptopals::util::Bytes> {
  public:
   // Implements Encrypt from CipherInterface.
   cryptopals::util::Bytes Encrypt(
-      const cryptopals::util::Bytes& plaintext,
+      cryptopals::util::BytesView plaintext,
       const cryptopals::util::Bytes& key) const override;
 
   // Implements Decrypt from CipherInterface.
-  cryptopals::util::Bytes Decrypt(const cryptopals::util::Bytes& ciphertext,
+  cryptopals::util::Bytes Decrypt(cryptopals::util::BytesView ciphertext,
                                   const cryptopals::util::Bytes& key) const;
 
+  // Encrypts `plaintext` using a previously expanded `key_schedule`. Prefer
+  // this overload when the same key is used for several messages.
+  cryptopals::util::Bytes Encrypt(
+      cryptopals::util::BytesView plaintext,
+      const cryptopals::util::AesKeySchedule& key_schedule) const;
+
+  // Decrypts `ciphertext` using a previously expanded `key_schedule`. Prefer
+  // this overload when the same key is used for several messages.
+  cryptopals::util::Bytes Decrypt(
+      cryptopals::util::BytesView ciphertext,
+      const cryptopals::util::AesKeySchedule& key_schedule) const;
+
+  // Encrypts the contiguous blocks of `plaintext` into `ciphertext` without
+  // allocating. `ciphertext` must be the same size as `plaintext`, and the two
+  // spans must either be identical (to encrypt in place) or not overlap.
+  absl::Status EncryptBlocks(
+      std::span<const uint8_t> plaintext,
+      const cryptopals::util::AesKeySchedule& key_schedule,
+      std::span<uint8_t> ciphertext) const;
+
+  // Decrypts the contiguous blocks of `ciphertext` into `plaintext` without
+  // allocating. `plaintext` must be the same size as `ciphertext` and must not
+  // overlap it. Because every plaintext block only depends on two ciphertext
+  // blocks, large messages are split into chunks that are decrypted
+  // concurrently on the default thread pool.
+  absl::Status DecryptBlocks(
+      std::span<const uint8_t> ciphertext,
+      const cryptopals::util::AesKeySchedule& key_schedule,
+      std::span<uint8_t> plaintext) const;
+
   // Cracks the cipher and returns the most likely decryption result for
   // `ciphertext`.
-  DecryptionResultType Crack(const cryptopals::util::Bytes& ciphertext);
+  DecryptionResultType Crack(cryptopals::util::BytesView ciphertext);
 
   // Sets the initialization vector to `iv`.
   absl::Status SetIv(const cryptopals::util::Bytes& iv);
@@ -0,0 +1,79 @@
+#include "cryptopals/cipher/aes_cbc.h"
+
+#include <random>
+#include <span>
+
+#include "absl/status/status.h"
+#include "cryptopals/util/aes.h"
+#include "cryptopals/util/bytes.h"
+#include "cryptopals/util/bytes_view.h"
+#include "googletest/status_matchers.h"
+#include "gtest/gtest.h"
+
+namespace cryptopals::cipher {
+
+using cryptopals::util::AesKeySchedule;
+using cryptopals::util::Bytes;
+using cryptopals::util::BytesView;
+
+// The example vector of section F.2 of NIST SP 800-38A.
+constexpr char KEY[] = "2b7e151628aed2a6abf7158809cf4f3c";
+constexpr char IV[] = "000102030405060708090a0b0c0d0e0f";
+constexpr char PLAINTEXT[] =
+    "6bc1bee22e409f96e93d7e117393172aae2d8a571e03ac9c9eb76fac45af8e51"
+    "30c81c46a35ce411e5fbc1191a0a52eff69f2445df4f9b17ad2b417be66c3710";
+constexpr char CIPHERTEXT[] =
+    "7649abac8119b246cee98e9b12e9197d5086cb9b507219ee95db113a917678b2"
+    "73bed6b8e3c1743b7116e69e222295163ff1caa1681fac09120eca307586e1a7";
+
+TEST(AesCbcTest, EncryptDecryptVector) {
+  AesCbc aes_cbc;
+  ASSERT_OK(aes_cbc.SetIv(Bytes::CreateFromHex(IV)));
+  Bytes key = Bytes::CreateFromHex(KEY);
+  Bytes plaintext = Bytes::CreateFromHex(PLAINTEXT);
+  Bytes ciphertext = Bytes::CreateFromHex(CIPHERTEXT);
+
+  EXPECT_EQ(aes_cbc.Encrypt(plaintext, key), ciphertext);
+  EXPECT_EQ(aes_cbc.Decrypt(ciphertext, key), plaintext);
+}
+
+TEST(AesCbcTest, DecryptBlocksLargeMessage) {
+  AesCbc aes_cbc;
+  ASSERT_OK(aes_cbc.SetIv(Bytes::CreateFromHex(IV)));
+  ASSERT_OK_AND_ASSIGN(AesKeySchedule key_schedule,
+                       AesKeySchedule::Create(Bytes::CreateFromHex(KEY)));
+
+  // Large enough to be split into several chunks, with a partial last chunk.
+  std::mt19937 generator(38);
+  Bytes plaintext(16 * 20011);
+  for (uint8_t& byte : plaintext) {
+    byte = generator();
+  }
+  Bytes ciphertext = aes_cbc.Encrypt(plaintext, key_schedule);
+
+  Bytes decrypted(ciphertext.size());
+  ASSERT_OK(aes_cbc.DecryptBlocks(ciphertext, key_schedule, decrypted));
+  EXPECT_EQ(decrypted, plaintext);
+}
+
+TEST(AesCbcTest, DecryptBlocksRejectsInvalidSpans) {
+  AesCbc aes_cbc;
+  ASSERT_OK_AND_ASSIGN(AesKeySchedule key_schedule,
+                       AesKeySchedule::Create(Bytes::CreateFromHex(KEY)));
+  Bytes ciphertext = Bytes::CreateFromHex(CIPHERTEXT);
+  Bytes plaintext(ciphertext.size());
+
+  EXPECT_EQ(aes_cbc.DecryptBlocks(ciphertext, key_schedule, plaintext).code(),
+            absl::StatusCode::kFailedPrecondition);
+
+  ASSERT_OK(aes_cbc.SetIv(Bytes::CreateFromHex(IV)));
+  EXPECT_EQ(aes_cbc.DecryptBlocks(ciphertext, key_schedule, ciphertext).code(),
+            absl::StatusCode::kInvalidArgument);
+  EXPECT_EQ(aes_cbc
+                .DecryptBlocks(BytesView(ciphertext).first(20), key_schedule,
+                               std::span<uint8_t>(plaintext).first(20))
+                .code(),
+            absl::StatusCode::kInvalidArgument);
+}
+
+}  // namespace cryptopals::cipher
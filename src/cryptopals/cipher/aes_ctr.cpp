@@ -0,0 +1,214 @@
+// DISCLAIMER: This algorithm is implemented for educational purposes only. By
+// no means is it guaranteed to be secure.
+
+#include "cryptopals/cipher/aes_ctr.h"
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <span>
+
+#include "absl/status/status.h"
+#include "absl/status/status_macros.h"
+#include "absl/status/statusor.h"
+#include "cryptopals/util/aes.h"
+#include "cryptopals/util/aes_engine.h"
+#include "cryptopals/util/logging.h"
+#include "cryptopals/util/thread_pool.h"
+
+namespace cryptopals::cipher {
+
+using cryptopals::util::AesKeySchedule;
+using cryptopals::util::AesState;
+using cryptopals::util::Bytes;
+using cryptopals::util::BytesView;
+using cryptopals::util::GetDefaultAesEngine;
+using cryptopals::util::ParallelFor;
+
+namespace {
+
+// The number of counter blocks encrypted with a single call to the engine.
+// Large batches let the engine pipeline blocks, while staying small enough to
+// remain in the L1 cache.
+constexpr size_t KEYSTREAM_BATCH_BLOCKS = 64;
+
+// The smallest number of blocks processed by a single task. Smaller chunks cost
+// more in scheduling than they gain from running concurrently.
+constexpr size_t PARALLEL_MIN_BLOCKS = 4096;
+
+// Returns the counter stored in `block` according to `layout`.
+uint64_t LoadCounter(std::span<const uint8_t> block,
+                     const AesCtrCounterLayout& layout) {
+  uint64_t counter = 0;
+  for (size_t i = 0; i < layout.size; ++i) {
+    const size_t shift = layout.little_endian ? i : layout.size - 1 - i;
+    counter |= static_cast<uint64_t>(block[layout.offset + i]) << (8 * shift);
+  }
+  return counter;
+}
+
+// Stores `counter` in `block` according to `layout`. Bits of `counter` beyond
+// the width of the counter are dropped, which wraps the counter around.
+void StoreCounter(uint64_t counter, const AesCtrCounterLayout& layout,
+                  std::span<uint8_t> block) {
+  for (size_t i = 0; i < layout.size; ++i) {
+    const size_t shift = layout.little_endian ? i : layout.size - 1 - i;
+    block[layout.offset + i] = counter >> (8 * shift);
+  }
+}
+
+}  // namespace
+
+Bytes AesCtr::Encrypt(BytesView plaintext, const Bytes& key) const {
+  absl::StatusOr<AesKeySchedule> key_schedule = AesKeySchedule::Create(key);
+  if (!key_schedule.ok()) {
+    LOG(ERROR) << "Error expanding key: " << key_schedule.status();
+    return Bytes();
+  }
+  return Encrypt(plaintext, key_schedule.value());
+}
+
+Bytes AesCtr::Decrypt(BytesView ciphertext, const Bytes& key) const {
+  absl::StatusOr<AesKeySchedule> key_schedule = AesKeySchedule::Create(key);
+  if (!key_schedule.ok()) {
+    LOG(ERROR) << "Error expanding key: " << key_schedule.status();
+    return Bytes();
+  }
+  return Decrypt(ciphertext, key_schedule.value());
+}
+
+Bytes AesCtr::Encrypt(BytesView plaintext,
+                      const AesKeySchedule& key_schedule) const {
+  Bytes ciphertext(plaintext.size());
+  absl::Status status = EncryptAt(
+      0, plaintext, key_schedule,
+      std::span<uint8_t>(ciphertext.begin(), ciphertext.size()));
+  if (!status.ok()) {
+    LOG(ERROR) << "Error encrypting plaintext: " << status;
+    return Bytes();
+  }
+  return ciphertext;
+}
+
+Bytes AesCtr::Decrypt(BytesView ciphertext,
+                      const AesKeySchedule& key_schedule) const {
+  Bytes plaintext(ciphertext.size());
+  absl::Status status = DecryptAt(
+      0, ciphertext, key_schedule,
+      std::span<uint8_t>(plaintext.begin(), plaintext.size()));
+  if (!status.ok()) {
+    LOG(ERROR) << "Error decrypting ciphertext: " << status;
+    return Bytes();
+  }
+  return plaintext;
+}
+
+absl::Status AesCtr::EncryptAt(uint64_t offset,
+                               std::span<const uint8_t> plaintext,
+                               const AesKeySchedule& key_schedule,
+                               std::span<uint8_t> ciphertext) const {
+  return ApplyKeystream(offset, plaintext, key_schedule, ciphertext);
+}
+
+absl::Status AesCtr::DecryptAt(uint64_t offset,
+                               std::span<const uint8_t> ciphertext,
+                               const AesKeySchedule& key_schedule,
+                               std::span<uint8_t> plaintext) const {
+  return ApplyKeystream(offset, ciphertext, key_schedule, plaintext);
+}
+
+absl::Status AesCtr::SetCounterLayout(const AesCtrCounterLayout& layout) {
+  if (layout.size == 0 || layout.size > sizeof(uint64_t)) {
+    return absl::InvalidArgumentErrorBuilder()
+           << "counter size must be between 1 and " << sizeof(uint64_t)
+           << " bytes";
+  }
+  if (layout.offset > AesState::SIZE_BYTES - layout.size) {
+    return absl::InvalidArgumentError(
+        "counter does not fit in the counter block");
+  }
+  layout_ = layout;
+  return absl::OkStatus();
+}
+
+absl::Status AesCtr::SetIv(const Bytes& iv) {
+  if (iv.size() != AesState::SIZE_BYTES) {
+    return absl::InvalidArgumentErrorBuilder()
+           << "iv is not " << AesState::SIZE_BYTES << " bytes";
+  }
+  std::copy(iv.begin(), iv.end(), iv_.begin());
+  return absl::OkStatus();
+}
+
+absl::Status AesCtr::ApplyKeystream(uint64_t offset,
+                                    std::span<const uint8_t> input,
+                                    const AesKeySchedule& key_schedule,
+                                    std::span<uint8_t> output) const {
+  if (output.size() != input.size()) {
+    return absl::InvalidArgumentErrorBuilder()
+           << "output size (" << output.size()
+           << " bytes) does not match input size (" << input.size()
+           << " bytes)";
+  }
+  const bool overlaps = input.data() < output.data() + output.size() &&
+                        output.data() < input.data() + input.size();
+  if (overlaps && input.data() != output.data()) {
+    return absl::InvalidArgumentError(
+        "input and output must be identical or must not overlap");
+  }
+  if (input.empty()) {
+    return absl::OkStatus();
+  }
+
+  // The slice covers the bytes [offset, end) of the message, which lie in
+  // blocks [first_block, last_block].
+  const uint64_t end = offset + input.size();
+  const uint64_t first_block = offset / AesState::SIZE_BYTES;
+  const uint64_t last_block = (end - 1) / AesState::SIZE_BYTES;
+
+  // The counter of block i of the message is the counter of the iv plus i.
+  const uint64_t initial_counter = LoadCounter(iv_, layout_);
+
+  const cryptopals::util::AesEngineInterface& engine = GetDefaultAesEngine();
+  ParallelFor(
+      last_block - first_block + 1, PARALLEL_MIN_BLOCKS,
+      [&](size_t begin_task_block, size_t end_task_block) {
+        alignas(AesState::SIZE_BYTES)
+            std::array<uint8_t, KEYSTREAM_BATCH_BLOCKS * AesState::SIZE_BYTES>
+                keystream;
+
+        for (uint64_t batch_block = first_block + begin_task_block;
+             batch_block < first_block + end_task_block;
+             batch_block += KEYSTREAM_BATCH_BLOCKS) {
+          const size_t num_blocks = std::min<uint64_t>(
+              KEYSTREAM_BATCH_BLOCKS,
+              first_block + end_task_block - batch_block);
+          std::span<uint8_t> batch(keystream.begin(),
+                                   num_blocks * AesState::SIZE_BYTES);
+          for (size_t i = 0; i < num_blocks; ++i) {
+            std::span<uint8_t> counter_block =
+                batch.subspan(i * AesState::SIZE_BYTES, AesState::SIZE_BYTES);
+            std::copy(iv_.begin(), iv_.end(), counter_block.begin());
+            StoreCounter(initial_counter + batch_block + i, layout_,
+                         counter_block);
+          }
+          engine.EncryptBlocks(batch, key_schedule, batch);
+
+          // Only the part of the batch that overlaps the slice is used; this
+          // trims the first and last blocks of the slice.
+          const uint64_t batch_begin = batch_block * AesState::SIZE_BYTES;
+          const uint64_t begin = std::max(batch_begin, offset);
+          const uint64_t size =
+              std::min<uint64_t>(batch_begin + batch.size(), end) - begin;
+          std::transform(input.begin() + (begin - offset),
+                         input.begin() + (begin - offset + size),
+                         batch.begin() + (begin - batch_begin),
+                         output.begin() + (begin - offset),
+                         std::bit_xor<uint8_t>());
+        }
+      });
+
+  return absl::OkStatus();
+}
+
+}  // namespace cryptopals::cipher
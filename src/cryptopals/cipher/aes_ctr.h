@@ -0,0 +1,110 @@
+// DISCLAIMER: This algorithm is implemented for educational purposes only. By
+// no means is it guaranteed to be secure.
+
+#ifndef CRYPTOPALS_CIPHER_AES_CTR_H_
+#define CRYPTOPALS_CIPHER_AES_CTR_H_
+
+#include <array>
+#include <cstdint>
+#include <span>
+
+#include "absl/status/status.h"
+#include "cryptopals/cipher/symmetric_cipher.h"
+#include "cryptopals/util/aes.h"
+#include "cryptopals/util/bytes.h"
+#include "cryptopals/util/bytes_view.h"
+
+namespace cryptopals::cipher {
+
+// Describes where the counter lives inside the 16-byte counter block. Every
+// byte outside of the counter holds the nonce.
+struct AesCtrCounterLayout {
+  // The first byte of the counter within the counter block.
+  size_t offset;
+
+  // The width of the counter in bytes, at most 8. The counter wraps around
+  // within this width without carrying into the nonce.
+  size_t size;
+
+  // Whether the least significant byte of the counter comes first.
+  bool little_endian;
+
+  // The layout used by the cryptopals challenges: a 64-bit nonce followed by a
+  // 64-bit little endian block counter.
+  static constexpr AesCtrCounterLayout Cryptopals() {
+    return {.offset = 8, .size = 8, .little_endian = true};
+  }
+
+  // A 64-bit nonce followed by a 64-bit big endian block counter, as in the
+  // examples of NIST SP 800-38A.
+  static constexpr AesCtrCounterLayout BigEndian64() {
+    return {.offset = 8, .size = 8, .little_endian = false};
+  }
+};
+
+// AesCtr turns AES into a stream cipher by encrypting successive counter
+// blocks and mixing the result with the message. Encryption and decryption are
+// the same operation, and any position of the keystream can be produced
+// without producing the keystream before it.
+class AesCtr : public SymmetricCipherInterface<cryptopals::util::Bytes> {
+ public:
+  // Implements Encrypt from CipherInterface.
+  cryptopals::util::Bytes Encrypt(
+      cryptopals::util::BytesView plaintext,
+      const cryptopals::util::Bytes& key) const override;
+
+  // Implements Decrypt from CipherInterface.
+  cryptopals::util::Bytes Decrypt(cryptopals::util::BytesView ciphertext,
+                                  const cryptopals::util::Bytes& key) const;
+
+  // Encrypts `plaintext` using a previously expanded `key_schedule`. Prefer
+  // this overload when the same key is used for several messages.
+  cryptopals::util::Bytes Encrypt(
+      cryptopals::util::BytesView plaintext,
+      const cryptopals::util::AesKeySchedule& key_schedule) const;
+
+  // Decrypts `ciphertext` using a previously expanded `key_schedule`. Prefer
+  // this overload when the same key is used for several messages.
+  cryptopals::util::Bytes Decrypt(
+      cryptopals::util::BytesView ciphertext,
+      const cryptopals::util::AesKeySchedule& key_schedule) const;
+
+  // Encrypts `plaintext`, which starts `offset` bytes into the message, into
+  // `ciphertext` without allocating. `ciphertext` must be the same size as
+  // `plaintext`, and the two spans must either be identical (to encrypt in
+  // place) or not overlap. Large messages are split into chunks that are
+  // processed concurrently on the default thread pool.
+  absl::Status EncryptAt(uint64_t offset, std::span<const uint8_t> plaintext,
+                         const cryptopals::util::AesKeySchedule& key_schedule,
+                         std::span<uint8_t> ciphertext) const;
+
+  // Decrypts `ciphertext`, which starts `offset` bytes into the message, into
+  // `plaintext`. Only the keystream covering the slice is generated, so a slice
+  // of a large message can be decrypted without reading the data before it.
+  // The requirements on the spans match those of EncryptAt.
+  absl::Status DecryptAt(uint64_t offset, std::span<const uint8_t> ciphertext,
+                         const cryptopals::util::AesKeySchedule& key_schedule,
+                         std::span<uint8_t> plaintext) const;
+
+  // Sets the position of the counter within the counter block. Defaults to
+  // AesCtrCounterLayout::Cryptopals().
+  absl::Status SetCounterLayout(const AesCtrCounterLayout& layout);
+
+  // Sets the initial counter block, which holds the nonce and the value of the
+  // counter for the first block of the message. Defaults to all zeros.
+  absl::Status SetIv(const cryptopals::util::Bytes& iv);
+
+ private:
+  // Mixes the keystream starting `offset` bytes into the message with `input`.
+  absl::Status ApplyKeystream(
+      uint64_t offset, std::span<const uint8_t> input,
+      const cryptopals::util::AesKeySchedule& key_schedule,
+      std::span<uint8_t> output) const;
+
+  AesCtrCounterLayout layout_ = AesCtrCounterLayout::Cryptopals();
+  std::array<uint8_t, cryptopals::util::AesState::SIZE_BYTES> iv_ = {0};
+};
+
+}  // namespace cryptopals::cipher
+
+#endif  // CRYPTOPALS_CIPHER_AES_CTR_H_
@@ -0,0 +1,103 @@
+#include "cryptopals/cipher/aes_ctr.h"
+
+#include <initializer_list>
+#include <random>
+#include <span>
+#include <utility>
+
+#include "absl/status/status.h"
+#include "cryptopals/util/aes.h"
+#include "cryptopals/util/bytes.h"
+#include "cryptopals/util/bytes_view.h"
+#include "googletest/status_matchers.h"
+#include "gtest/gtest.h"
+
+namespace cryptopals::cipher {
+
+using cryptopals::util::AesKeySchedule;
+using cryptopals::util::Bytes;
+using cryptopals::util::BytesView;
+
+TEST(AesCtrTest, CryptopalsVector) {
+  AesCtr aes_ctr;
+  Bytes key = Bytes::CreateFromRaw("YELLOW SUBMARINE");
+  Bytes ciphertext = Bytes::CreateFromBase64(
+      "L77na/nrFsKvynd6HzOoG7GHTLXsTVu9qvY/2syLXzhPweyyMTJULu/6/kXX0KSvoOLSFQ==");
+
+  EXPECT_EQ(aes_ctr.Decrypt(ciphertext, key).ToRaw(),
+            "Yo, VIP Let's kick it Ice, Ice, baby Ice, Ice, baby ");
+  EXPECT_EQ(aes_ctr.Encrypt(aes_ctr.Decrypt(ciphertext, key), key),
+            ciphertext);
+}
+
+TEST(AesCtrTest, NistVector) {
+  // The example vector of section F.5.1 of NIST SP 800-38A.
+  AesCtr aes_ctr;
+  ASSERT_OK(aes_ctr.SetCounterLayout(AesCtrCounterLayout::BigEndian64()));
+  ASSERT_OK(aes_ctr.SetIv(
+      Bytes::CreateFromHex("f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff")));
+  Bytes key = Bytes::CreateFromHex("2b7e151628aed2a6abf7158809cf4f3c");
+  Bytes plaintext = Bytes::CreateFromHex(
+      "6bc1bee22e409f96e93d7e117393172aae2d8a571e03ac9c9eb76fac45af8e51"
+      "30c81c46a35ce411e5fbc1191a0a52eff69f2445df4f9b17ad2b417be66c3710");
+  Bytes ciphertext = Bytes::CreateFromHex(
+      "874d6191b620e3261bef6864990db6ce9806f66b7970fdff8617187bb9fffdff"
+      "5ae4df3edbd5d35e5b4f09020db03eab1e031dda2fbe03d1792170a0f3009cee");
+
+  EXPECT_EQ(aes_ctr.Encrypt(plaintext, key), ciphertext);
+  EXPECT_EQ(aes_ctr.Decrypt(ciphertext, key), plaintext);
+}
+
+TEST(AesCtrTest, DecryptAtMatchesFullDecryption) {
+  AesCtr aes_ctr;
+  ASSERT_OK(aes_ctr.SetIv(
+      Bytes::CreateFromHex("0123456789abcdeffeffffffffffffff")));
+  ASSERT_OK_AND_ASSIGN(
+      AesKeySchedule key_schedule,
+      AesKeySchedule::Create(Bytes::CreateFromRaw("YELLOW SUBMARINE")));
+
+  // Large enough to be split into several chunks, with a counter that wraps
+  // around after the second block.
+  std::mt19937 generator(18);
+  Bytes plaintext(16 * 10007 + 5);
+  for (uint8_t& byte : plaintext) {
+    byte = generator();
+  }
+  Bytes ciphertext = aes_ctr.Encrypt(plaintext, key_schedule);
+  ASSERT_EQ(ciphertext.size(), plaintext.size());
+
+  for (auto [offset, size] : std::initializer_list<std::pair<size_t, size_t>>{
+           {0, 1}, {3, 10}, {15, 2}, {16, 16}, {100, 5000}, {77777, 80000}}) {
+    Bytes slice(size);
+    ASSERT_OK(aes_ctr.DecryptAt(
+        offset, BytesView(ciphertext).subview(offset, size), key_schedule,
+        slice));
+    EXPECT_EQ(slice, Bytes::CreateFromRange(plaintext.begin() + offset,
+                                            plaintext.begin() + offset + size))
+        << "offset " << offset << " size " << size;
+  }
+
+  // Decrypting in place.
+  ASSERT_OK(aes_ctr.DecryptAt(0, ciphertext, key_schedule, ciphertext));
+  EXPECT_EQ(ciphertext, plaintext);
+}
+
+TEST(AesCtrTest, RejectsInvalidConfiguration) {
+  AesCtr aes_ctr;
+  EXPECT_EQ(aes_ctr.SetIv(Bytes::CreateFromHex("00")).code(),
+            absl::StatusCode::kInvalidArgument);
+  EXPECT_EQ(aes_ctr
+                .SetCounterLayout(
+                    {.offset = 0, .size = 16, .little_endian = false})
+                .code(),
+            absl::StatusCode::kInvalidArgument);
+  EXPECT_EQ(aes_ctr
+                .SetCounterLayout(
+                    {.offset = 12, .size = 8, .little_endian = false})
+                .code(),
+            absl::StatusCode::kInvalidArgument);
+  ASSERT_OK(aes_ctr.SetCounterLayout(
+      {.offset = 12, .size = 4, .little_endian = false}));
+}
+
+}  // namespace cryptopals::cipher
@@ -6,78 +6,128 @@
 #include <algorithm>
 #include <span>
 
+#include "absl/status/status.h"
 #include "absl/status/status_macros.h"
 #include "absl/status/statusor.h"
 #include "cryptopals/analysis/aes_block_analyzer.h"
 #include "cryptopals/util/aes.h"
+#include "cryptopals/util/aes_engine.h"
 #include "cryptopals/util/algorithm.h"
 #include "cryptopals/util/logging.h"
 
 namespace cryptopals::cipher {
 
+using cryptopals::util::AesKeySchedule;
 using cryptopals::util::AesState;
 using cryptopals::util::Bytes;
+using cryptopals::util::BytesView;
+using cryptopals::util::GetDefaultAesEngine;
+
+namespace {
+
+// Checks that `input` holds whole AES blocks and that `output` can receive
+// them, either in place or in a separate buffer.
+absl::Status ValidateBlockSpans(std::span<const uint8_t> input,
+                                std::span<uint8_t> output) {
+  if (input.size() % AesState::SIZE_BYTES != 0) {
+    return absl::InvalidArgumentErrorBuilder()
+           << "input is not a multiple of AES block size ("
+           << AesState::SIZE_BYTES << " bytes)";
+  }
+  if (output.size() != input.size()) {
+    return absl::InvalidArgumentErrorBuilder()
+           << "output size (" << output.size()
+           << " bytes) does not match input size (" << input.size()
+           << " bytes)";
+  }
 
-Bytes AesEcb::Encrypt(const Bytes& plaintext, const Bytes& key) const {
-  if (plaintext.size() % AesState::SIZE_BYTES != 0) {
-    LOG(ERROR) << "Error: plaintext is not a multiple of AES block size ("
-               << AesState::SIZE_BYTES << " bytes)";
-    return Bytes();
+  const uint8_t* output_begin = output.data();
+  const uint8_t* output_end = output.data() + output.size();
+  const bool overlaps =
+      input.data() < output_end && output_begin < input.data() + input.size();
+  if (overlaps && input.data() != output_begin) {
+    return absl::InvalidArgumentError(
+        "input and output must be identical or must not overlap");
   }
+  return absl::OkStatus();
+}
 
-  Bytes ciphertext;
+}  // namespace
 
-  for (size_t i = 0; i < plaintext.size(); i += AesState::SIZE_BYTES) {
-    cryptopals::util::aes_block_span block(plaintext.begin() + i,
-                                           AesState::SIZE_BYTES);
+Bytes AesEcb::Encrypt(BytesView plaintext, const Bytes& key) const {
+  absl::StatusOr<AesKeySchedule> key_schedule = AesKeySchedule::Create(key);
+  if (!key_schedule.ok()) {
+    LOG(ERROR) << "Error expanding key: " << key_schedule.status();
+    return Bytes();
+  }
+  return Encrypt(plaintext, key_schedule.value());
+}
 
-    absl::StatusOr<Bytes> encrypted_block =
-        cryptopals::util::EncryptBlock(block, key);
-    if (!encrypted_block.ok()) {
-      LOG(ERROR) << "Error encrypting block at offset " << i << ": "
-                 << encrypted_block.status();
-      return Bytes();
-    }
-    ciphertext.Append(encrypted_block.value());
+Bytes AesEcb::Decrypt(BytesView ciphertext, const Bytes& key) const {
+  absl::StatusOr<AesKeySchedule> key_schedule = AesKeySchedule::Create(key);
+  if (!key_schedule.ok()) {
+    LOG(ERROR) << "Error expanding key: " << key_schedule.status();
+    return Bytes();
   }
+  return Decrypt(ciphertext, key_schedule.value());
+}
 
+Bytes AesEcb::Encrypt(BytesView plaintext,
+                      const AesKeySchedule& key_schedule) const {
+  Bytes ciphertext(plaintext.size());
+  absl::Status status = EncryptBlocks(
+      plaintext, key_schedule,
+      std::span<uint8_t>(ciphertext.begin(), ciphertext.size()));
+  if (!status.ok()) {
+    LOG(ERROR) << "Error encrypting plaintext: " << status;
+    return Bytes();
+  }
   return ciphertext;
 }
 
-Bytes AesEcb::Decrypt(const Bytes& ciphertext, const Bytes& key) const {
-  if (ciphertext.size() % AesState::SIZE_BYTES != 0) {
-    LOG(ERROR) << "Error: ciphertext is not a multiple of AES block size ("
-               << AesState::SIZE_BYTES << " bytes)";
+Bytes AesEcb::Decrypt(BytesView ciphertext,
+                      const AesKeySchedule& key_schedule) const {
+  Bytes plaintext(ciphertext.size());
+  absl::Status status = DecryptBlocks(
+      ciphertext, key_schedule,
+      std::span<uint8_t>(plaintext.begin(), plaintext.size()));
+  if (!status.ok()) {
+    LOG(ERROR) << "Error decrypting ciphertext: " << status;
     return Bytes();
   }
+  return plaintext;
+}
 
-  Bytes plaintext;
+absl::Status AesEcb::EncryptBlocks(std::span<const uint8_t> plaintext,
+                                   const AesKeySchedule& key_schedule,
+                                   std::span<uint8_t> ciphertext) const {
+  RETURN_IF_ERROR(ValidateBlockSpans(plaintext, ciphertext));
 
-  for (size_t i = 0; i < ciphertext.size(); i += AesState::SIZE_BYTES) {
-    cryptopals::util::aes_block_span block(ciphertext.begin() + i,
-                                           AesState::SIZE_BYTES);
+  // Every block is independent, so the engine is free to encrypt several
+  // blocks at once.
+  GetDefaultAesEngine().EncryptBlocks(plaintext, key_schedule, ciphertext);
+  return absl::OkStatus();
+}
 
-    absl::StatusOr<Bytes> decrypted_block =
-        cryptopals::util::DecryptBlock(block, key);
-    if (!decrypted_block.ok()) {
-      LOG(ERROR) << "Error decrypting block at offset " << i << ": "
-                 << decrypted_block.status();
-      return Bytes();
-    }
-    plaintext.Append(decrypted_block.value());
-  }
+absl::Status AesEcb::DecryptBlocks(std::span<const uint8_t> ciphertext,
+                                   const AesKeySchedule& key_schedule,
+                                   std::span<uint8_t> plaintext) const {
+  RETURN_IF_ERROR(ValidateBlockSpans(ciphertext, plaintext));
 
-  return plaintext;
+  // Every block is independent, so the engine is free to decrypt several
+  // blocks at once.
+  GetDefaultAesEngine().DecryptBlocks(ciphertext, key_schedule, plaintext);
+  return absl::OkStatus();
 }
 
-AesEcb::DecryptionResultType AesEcb::Crack(const Bytes& ciphertext) {
+AesEcb::DecryptionResultType AesEcb::Crack(BytesView ciphertext) {
   DecryptionResultType decryption_result = {
       .score = std::numeric_limits<double>::max()};
 
   return decryption_result;
 }
 
-double AesEcb::Detect(const Bytes& ciphertext) {
+double AesEcb::Detect(BytesView ciphertext) {
   cryptopals::analysis::AesBlockAnalyzer aes_block_analyzer;
   return aes_block_analyzer.AnalyzeBytes(ciphertext);
 }
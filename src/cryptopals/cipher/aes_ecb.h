@@ -4,7 +4,14 @@
 #ifndef CRYPTOPALS_CIPHER_AES_ECB_H_
 #define CRYPTOPALS_CIPHER_AES_ECB_H_
 
+#include <cstdint>
+#include <span>
+
+#include "absl/status/status.h"
 #include "cryptopals/cipher/symmetric_cipher.h"
+#include "cryptopals/util/aes.h"
+#include "cryptopals/util/bytes.h"
+#include "cryptopals/util/bytes_view.h"
 
 namespace cryptopals::cipher {
 
@@ -12,20 +19,48 @@ class AesEcb : public SymmetricCipherInterface<cryptopals::util::Bytes> {
  public:
   // Implements Encrypt from CipherInterface.
   cryptopals::util::Bytes Encrypt(
-      const cryptopals::util::Bytes& plaintext,
+      cryptopals::util::BytesView plaintext,
       const cryptopals::util::Bytes& key) const override;
 
   // Implements Decrypt from CipherInterface.
-  cryptopals::util::Bytes Decrypt(const cryptopals::util::Bytes& ciphertext,
+  cryptopals::util::Bytes Decrypt(cryptopals::util::BytesView ciphertext,
                                   const cryptopals::util::Bytes& key) const;
 
+  // Encrypts `plaintext` using a previously expanded `key_schedule`. Prefer
+  // this overload when the same key is used for several messages.
+  cryptopals::util::Bytes Encrypt(
+      cryptopals::util::BytesView plaintext,
+      const cryptopals::util::AesKeySchedule& key_schedule) const;
+
+  // Decrypts `ciphertext` using a previously expanded `key_schedule`. Prefer
+  // this overload when the same key is used for several messages.
+  cryptopals::util::Bytes Decrypt(
+      cryptopals::util::BytesView ciphertext,
+      const cryptopals::util::AesKeySchedule& key_schedule) const;
+
+  // Encrypts the contiguous blocks of `plaintext` into `ciphertext` without
+  // allocating. `ciphertext` must be the same size as `plaintext`, and the two
+  // spans must either be identical (to encrypt in place) or not overlap. The
+  // size must be a multiple of the AES block size.
+  absl::Status EncryptBlocks(
+      std::span<const uint8_t> plaintext,
+      const cryptopals::util::AesKeySchedule& key_schedule,
+      std::span<uint8_t> ciphertext) const;
+
+  // Decrypts the contiguous blocks of `ciphertext` into `plaintext` without
+  // allocating. The requirements on the spans match those of EncryptBlocks.
+  absl::Status DecryptBlocks(
+      std::span<const uint8_t> ciphertext,
+      const cryptopals::util::AesKeySchedule& key_schedule,
+      std::span<uint8_t> plaintext) const;
+
   // Cracks the cipher and returns the most likely decryption result for
   // `ciphertext`.
-  DecryptionResultType Crack(const cryptopals::util::Bytes& ciphertext);
+  DecryptionResultType Crack(cryptopals::util::BytesView ciphertext);
 
   // Detect determines the probability (range [0-1]) that `ciphertext` was
   // encrypted using this cipher.
-  double Detect(const cryptopals::util::Bytes& ciphertext);
+  double Detect(cryptopals::util::BytesView ciphertext);
 };
 
 }  // namespace cryptopals::cipher
@@ -0,0 +1,89 @@
+#include "cryptopals/cipher/aes_ecb.h"
+
+#include <span>
+
+#include "absl/status/status.h"
+#include "cryptopals/util/aes.h"
+#include "cryptopals/util/bytes.h"
+#include "googletest/status_matchers.h"
+#include "gtest/gtest.h"
+
+namespace cryptopals::cipher {
+
+using cryptopals::util::AesKeySchedule;
+using cryptopals::util::Bytes;
+
+// Two copies of the example vector of Appendix C.1 of FIPS-197.
+constexpr char KEY[] = "000102030405060708090a0b0c0d0e0f";
+constexpr char PLAINTEXT[] =
+    "00112233445566778899aabbccddeeff00112233445566778899aabbccddeeff";
+constexpr char CIPHERTEXT[] =
+    "69c4e0d86a7b0430d8cdb78070b4c55a69c4e0d86a7b0430d8cdb78070b4c55a";
+
+TEST(AesEcbTest, EncryptDecryptBytes) {
+  AesEcb aes_ecb;
+  Bytes key = Bytes::CreateFromHex(KEY);
+  Bytes plaintext = Bytes::CreateFromHex(PLAINTEXT);
+  Bytes ciphertext = Bytes::CreateFromHex(CIPHERTEXT);
+
+  EXPECT_EQ(aes_ecb.Encrypt(plaintext, key), ciphertext);
+  EXPECT_EQ(aes_ecb.Decrypt(ciphertext, key), plaintext);
+}
+
+TEST(AesEcbTest, EncryptDecryptBlocks) {
+  AesEcb aes_ecb;
+  ASSERT_OK_AND_ASSIGN(AesKeySchedule key_schedule,
+                       AesKeySchedule::Create(Bytes::CreateFromHex(KEY)));
+  Bytes plaintext = Bytes::CreateFromHex(PLAINTEXT);
+  Bytes ciphertext = Bytes::CreateFromHex(CIPHERTEXT);
+
+  Bytes output(plaintext.size());
+  ASSERT_OK(aes_ecb.EncryptBlocks(plaintext, key_schedule, output));
+  EXPECT_EQ(output, ciphertext);
+
+  ASSERT_OK(aes_ecb.DecryptBlocks(ciphertext, key_schedule, output));
+  EXPECT_EQ(output, plaintext);
+}
+
+TEST(AesEcbTest, EncryptDecryptBlocksInPlace) {
+  AesEcb aes_ecb;
+  ASSERT_OK_AND_ASSIGN(AesKeySchedule key_schedule,
+                       AesKeySchedule::Create(Bytes::CreateFromHex(KEY)));
+  Bytes buffer = Bytes::CreateFromHex(PLAINTEXT);
+
+  ASSERT_OK(aes_ecb.EncryptBlocks(buffer, key_schedule, buffer));
+  EXPECT_EQ(buffer, Bytes::CreateFromHex(CIPHERTEXT));
+
+  ASSERT_OK(aes_ecb.DecryptBlocks(buffer, key_schedule, buffer));
+  EXPECT_EQ(buffer, Bytes::CreateFromHex(PLAINTEXT));
+}
+
+TEST(AesEcbTest, BlocksRejectInvalidSpans) {
+  AesEcb aes_ecb;
+  ASSERT_OK_AND_ASSIGN(AesKeySchedule key_schedule,
+                       AesKeySchedule::Create(Bytes::CreateFromHex(KEY)));
+  Bytes buffer = Bytes::CreateFromHex(PLAINTEXT);
+  std::span<uint8_t> blocks(buffer);
+
+  // Partial block.
+  EXPECT_EQ(aes_ecb
+                .EncryptBlocks(blocks.first(15), key_schedule, blocks.first(15))
+                .code(),
+            absl::StatusCode::kInvalidArgument);
+
+  // Mismatched sizes.
+  Bytes output(16);
+  EXPECT_EQ(aes_ecb.DecryptBlocks(blocks, key_schedule, output).code(),
+            absl::StatusCode::kInvalidArgument);
+
+  // Partially overlapping buffers.
+  Bytes large_buffer(48);
+  std::span<uint8_t> large_blocks(large_buffer);
+  EXPECT_EQ(aes_ecb
+                .EncryptBlocks(large_blocks.first(32), key_schedule,
+                               large_blocks.last(32))
+                .code(),
+            absl::StatusCode::kInvalidArgument);
+}
+
+}  // namespace cryptopals::cipher
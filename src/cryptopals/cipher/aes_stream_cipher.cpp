@@ -0,0 +1,183 @@
+// DISCLAIMER: This algorithm is implemented for educational purposes only. By
+// no means is it guaranteed to be secure.
+
+#include "cryptopals/cipher/aes_stream_cipher.h"
+
+#include <algorithm>
+#include <span>
+
+#include "absl/status/status.h"
+#include "absl/status/status_macros.h"
+#include "absl/status/statusor.h"
+#include "cryptopals/util/aes.h"
+#include "cryptopals/util/algorithm.h"
+#include "cryptopals/util/bytes.h"
+#include "cryptopals/util/padding.h"
+
+namespace cryptopals::cipher {
+
+using cryptopals::util::AesKeySchedule;
+using cryptopals::util::AesState;
+using cryptopals::util::Bytes;
+using cryptopals::util::FloorMultiple;
+
+absl::StatusOr<AesStreamCipher> AesStreamCipher::Create(
+    cryptopals::CipherAction action, cryptopals::AesMode mode,
+    const AesKeySchedule& key_schedule, const Bytes& iv,
+    const Options& options) {
+  if (action != cryptopals::CipherAction::ENCRYPT &&
+      action != cryptopals::CipherAction::DECRYPT) {
+    return absl::InvalidArgumentErrorBuilder()
+           << "Unsupported cipher action: " << CipherAction_Name(action);
+  }
+
+  AesStreamCipher cipher(action, mode, key_schedule, options);
+  switch (mode) {
+    case cryptopals::AesMode::ECB:
+      break;
+    case cryptopals::AesMode::CBC:
+      RETURN_IF_ERROR(cipher.aes_cbc_.SetIv(iv));
+      break;
+    case cryptopals::AesMode::CTR:
+      RETURN_IF_ERROR(cipher.aes_ctr_.SetCounterLayout(options.counter_layout));
+      RETURN_IF_ERROR(cipher.aes_ctr_.SetIv(iv));
+      break;
+    default:
+      return absl::InvalidArgumentErrorBuilder()
+             << "Unsupported AES mode: " << AesMode_Name(mode);
+  }
+  return cipher;
+}
+
+absl::StatusOr<size_t> AesStreamCipher::Update(std::span<const uint8_t> input,
+                                               std::span<uint8_t> output) {
+  if (finalized_) {
+    return absl::FailedPreconditionError("cipher is already finalized");
+  }
+
+  // CTR mode needs no buffering: the keystream can start at any byte.
+  if (mode_ == cryptopals::AesMode::CTR) {
+    if (output.size() < input.size()) {
+      return absl::InvalidArgumentError("output is too small");
+    }
+    RETURN_IF_ERROR(aes_ctr_.EncryptAt(offset_, input, key_schedule_,
+                                       output.first(input.size())));
+    offset_ += input.size();
+    return input.size();
+  }
+
+  // Every whole block is processed, except for the last block when it may hold
+  // padding that Finalize() has to remove.
+  const size_t available = buffer_size_ + input.size();
+  size_t output_size = FloorMultiple(available, AesState::SIZE_BYTES);
+  if (HoldsBackLastBlock() && output_size > 0 && output_size == available) {
+    output_size -= AesState::SIZE_BYTES;
+  }
+  if (output.size() < output_size) {
+    return absl::InvalidArgumentError("output is too small");
+  }
+
+  size_t input_used = 0;
+  size_t output_used = 0;
+  if (output_size > 0 && buffer_size_ > 0) {
+    // Completes the buffered block with the start of the input.
+    input_used = AesState::SIZE_BYTES - buffer_size_;
+    std::copy_n(input.begin(), input_used, buffer_.begin() + buffer_size_);
+    RETURN_IF_ERROR(
+        ProcessBlocks(buffer_, output.first(AesState::SIZE_BYTES)));
+    buffer_size_ = 0;
+    output_used = AesState::SIZE_BYTES;
+  }
+
+  // The remaining blocks are processed straight from the input.
+  const size_t direct_size = output_size - output_used;
+  RETURN_IF_ERROR(ProcessBlocks(input.subspan(input_used, direct_size),
+                                output.subspan(output_used, direct_size)));
+  input_used += direct_size;
+
+  std::copy(input.begin() + input_used, input.end(),
+            buffer_.begin() + buffer_size_);
+  buffer_size_ += input.size() - input_used;
+  return output_size;
+}
+
+absl::StatusOr<size_t> AesStreamCipher::Finalize(std::span<uint8_t> output) {
+  if (finalized_) {
+    return absl::FailedPreconditionError("cipher is already finalized");
+  }
+  finalized_ = true;
+
+  if (mode_ == cryptopals::AesMode::CTR) {
+    return 0;
+  }
+
+  if (!options_.pkcs7_padding) {
+    if (buffer_size_ != 0) {
+      return absl::InvalidArgumentErrorBuilder()
+             << "message is not a multiple of AES block size ("
+             << AesState::SIZE_BYTES << " bytes)";
+    }
+    return 0;
+  }
+
+  if (output.size() < MaxFinalizeOutputSize()) {
+    return absl::InvalidArgumentError("output is too small");
+  }
+
+  if (action_ == cryptopals::CipherAction::ENCRYPT) {
+    cryptopals::util::FillPkcs7Padding(buffer_, buffer_size_);
+    RETURN_IF_ERROR(ProcessBlocks(buffer_, output.first(AesState::SIZE_BYTES)));
+    return AesState::SIZE_BYTES;
+  }
+
+  // A padded message always ends with a whole block, which Update() held back.
+  if (buffer_size_ != AesState::SIZE_BYTES) {
+    return absl::InvalidArgumentErrorBuilder()
+           << "ciphertext is not a multiple of AES block size ("
+           << AesState::SIZE_BYTES << " bytes)";
+  }
+  std::array<uint8_t, AesState::SIZE_BYTES> last_block;
+  RETURN_IF_ERROR(ProcessBlocks(buffer_, last_block));
+  ASSIGN_OR_RETURN(size_t padding_size,
+                   cryptopals::util::GetPkcs7PaddingSize(last_block));
+
+  const size_t output_size = AesState::SIZE_BYTES - padding_size;
+  std::copy_n(last_block.begin(), output_size, output.begin());
+  return output_size;
+}
+
+size_t AesStreamCipher::MaxUpdateOutputSize(size_t input_size) const {
+  return input_size + AesState::SIZE_BYTES;
+}
+
+size_t AesStreamCipher::MaxFinalizeOutputSize() const {
+  return AesState::SIZE_BYTES;
+}
+
+bool AesStreamCipher::HoldsBackLastBlock() const {
+  return action_ == cryptopals::CipherAction::DECRYPT &&
+         options_.pkcs7_padding;
+}
+
+absl::Status AesStreamCipher::ProcessBlocks(std::span<const uint8_t> input,
+                                            std::span<uint8_t> output) {
+  if (input.empty()) {
+    return absl::OkStatus();
+  }
+
+  const bool encrypt = action_ == cryptopals::CipherAction::ENCRYPT;
+  if (mode_ == cryptopals::AesMode::ECB) {
+    return encrypt ? aes_ecb_.EncryptBlocks(input, key_schedule_, output)
+                   : aes_ecb_.DecryptBlocks(input, key_schedule_, output);
+  }
+
+  // In CBC mode the last ciphertext block becomes the iv of the next call.
+  RETURN_IF_ERROR(encrypt
+                      ? aes_cbc_.EncryptBlocks(input, key_schedule_, output)
+                      : aes_cbc_.DecryptBlocks(input, key_schedule_, output));
+  std::span<const uint8_t> ciphertext = encrypt ? output : input;
+  return aes_cbc_.SetIv(Bytes(ciphertext.end() - AesState::SIZE_BYTES,
+                              ciphertext.end()));
+}
+
+}  // namespace cryptopals::cipher
@@ -0,0 +1,98 @@
+// DISCLAIMER: This algorithm is implemented for educational purposes only. By
+// no means is it guaranteed to be secure.
+
+#ifndef CRYPTOPALS_CIPHER_AES_STREAM_CIPHER_H_
+#define CRYPTOPALS_CIPHER_AES_STREAM_CIPHER_H_
+
+#include <array>
+#include <cstdint>
+#include <span>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "cryptopals/cipher/aes_cbc.h"
+#include "cryptopals/cipher/aes_ctr.h"
+#include "cryptopals/cipher/aes_ecb.h"
+#include "cryptopals/cipher/streaming_cipher.h"
+#include "cryptopals/proto/cryptopals_enums.pb.h"
+#include "cryptopals/util/aes.h"
+#include "cryptopals/util/bytes.h"
+
+namespace cryptopals::cipher {
+
+// AesStreamCipher encrypts or decrypts a message with AES in ECB, CBC or CTR
+// mode, one piece at a time. Partial blocks and the chaining state of the mode
+// are carried between calls to Update(), so memory use does not depend on the
+// size of the message.
+class AesStreamCipher : public StreamingCipherInterface {
+ public:
+  struct Options {
+    // Whether PKCS#7 padding is added when encrypting and removed when
+    // decrypting. Only used by the ECB and CBC modes; CTR mode never pads.
+    bool pkcs7_padding = true;
+
+    // The position of the counter within the counter block in CTR mode.
+    AesCtrCounterLayout counter_layout = AesCtrCounterLayout::Cryptopals();
+  };
+
+  // Creates a cipher that performs `action` (ENCRYPT or DECRYPT) in `mode`.
+  // `iv` is the initialization vector in CBC mode and the initial counter
+  // block in CTR mode; it is ignored in ECB mode and may be empty.
+  static absl::StatusOr<AesStreamCipher> Create(
+      cryptopals::CipherAction action, cryptopals::AesMode mode,
+      const cryptopals::util::AesKeySchedule& key_schedule,
+      const cryptopals::util::Bytes& iv, const Options& options);
+
+  // Implements Update from StreamingCipherInterface.
+  absl::StatusOr<size_t> Update(std::span<const uint8_t> input,
+                                std::span<uint8_t> output) override;
+
+  // Implements Finalize from StreamingCipherInterface.
+  absl::StatusOr<size_t> Finalize(std::span<uint8_t> output) override;
+
+  // Implements MaxUpdateOutputSize from StreamingCipherInterface.
+  size_t MaxUpdateOutputSize(size_t input_size) const override;
+
+  // Implements MaxFinalizeOutputSize from StreamingCipherInterface.
+  size_t MaxFinalizeOutputSize() const override;
+
+ private:
+  AesStreamCipher(cryptopals::CipherAction action, cryptopals::AesMode mode,
+                  const cryptopals::util::AesKeySchedule& key_schedule,
+                  const Options& options)
+      : action_(action),
+        mode_(mode),
+        key_schedule_(key_schedule),
+        options_(options) {}
+
+  // Whether the last block of the message is held back until Finalize(), so
+  // that its padding can be removed.
+  bool HoldsBackLastBlock() const;
+
+  // Encrypts or decrypts whole blocks, updating the chaining state.
+  absl::Status ProcessBlocks(std::span<const uint8_t> input,
+                             std::span<uint8_t> output);
+
+  cryptopals::CipherAction action_;
+  cryptopals::AesMode mode_;
+  cryptopals::util::AesKeySchedule key_schedule_;
+  Options options_;
+
+  AesEcb aes_ecb_;
+  AesCbc aes_cbc_;
+  AesCtr aes_ctr_;
+
+  // The number of bytes processed so far in CTR mode.
+  uint64_t offset_ = 0;
+
+  // Input that does not fill a whole block yet, or the block held back for
+  // Finalize().
+  std::array<uint8_t, cryptopals::util::AesState::SIZE_BYTES> buffer_ = {0};
+  size_t buffer_size_ = 0;
+
+  bool finalized_ = false;
+};
+
+}  // namespace cryptopals::cipher
+
+#endif  // CRYPTOPALS_CIPHER_AES_STREAM_CIPHER_H_
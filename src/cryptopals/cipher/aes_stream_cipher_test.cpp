@@ -0,0 +1,175 @@
+#include "cryptopals/cipher/aes_stream_cipher.h"
+
+#include <algorithm>
+#include <random>
+#include <span>
+#include <tuple>
+
+#include "absl/status/status.h"
+#include "absl/status/status_macros.h"
+#include "absl/status/statusor.h"
+#include "cryptopals/cipher/aes_cbc.h"
+#include "cryptopals/cipher/aes_ctr.h"
+#include "cryptopals/cipher/aes_ecb.h"
+#include "cryptopals/proto/cryptopals_enums.pb.h"
+#include "cryptopals/util/aes.h"
+#include "cryptopals/util/bytes.h"
+#include "cryptopals/util/padding.h"
+#include "googletest/status_matchers.h"
+#include "gtest/gtest.h"
+
+namespace cryptopals::cipher {
+
+using cryptopals::util::AesKeySchedule;
+using cryptopals::util::Bytes;
+
+constexpr char KEY[] = "YELLOW SUBMARINE";
+constexpr char IV[] = "000102030405060708090a0b0c0d0e0f";
+
+// Runs `message` through `cipher` in pieces of random size.
+absl::StatusOr<Bytes> RunInPieces(AesStreamCipher& cipher,
+                                  const Bytes& message,
+                                  std::mt19937& generator) {
+  Bytes result;
+  size_t position = 0;
+  while (position < message.size()) {
+    const size_t piece_size = std::min<size_t>(
+        std::uniform_int_distribution<size_t>(0, 40)(generator),
+        message.size() - position);
+    Bytes output(cipher.MaxUpdateOutputSize(piece_size));
+    ASSIGN_OR_RETURN(
+        size_t output_size,
+        cipher.Update(std::span<const uint8_t>(message.begin() + position,
+                                               piece_size),
+                      std::span<uint8_t>(output.begin(), output.size())));
+    output.Resize(output_size);
+    result.Append(output);
+    position += piece_size;
+  }
+
+  Bytes output(cipher.MaxFinalizeOutputSize());
+  ASSIGN_OR_RETURN(size_t output_size,
+                   cipher.Finalize(
+                       std::span<uint8_t>(output.begin(), output.size())));
+  output.Resize(output_size);
+  result.Append(output);
+  return result;
+}
+
+class AesStreamCipherTest
+    : public testing::TestWithParam<std::tuple<cryptopals::AesMode, bool>> {
+ protected:
+  // Encrypts `plaintext` in a single call, padding it when needed.
+  Bytes EncryptAll(Bytes plaintext, const Bytes& key) {
+    auto [mode, pkcs7_padding] = GetParam();
+    if (mode != cryptopals::AesMode::CTR && pkcs7_padding) {
+      cryptopals::util::AddPkcs7Padding(plaintext, 16);
+    }
+    switch (mode) {
+      case cryptopals::AesMode::ECB:
+        return AesEcb().Encrypt(plaintext, key);
+      case cryptopals::AesMode::CBC: {
+        AesCbc aes_cbc;
+        EXPECT_OK(aes_cbc.SetIv(Bytes::CreateFromHex(IV)));
+        return aes_cbc.Encrypt(plaintext, key);
+      }
+      default: {
+        AesCtr aes_ctr;
+        EXPECT_OK(aes_ctr.SetIv(Bytes::CreateFromHex(IV)));
+        return aes_ctr.Encrypt(plaintext, key);
+      }
+    }
+  }
+};
+
+TEST_P(AesStreamCipherTest, MatchesSingleCall) {
+  auto [mode, pkcs7_padding] = GetParam();
+  Bytes key = Bytes::CreateFromRaw(KEY);
+  ASSERT_OK_AND_ASSIGN(AesKeySchedule key_schedule,
+                       AesKeySchedule::Create(key));
+  const AesStreamCipher::Options options = {.pkcs7_padding = pkcs7_padding};
+
+  std::mt19937 generator(8);
+  for (size_t size : {0, 1, 15, 16, 17, 32, 100, 1000}) {
+    if (mode != cryptopals::AesMode::CTR && !pkcs7_padding && size % 16 != 0) {
+      continue;
+    }
+    Bytes plaintext(size);
+    for (uint8_t& byte : plaintext) {
+      byte = generator();
+    }
+    Bytes ciphertext = EncryptAll(plaintext, key);
+
+    ASSERT_OK_AND_ASSIGN(
+        AesStreamCipher encryptor,
+        AesStreamCipher::Create(cryptopals::CipherAction::ENCRYPT, mode,
+                                key_schedule, Bytes::CreateFromHex(IV),
+                                options));
+    ASSERT_OK_AND_ASSIGN(Bytes streamed_ciphertext,
+                         RunInPieces(encryptor, plaintext, generator));
+    EXPECT_EQ(streamed_ciphertext, ciphertext) << "size " << size;
+
+    ASSERT_OK_AND_ASSIGN(
+        AesStreamCipher decryptor,
+        AesStreamCipher::Create(cryptopals::CipherAction::DECRYPT, mode,
+                                key_schedule, Bytes::CreateFromHex(IV),
+                                options));
+    ASSERT_OK_AND_ASSIGN(Bytes streamed_plaintext,
+                         RunInPieces(decryptor, ciphertext, generator));
+    EXPECT_EQ(streamed_plaintext, plaintext) << "size " << size;
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    AesStreamCipherParameterized, AesStreamCipherTest,
+    testing::Combine(testing::Values(cryptopals::AesMode::ECB,
+                                     cryptopals::AesMode::CBC,
+                                     cryptopals::AesMode::CTR),
+                     testing::Bool()),
+    [](const testing::TestParamInfo<AesStreamCipherTest::ParamType>& info) {
+      return cryptopals::AesMode_Name(std::get<0>(info.param)) +
+             (std::get<1>(info.param) ? "_Padded" : "_Unpadded");
+    });
+
+TEST(AesStreamCipherErrorTest, RejectsTruncatedCiphertext) {
+  ASSERT_OK_AND_ASSIGN(AesKeySchedule key_schedule,
+                       AesKeySchedule::Create(Bytes::CreateFromRaw(KEY)));
+  ASSERT_OK_AND_ASSIGN(
+      AesStreamCipher decryptor,
+      AesStreamCipher::Create(cryptopals::CipherAction::DECRYPT,
+                              cryptopals::AesMode::ECB, key_schedule, Bytes(),
+                              {}));
+
+  Bytes ciphertext(20);
+  Bytes output(decryptor.MaxUpdateOutputSize(ciphertext.size()));
+  ASSERT_OK(decryptor
+                .Update(std::span<const uint8_t>(ciphertext.begin(),
+                                                 ciphertext.size()),
+                        std::span<uint8_t>(output.begin(), output.size()))
+                .status());
+  EXPECT_EQ(decryptor
+                .Finalize(std::span<uint8_t>(output.begin(), output.size()))
+                .status()
+                .code(),
+            absl::StatusCode::kInvalidArgument);
+  EXPECT_EQ(decryptor
+                .Finalize(std::span<uint8_t>(output.begin(), output.size()))
+                .status()
+                .code(),
+            absl::StatusCode::kFailedPrecondition);
+}
+
+TEST(AesStreamCipherErrorTest, RejectsInvalidConfiguration) {
+  ASSERT_OK_AND_ASSIGN(AesKeySchedule key_schedule,
+                       AesKeySchedule::Create(Bytes::CreateFromRaw(KEY)));
+  EXPECT_FALSE(AesStreamCipher::Create(cryptopals::CipherAction::CRACK,
+                                       cryptopals::AesMode::ECB, key_schedule,
+                                       Bytes(), {})
+                   .ok());
+  EXPECT_FALSE(AesStreamCipher::Create(cryptopals::CipherAction::ENCRYPT,
+                                       cryptopals::AesMode::CBC, key_schedule,
+                                       Bytes(), {})
+                   .ok());
+}
+
+}  // namespace cryptopals::cipher
@@ -0,0 +1,165 @@
+#include "cryptopals/cipher/cipher_stream.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/status/status_macros.h"
+#include "absl/strings/ascii.h"
+#include "cryptopals/util/bytes.h"
+#include "cryptopals/util/codecs.h"
+
+namespace cryptopals::cipher {
+namespace {
+
+using cryptopals::util::Bytes;
+
+// Returns the number of chars, not counting whitespace, that decode to a whole
+// number of bytes in `format`.
+size_t DecodeGroupChars(cryptopals::BytesEncodedFormat format) {
+  switch (format) {
+    case cryptopals::BytesEncodedFormat::BASE64:
+      return 4;
+    case cryptopals::BytesEncodedFormat::HEX:
+      return 2;
+    default:
+      return 1;
+  }
+}
+
+// Returns the largest number of bytes that `size` chars decode to in `format`.
+size_t MaxDecodedSize(size_t size, cryptopals::BytesEncodedFormat format) {
+  switch (format) {
+    case cryptopals::BytesEncodedFormat::BASE64:
+      return cryptopals::util::Base64DecodedMaxSize(size);
+    case cryptopals::BytesEncodedFormat::HEX:
+      return cryptopals::util::HexDecodedSize(size);
+    default:
+      return size;
+  }
+}
+
+// Returns the end of the chunk of `input` that starts at `begin`. The chunk
+// holds `chunk_chars` chars, and more if needed to hold whole groups of
+// `group_chars` chars that are not whitespace, so that it decodes on its own.
+size_t ChunkEnd(std::string_view input, size_t begin, size_t chunk_chars,
+                size_t group_chars) {
+  size_t end = std::min(input.size(), begin + chunk_chars);
+  if (group_chars == 1) {
+    return end;
+  }
+  size_t num_chars = std::count_if(input.begin() + begin, input.begin() + end,
+                                   [](char c) { return !absl::ascii_isspace(c); });
+  while (num_chars % group_chars != 0 && end < input.size()) {
+    if (!absl::ascii_isspace(input[end])) {
+      ++num_chars;
+    }
+    ++end;
+  }
+  return end;
+}
+
+// Encodes bytes in a format as they arrive. Base64 is encoded three bytes at a
+// time, so bytes that do not fill a group wait for the next ones, and only the
+// last group is padded.
+class ChunkEncoder {
+ public:
+  ChunkEncoder(cryptopals::BytesEncodedFormat format, std::ostream& output)
+      : format_(format), output_(output) {}
+
+  void Write(std::span<const uint8_t> bytes) {
+    if (format_ == cryptopals::BytesEncodedFormat::BASE64) {
+      const size_t num_taken =
+          std::min(bytes.size(), (3 - pending_.size()) % 3);
+      pending_.insert(pending_.end(), bytes.begin(),
+                      bytes.begin() + num_taken);
+      bytes = bytes.subspan(num_taken);
+      if (pending_.size() == 3) {
+        Encode(pending_);
+        pending_.clear();
+      }
+      const size_t num_whole = bytes.size() - bytes.size() % 3;
+      pending_.insert(pending_.end(), bytes.begin() + num_whole, bytes.end());
+      bytes = bytes.first(num_whole);
+    }
+    Encode(bytes);
+  }
+
+  // Writes the bytes that are still waiting.
+  void Finish() {
+    Encode(pending_);
+    pending_.clear();
+  }
+
+ private:
+  void Encode(std::span<const uint8_t> bytes) {
+    switch (format_) {
+      case cryptopals::BytesEncodedFormat::BASE64:
+        text_.resize(cryptopals::util::Base64EncodedSize(bytes.size()));
+        cryptopals::util::EncodeBase64(bytes, text_);
+        break;
+      case cryptopals::BytesEncodedFormat::HEX:
+        text_.resize(cryptopals::util::HexEncodedSize(bytes.size()));
+        cryptopals::util::EncodeHex(bytes, text_);
+        break;
+      default:
+        text_.assign(bytes.begin(), bytes.end());
+        break;
+    }
+    output_.write(text_.data(), text_.size());
+  }
+
+  const cryptopals::BytesEncodedFormat format_;
+  std::ostream& output_;
+  std::vector<uint8_t> pending_;
+  std::string text_;
+};
+
+}  // namespace
+
+absl::Status StreamThroughCipher(StreamingCipherInterface& cipher,
+                                 std::string_view input,
+                                 cryptopals::BytesEncodedFormat input_format,
+                                 cryptopals::BytesEncodedFormat output_format,
+                                 std::ostream& output, size_t chunk_chars) {
+  if (output_format != cryptopals::BytesEncodedFormat::BASE64 &&
+      output_format != cryptopals::BytesEncodedFormat::HEX &&
+      output_format != cryptopals::BytesEncodedFormat::RAW) {
+    return absl::InvalidArgumentErrorBuilder()
+           << "Unsupported bytes format: "
+           << cryptopals::BytesEncodedFormat_Name(output_format);
+  }
+  chunk_chars = std::max<size_t>(chunk_chars, 1);
+  const size_t group_chars = DecodeGroupChars(input_format);
+
+  ChunkEncoder encoder(output_format, output);
+  std::vector<uint8_t> decoded;
+  std::vector<uint8_t> processed;
+  size_t begin = 0;
+  while (begin < input.size()) {
+    const size_t end = ChunkEnd(input, begin, chunk_chars, group_chars);
+    const std::string_view chunk = input.substr(begin, end - begin);
+    begin = end;
+
+    decoded.resize(MaxDecodedSize(chunk.size(), input_format));
+    ASSIGN_OR_RETURN(const size_t decoded_size,
+                     Bytes::DecodeFromFormat(chunk, input_format, decoded));
+    processed.resize(cipher.MaxUpdateOutputSize(decoded_size));
+    ASSIGN_OR_RETURN(
+        const size_t processed_size,
+        cipher.Update(std::span<const uint8_t>(decoded).first(decoded_size),
+                      processed));
+    encoder.Write(std::span<const uint8_t>(processed).first(processed_size));
+  }
+
+  processed.resize(cipher.MaxFinalizeOutputSize());
+  ASSIGN_OR_RETURN(const size_t processed_size, cipher.Finalize(processed));
+  encoder.Write(std::span<const uint8_t>(processed).first(processed_size));
+  encoder.Finish();
+  return absl::OkStatus();
+}
+
+}  // namespace cryptopals::cipher
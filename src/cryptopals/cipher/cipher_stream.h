@@ -0,0 +1,29 @@
+#ifndef CRYPTOPALS_CIPHER_CIPHER_STREAM_H_
+#define CRYPTOPALS_CIPHER_CIPHER_STREAM_H_
+
+#include <cstddef>
+#include <ostream>
+#include <string_view>
+
+#include "absl/status/status.h"
+#include "cryptopals/cipher/streaming_cipher.h"
+#include "cryptopals/proto/cryptopals_enums.pb.h"
+
+namespace cryptopals::cipher {
+
+// Passes `input`, encoded in `input_format`, through `cipher` and finalizes it,
+// writing the output to `output` encoded in `output_format`. The input is
+// decoded, processed and encoded about `chunk_chars` chars at a time, so memory
+// use does not depend on the size of `input`. Input is decoded as
+// cryptopals::util::Bytes::DecodeFromFormat() does. Output written before an
+// error is not taken back.
+absl::Status StreamThroughCipher(StreamingCipherInterface& cipher,
+                                 std::string_view input,
+                                 cryptopals::BytesEncodedFormat input_format,
+                                 cryptopals::BytesEncodedFormat output_format,
+                                 std::ostream& output,
+                                 size_t chunk_chars = 1 << 16);
+
+}  // namespace cryptopals::cipher
+
+#endif  // CRYPTOPALS_CIPHER_CIPHER_STREAM_H_
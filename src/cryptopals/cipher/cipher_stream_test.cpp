@@ -0,0 +1,110 @@
+#include "cryptopals/cipher/cipher_stream.h"
+
+#include <sstream>
+#include <string>
+
+#include "absl/status/status.h"
+#include "absl/status/status_macros.h"
+#include "absl/status/statusor.h"
+#include "cryptopals/cipher/aes_ecb.h"
+#include "cryptopals/cipher/aes_stream_cipher.h"
+#include "cryptopals/proto/cryptopals_enums.pb.h"
+#include "cryptopals/util/aes.h"
+#include "cryptopals/util/bytes.h"
+#include "googletest/status_matchers.h"
+#include "gtest/gtest.h"
+
+namespace cryptopals::cipher {
+namespace {
+
+using cryptopals::util::AesKeySchedule;
+using cryptopals::util::Bytes;
+
+constexpr char KEY[] = "YELLOW SUBMARINE";
+
+// A message of ten AES blocks.
+std::string TestMessage() {
+  std::string message;
+  for (size_t i = 0; i < 160; ++i) {
+    message.push_back(static_cast<char>(i * 37 % 251));
+  }
+  return message;
+}
+
+// Inserts a newline after every `line_chars` chars of `text`.
+std::string WrapLines(const std::string& text, size_t line_chars) {
+  std::string wrapped;
+  for (size_t i = 0; i < text.size(); i += line_chars) {
+    wrapped += text.substr(i, line_chars) + "\n";
+  }
+  return wrapped;
+}
+
+absl::StatusOr<AesStreamCipher> CreateEcbCipher(
+    cryptopals::CipherAction action) {
+  ASSIGN_OR_RETURN(AesKeySchedule key_schedule,
+                   AesKeySchedule::Create(Bytes::CreateFromRaw(KEY)));
+  return AesStreamCipher::Create(action, cryptopals::AesMode::ECB,
+                                 key_schedule, Bytes(),
+                                 {.pkcs7_padding = false});
+}
+
+TEST(CipherStreamTest, MatchesWholeMessage) {
+  const std::string message = TestMessage();
+  ASSERT_OK_AND_ASSIGN(AesKeySchedule key_schedule,
+                       AesKeySchedule::Create(Bytes::CreateFromRaw(KEY)));
+  const Bytes ciphertext =
+      AesEcb().Encrypt(Bytes::CreateFromRaw(message), key_schedule);
+
+  for (cryptopals::BytesEncodedFormat format :
+       {cryptopals::BytesEncodedFormat::BASE64,
+        cryptopals::BytesEncodedFormat::HEX,
+        cryptopals::BytesEncodedFormat::RAW}) {
+    const std::string encoded = ciphertext.ToFormat(format);
+    for (size_t chunk_chars : {1, 5, 64, 1 << 16}) {
+      ASSERT_OK_AND_ASSIGN(AesStreamCipher encrypter,
+                           CreateEcbCipher(cryptopals::CipherAction::ENCRYPT));
+      std::ostringstream encrypted;
+      ASSERT_OK(StreamThroughCipher(encrypter, message,
+                                    cryptopals::BytesEncodedFormat::RAW,
+                                    format, encrypted, chunk_chars));
+      EXPECT_EQ(encrypted.str(), encoded) << format << " " << chunk_chars;
+
+      // Chunks of encoded input end on whole groups even when whitespace
+      // splits them.
+      ASSERT_OK_AND_ASSIGN(AesStreamCipher decrypter,
+                           CreateEcbCipher(cryptopals::CipherAction::DECRYPT));
+      std::ostringstream decrypted;
+      const std::string input =
+          format == cryptopals::BytesEncodedFormat::RAW ? encoded
+                                                        : WrapLines(encoded, 7);
+      ASSERT_OK(StreamThroughCipher(decrypter, input, format,
+                                    cryptopals::BytesEncodedFormat::RAW,
+                                    decrypted, chunk_chars));
+      EXPECT_EQ(decrypted.str(), message) << format << " " << chunk_chars;
+    }
+  }
+}
+
+TEST(CipherStreamTest, ReportsErrors) {
+  ASSERT_OK_AND_ASSIGN(AesStreamCipher malformed_decrypter,
+                       CreateEcbCipher(cryptopals::CipherAction::DECRYPT));
+  std::ostringstream output;
+  EXPECT_EQ(StreamThroughCipher(malformed_decrypter, "0011zz",
+                                cryptopals::BytesEncodedFormat::HEX,
+                                cryptopals::BytesEncodedFormat::RAW, output)
+                .code(),
+            absl::StatusCode::kInvalidArgument);
+
+  // Without padding, the message has to fill whole blocks.
+  ASSERT_OK_AND_ASSIGN(AesStreamCipher encrypter,
+                       CreateEcbCipher(cryptopals::CipherAction::ENCRYPT));
+  EXPECT_EQ(StreamThroughCipher(encrypter, "too short",
+                                cryptopals::BytesEncodedFormat::RAW,
+                                cryptopals::BytesEncodedFormat::HEX, output)
+                .code(),
+            absl::StatusCode::kInvalidArgument);
+}
+
+}  // namespace
+}  // namespace cryptopals::cipher
@@ -1,120 +1,156 @@
 #include "cryptopals/cipher/repeating_key_xor.h"
 
+#include <algorithm>
 #include <limits>
-#include <numeric>
 #include <vector>
 
+#include "absl/memory/memory.h"
 #include "cryptopals/analysis/data/oanc_english.h"
 #include "cryptopals/analysis/frequency_analyzer.h"
-#include "cryptopals/analysis/hamming_distance_analyzer.h"
+#include "cryptopals/analysis/keysize_estimator.h"
 #include "cryptopals/cipher/decryption_result.h"
 #include "cryptopals/cipher/single_byte_xor.h"
 #include "cryptopals/encoding/ascii.h"
-#include "cryptopals/util/bytes_util.h"
+#include "cryptopals/util/byte_histogram.h"
 #include "cryptopals/util/logging.h"
+#include "cryptopals/util/thread_pool.h"
 
 namespace cryptopals::cipher {
 namespace {
 
+using cryptopals::analysis::KeysizeEstimator;
+using cryptopals::analysis::KeysizeScore;
+using cryptopals::util::AddStridedByteCounts;
+using cryptopals::util::ByteHistogram;
 using cryptopals::util::Bytes;
+using cryptopals::util::BytesView;
+using cryptopals::util::ParallelFor;
+using cryptopals::util::ParallelReduce;
 
-// The maximum length of a key to try to decode using repeating key xor.
+// Keys shorter than this limit, and shorter than half of the ciphertext, are
+// tried when decoding repeating key xor.
 constexpr size_t CONFIG_KEYSIZE_LIMIT = 40;
 
 // The number of key sizes to attempt to decrypt with.
 constexpr size_t CONFIG_KEYSIZE_ATTEMPTS = 4;
 
-struct KeysizeResult {
-  double score;
-  size_t size;
-};
+// The smallest number of bytes counted by a single task.
+constexpr size_t PARALLEL_MIN_BYTES = 1 << 16;
+
+// Returns the histogram of each column of `ciphertext` laid out in rows of
+// `keysize` bytes. Large inputs are counted in chunks of whole rows
+// concurrently, and the counts of the chunks are merged.
+std::vector<ByteHistogram> CountColumns(BytesView ciphertext, size_t keysize) {
+  return ParallelReduce(
+      (ciphertext.size() + keysize - 1) / keysize,
+      PARALLEL_MIN_BYTES / keysize + 1,
+      std::vector<ByteHistogram>(keysize, ByteHistogram{}),
+      [&](size_t begin_row, size_t end_row) {
+        const size_t begin = begin_row * keysize;
+        const size_t end = std::min(end_row * keysize, ciphertext.size());
+        std::vector<ByteHistogram> chunk_histograms(keysize, ByteHistogram{});
+        AddStridedByteCounts(ciphertext.subview(begin, end - begin),
+                             chunk_histograms);
+        return chunk_histograms;
+      },
+      [](std::vector<ByteHistogram> column_histograms,
+         std::vector<ByteHistogram> chunk_histograms) {
+        for (size_t column = 0; column < column_histograms.size(); ++column) {
+          for (size_t value = 0; value < chunk_histograms[column].size();
+               ++value) {
+            column_histograms[column][value] += chunk_histograms[column][value];
+          }
+        }
+        return column_histograms;
+      });
+}
 
 // Determines the likely keysize for `ciphertext`, assuming that it was
 // encrypted with repeating key xor.
-std::vector<KeysizeResult> CrackKeysize(const Bytes& ciphertext) {
-  std::vector<KeysizeResult> results;
-  cryptopals::analysis::HammingDistanceAnalyzer hamming_distance_analyzer;
-  for (size_t i = 2; i < ciphertext.size() / 2 && i < CONFIG_KEYSIZE_LIMIT;
-       ++i) {
-    std::vector<Bytes> split_ciphertext = SplitBytes(ciphertext, i);
-    std::vector<double> scores;
-
-    // Determine the hamming distance for all pairwise segments of the text.
-    for (auto c1 = split_ciphertext.begin(); c1 != split_ciphertext.end();
-         ++c1) {
-      for (auto c2 = c1 + 1; c2 != split_ciphertext.end(); ++c2) {
-        scores.push_back(hamming_distance_analyzer.CompareBytes(*c1, *c2));
-      }
-    }
-
-    // The score is the average hamming distance of each pair of segments
-    // normalized by the length of the segments.
-    double score = std::accumulate(scores.begin(), scores.end(), /*init=*/0.0) /
-                   scores.size() / i;
-    results.push_back({.score = score, .size = i});
-  }
+std::vector<KeysizeScore> CrackKeysize(BytesView ciphertext) {
+  static const KeysizeEstimator* const keysize_estimator =
+      new KeysizeEstimator(
+          KeysizeEstimator::Create({.max_keysize = CONFIG_KEYSIZE_LIMIT - 1})
+              .value());
+  std::vector<KeysizeScore> results = keysize_estimator->Estimate(ciphertext);
+  // The estimator also scores half of the ciphertext size, which leaves
+  // exactly two blocks. Skip it, so that both bounds stay exclusive.
+  std::erase_if(results, [&](const KeysizeScore& result) {
+    return result.keysize >= ciphertext.size() / 2;
+  });
 
   // Return the most likely results.
-  std::sort(results.begin(), results.end(),
-            [](auto lhs, auto rhs) { return lhs.score < rhs.score; });
-  results.resize(CONFIG_KEYSIZE_ATTEMPTS);
-
+  results.resize(std::min(results.size(), CONFIG_KEYSIZE_ATTEMPTS));
   return results;
 }
 
 }  // namespace
 
-Bytes RepeatingKeyXor::Encrypt(const Bytes& plaintext, const Bytes& key) const {
-  return plaintext ^ key;
+Bytes RepeatingKeyXor::Encrypt(BytesView plaintext, const Bytes& key) const {
+  return plaintext.ToBytes() ^ key;
 }
 
-Bytes RepeatingKeyXor::Decrypt(const Bytes& ciphertext,
+Bytes RepeatingKeyXor::Decrypt(BytesView ciphertext,
                                const Bytes& key) const {
-  return ciphertext ^ key;
+  return ciphertext.ToBytes() ^ key;
 }
 
 RepeatingKeyXor::DecryptionResultType RepeatingKeyXor::Crack(
-    const Bytes& ciphertext) {
-  LOG(INFO) << "Cracking: " << ciphertext.ToHex();
+    BytesView ciphertext) {
+  LOG(INFO) << "Cracking " << ciphertext.size() << " bytes";
 
   DecryptionResultType decryption_result = {
       .score = std::numeric_limits<double>::max()};
 
-  SingleByteXor single_byte_xor;
   using cryptopals::analysis::data::oanc_english::code_point_frequency;
   cryptopals::analysis::FrequencyAnalyzer<uint8_t> frequency_analyzer(
       absl::make_unique<cryptopals::encoding::AsciiEncoding>(),
       code_point_frequency.begin(), code_point_frequency.end());
 
-  std::vector<KeysizeResult> possible_keysizes = CrackKeysize(ciphertext);
-  for (const KeysizeResult keysize_result : possible_keysizes) {
-    LOG(INFO) << "Attempting to crack key length = " << keysize_result.size
+  std::vector<KeysizeScore> possible_keysizes = CrackKeysize(ciphertext);
+  for (const KeysizeScore keysize_result : possible_keysizes) {
+    LOG(INFO) << "Attempting to crack key length = " << keysize_result.keysize
               << " (score = " << keysize_result.score << ")";
 
-    std::vector<Bytes> split_ciphertext =
-        SplitAndTransposeBytes(ciphertext, keysize_result.size);
-    std::vector<Bytes> split_plaintext;
-    Bytes possible_key;
-
-    for (const Bytes& single_byte_ciphertext : split_ciphertext) {
-      SingleByteXor::DecryptionResultType partial_decryption_result =
-          single_byte_xor.Crack(single_byte_ciphertext);
-      split_plaintext.push_back(partial_decryption_result.decrypted_text);
-      possible_key.push_back(partial_decryption_result.key);
+    // Each byte of the key encrypts one column of the ciphertext, so each one
+    // is cracked from the histogram of its column alone.
+    const size_t keysize = keysize_result.keysize;
+    const std::vector<ByteHistogram> column_histograms =
+        CountColumns(ciphertext, keysize);
+    std::vector<uint8_t> possible_key(keysize);
+    ParallelFor(keysize, /*min_items_per_task=*/1, [&](size_t begin,
+                                                       size_t end) {
+      for (size_t column = begin; column < end; ++column) {
+        possible_key[column] =
+            SingleByteXor::RankKeys(column_histograms[column], 1).front().key;
+      }
+    });
+
+    // The histogram of the decrypted text is the sum of the column histograms,
+    // each permuted by its byte of the key.
+    ByteHistogram decrypted_histogram = {};
+    for (size_t column = 0; column < keysize; ++column) {
+      for (size_t value = 0; value < decrypted_histogram.size(); ++value) {
+        decrypted_histogram[value ^ possible_key[column]] +=
+            column_histograms[column][value];
+      }
     }
-
-    Bytes decrypted_text = JoinAndTransposeBytes(split_plaintext);
-    double score = frequency_analyzer.AnalyzeBytes(decrypted_text);
+    double score = frequency_analyzer.AnalyzeHistogram(decrypted_histogram);
 
     LOG(INFO) << "Decrypted text score = " << score;
 
     if (score < decryption_result.score) {
-      decryption_result = {.score = score,
-                           .decrypted_text = decrypted_text,
-                           .key = possible_key};
+      decryption_result = {
+          .score = score,
+          .key = Bytes(possible_key.begin(), possible_key.end())};
     }
   }
 
+  // Only the best candidate is decrypted.
+  if (decryption_result.key.size() != 0) {
+    decryption_result.decrypted_text =
+        Decrypt(ciphertext, decryption_result.key);
+  }
   return decryption_result;
 }
 
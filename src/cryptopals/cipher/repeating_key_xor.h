@@ -3,6 +3,7 @@
 
 #include "cryptopals/cipher/symmetric_cipher.h"
 #include "cryptopals/util/bytes.h"
+#include "cryptopals/util/bytes_view.h"
 
 namespace cryptopals::cipher {
 
@@ -11,16 +12,16 @@ class RepeatingKeyXor
  public:
   // Implements Encrypt from CipherInterface.
   cryptopals::util::Bytes Encrypt(
-      const cryptopals::util::Bytes& plaintext,
+      cryptopals::util::BytesView plaintext,
       const cryptopals::util::Bytes& key) const override;
 
   // Implements Decrypt from CipherInterface.
-  cryptopals::util::Bytes Decrypt(const cryptopals::util::Bytes& ciphertext,
+  cryptopals::util::Bytes Decrypt(cryptopals::util::BytesView ciphertext,
                                   const cryptopals::util::Bytes& key) const;
 
   // Cracks the cipher and returns the most likely decryption result for
   // `ciphertext`.
-  DecryptionResultType Crack(const cryptopals::util::Bytes& ciphertext);
+  DecryptionResultType Crack(cryptopals::util::BytesView ciphertext);
 };
 
 }  // namespace cryptopals::cipher
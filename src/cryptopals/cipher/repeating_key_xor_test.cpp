@@ -31,4 +31,30 @@ TEST(RepeatingKeyXorTest, EncryptDecryptTest) {
       test_inout_1);
 }
 
+TEST(RepeatingKeyXorTest, CrackTest) {
+  Bytes plaintext = Bytes::CreateFromRaw(
+      "I'm back and I'm ringin' the bell\n"
+      "A rockin' on the mike while the fly girls yell\n"
+      "In ecstasy in the back of me\n"
+      "Well that's my DJ Deshay cuttin' all them Z's\n"
+      "Hittin' hard and the girlies goin' crazy\n"
+      "Vanilla's on the mike, man I'm not lazy.\n"
+      "I'm lettin' my drug kick in\n"
+      "It controls my mouth and I begin\n"
+      "To just let it flow, let my concepts go\n"
+      "My posse's to the side yellin', Go Vanilla Go!\n"
+      "Smooth 'cause that's the way I will be\n"
+      "And if you don't give a damn, then\n"
+      "Why you starin' at me\n"
+      "So get off 'cause I control the stage\n"
+      "There's no dissin' allowed\n");
+  Bytes key = Bytes::CreateFromRaw("Terminator X");
+
+  RepeatingKeyXor repeating_key_xor;
+  RepeatingKeyXor::DecryptionResultType decryption_result =
+      repeating_key_xor.Crack(repeating_key_xor.Encrypt(plaintext, key));
+  EXPECT_EQ(decryption_result.key, key);
+  EXPECT_EQ(decryption_result.decrypted_text, plaintext);
+}
+
 }  // namespace cryptopals::cipher
@@ -1,48 +1,119 @@
 #include "cryptopals/cipher/single_byte_xor.h"
 
-#include <limits>
+#include <algorithm>
+#include <array>
+#include <tuple>
+#include <vector>
 
+#include "absl/memory/memory.h"
 #include "cryptopals/analysis/data/oanc_english.h"
 #include "cryptopals/analysis/frequency_analyzer.h"
 #include "cryptopals/cipher/decryption_result.h"
 #include "cryptopals/encoding/ascii.h"
+#include "cryptopals/util/byte_histogram.h"
+#include "cryptopals/util/thread_pool.h"
 
 namespace cryptopals::cipher {
+namespace {
+
+using cryptopals::analysis::FrequencyAnalyzer;
+using cryptopals::util::ByteHistogram;
+
+// The number of possible single-byte keys.
+constexpr size_t NUM_KEYS = FrequencyAnalyzer<uint8_t>::NUM_CODE_POINTS;
+
+// The smallest number of bytes counted by a single task.
+constexpr size_t PARALLEL_MIN_BYTES = 1 << 16;
+
+// Returns the histogram of `ciphertext`. Large inputs are counted in chunks
+// concurrently, and the counts of the chunks are added up.
+ByteHistogram CountBytes(cryptopals::util::BytesView ciphertext) {
+  return cryptopals::util::ParallelReduce(
+      ciphertext.size(), PARALLEL_MIN_BYTES, ByteHistogram{},
+      [&](size_t begin, size_t end) {
+        ByteHistogram histogram{};
+        cryptopals::util::AddByteCounts(ciphertext.subview(begin, end - begin),
+                                        histogram);
+        return histogram;
+      },
+      [](ByteHistogram histogram, ByteHistogram chunk_histogram) {
+        for (size_t value = 0; value < histogram.size(); ++value) {
+          histogram[value] += chunk_histogram[value];
+        }
+        return histogram;
+      });
+}
+
+// Returns an analyzer for English text, built once.
+const FrequencyAnalyzer<uint8_t>& EnglishAnalyzer() {
+  using cryptopals::analysis::data::oanc_english::code_point_frequency;
+  static const FrequencyAnalyzer<uint8_t>* const analyzer =
+      new FrequencyAnalyzer<uint8_t>(
+          absl::make_unique<cryptopals::encoding::AsciiEncoding>(),
+          code_point_frequency.begin(), code_point_frequency.end());
+  return *analyzer;
+}
+
+}  // namespace
 
 using cryptopals::util::Bytes;
+using cryptopals::util::BytesView;
 
-Bytes SingleByteXor::Encrypt(const Bytes& plaintext, const uint8_t key) const {
-  return plaintext ^ Bytes::CreateFromIntegral(key);
+Bytes SingleByteXor::Encrypt(BytesView plaintext, const uint8_t key) const {
+  return plaintext.ToBytes() ^ Bytes::CreateFromIntegral(key);
 }
 
-Bytes SingleByteXor::Decrypt(const Bytes& ciphertext, const uint8_t key) const {
-  return ciphertext ^ Bytes::CreateFromIntegral(key);
+Bytes SingleByteXor::Decrypt(BytesView ciphertext, const uint8_t key) const {
+  return ciphertext.ToBytes() ^ Bytes::CreateFromIntegral(key);
 }
 
 SingleByteXor::DecryptionResultType SingleByteXor::Crack(
-    const Bytes& ciphertext) {
-  // Use frequency analysis to determine the most likely decryption.
-  using cryptopals::analysis::data::oanc_english::code_point_frequency;
+    BytesView ciphertext) {
+  return Crack(ciphertext, /*num_results=*/1).front();
+}
+
+std::vector<SingleByteXor::DecryptionResultType> SingleByteXor::Crack(
+    BytesView ciphertext, size_t num_results) {
+  std::vector<KeyScore> key_scores =
+      RankKeys(CountBytes(ciphertext), num_results);
+
+  std::vector<DecryptionResultType> decryption_results;
+  decryption_results.reserve(key_scores.size());
+  for (const KeyScore& key_score : key_scores) {
+    decryption_results.push_back(
+        {.score = key_score.score,
+         .decrypted_text = Decrypt(ciphertext, key_score.key),
+         .key = key_score.key});
+  }
+  return decryption_results;
+}
+
+std::vector<SingleByteXor::KeyScore> SingleByteXor::RankKeys(
+    const cryptopals::util::ByteHistogram& histogram, size_t num_results) {
+  if (num_results == 0) {
+    return {};
+  }
+
+  // Use frequency analysis to determine the most likely keys. Every key only
+  // permutes the byte values of the ciphertext, so each one is scored by
+  // permuting the histogram of the ciphertext.
+  std::array<double, NUM_KEYS> scores;
+  EnglishAnalyzer().AnalyzeHistogramXorMasks(histogram, scores);
 
-  DecryptionResultType decryption_result = {
-      .score = std::numeric_limits<double>::max()};
-
-  cryptopals::analysis::FrequencyAnalyzer<uint8_t> frequency_analyzer(
-      absl::make_unique<cryptopals::encoding::AsciiEncoding>(),
-      code_point_frequency.begin(), code_point_frequency.end());
-
-  for (uint8_t possible_key = 0;
-       possible_key < std::numeric_limits<uint8_t>::max(); ++possible_key) {
-    Bytes decrypted_text = Decrypt(ciphertext, possible_key);
-    double score = frequency_analyzer.AnalyzeBytes(decrypted_text);
-    if (score < decryption_result.score) {
-      decryption_result = {.score = score,
-                           .decrypted_text = decrypted_text,
-                           .key = possible_key};
-    }
+  std::vector<KeyScore> key_scores(NUM_KEYS);
+  for (size_t key = 0; key < NUM_KEYS; ++key) {
+    key_scores[key] = {.score = scores[key], .key = static_cast<uint8_t>(key)};
   }
 
-  return decryption_result;
+  num_results = std::min(num_results, NUM_KEYS);
+  std::partial_sort(key_scores.begin(), key_scores.begin() + num_results,
+                    key_scores.end(),
+                    [](const KeyScore& lhs, const KeyScore& rhs) {
+                      return std::tie(lhs.score, lhs.key) <
+                             std::tie(rhs.score, rhs.key);
+                    });
+  key_scores.resize(num_results);
+  return key_scores;
 }
 
 }  // namespace cryptopals::cipher
@@ -1,26 +1,50 @@
 #ifndef CRYPTOPALS_CIPHER_SINGLE_BYTE_XOR_H_
 #define CRYPTOPALS_CIPHER_SINGLE_BYTE_XOR_H_
 
+#include <cstddef>
 #include <cstdint>
+#include <vector>
 
 #include "cryptopals/cipher/symmetric_cipher.h"
+#include "cryptopals/util/byte_histogram.h"
 #include "cryptopals/util/bytes.h"
+#include "cryptopals/util/bytes_view.h"
 
 namespace cryptopals::cipher {
 
 class SingleByteXor : public SymmetricCipherInterface<uint8_t> {
  public:
+  // A key and the score of the decryption it gives. Lower scores are more
+  // likely.
+  struct KeyScore {
+    double score;
+    uint8_t key;
+  };
+
   // Implements Encrypt from CipherInterface.
-  cryptopals::util::Bytes Encrypt(const cryptopals::util::Bytes& plaintext,
+  cryptopals::util::Bytes Encrypt(cryptopals::util::BytesView plaintext,
                                   const uint8_t key) const override;
 
   // Implements Decrypt from CipherInterface.
-  cryptopals::util::Bytes Decrypt(const cryptopals::util::Bytes& ciphertext,
+  cryptopals::util::Bytes Decrypt(cryptopals::util::BytesView ciphertext,
                                   const uint8_t key) const override;
 
   // Cracks the cipher and returns the most likely decryption result for
   // `ciphertext`.
-  DecryptionResultType Crack(const cryptopals::util::Bytes& ciphertext);
+  DecryptionResultType Crack(cryptopals::util::BytesView ciphertext);
+
+  // Returns the `num_results` most likely decryption results for `ciphertext`,
+  // best first, or every key if there are fewer. All 256 keys are scored from
+  // a single histogram of `ciphertext`, and only the returned results are
+  // decrypted.
+  std::vector<DecryptionResultType> Crack(
+      cryptopals::util::BytesView ciphertext, size_t num_results);
+
+  // Returns the `num_results` most likely keys for a ciphertext whose bytes
+  // are counted in `histogram`, best first, without decrypting anything. Ties
+  // go to the lower key.
+  static std::vector<KeyScore> RankKeys(
+      const cryptopals::util::ByteHistogram& histogram, size_t num_results);
 };
 
 }  // namespace cryptopals::cipher
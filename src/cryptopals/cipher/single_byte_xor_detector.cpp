@@ -0,0 +1,149 @@
+#include "cryptopals/cipher/single_byte_xor_detector.h"
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <utility>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/status/status.h"
+#include "absl/status/status_macros.h"
+#include "absl/synchronization/mutex.h"
+#include "cryptopals/util/bytes.h"
+
+namespace cryptopals::cipher {
+namespace {
+
+using cryptopals::util::Bytes;
+using Detection = SingleByteXorDetector::Detection;
+
+// The smallest number of candidates cracked by a single task. Cracking one
+// candidate takes tens of microseconds, so even small batches are worth
+// spreading out.
+constexpr size_t PARALLEL_MIN_CANDIDATES = 16;
+
+// Orders detections from best to worst.
+bool IsBetter(const Detection& lhs, const Detection& rhs) {
+  return std::tie(lhs.decryption_result.score, lhs.index) <
+         std::tie(rhs.decryption_result.score, rhs.index);
+}
+
+}  // namespace
+
+// The best detections found so far. Candidates that cannot beat the worst kept
+// detection are turned away without taking the lock.
+class SingleByteXorDetector::TopDetections {
+ public:
+  explicit TopDetections(size_t max_results) : max_results_(max_results) {
+    detections_.reserve(max_results);
+  }
+
+  // Returns whether a candidate with `score` could enter the best results.
+  bool MightAccept(double score) const {
+    return score <= worst_score_.load(std::memory_order_relaxed);
+  }
+
+  // Adds `detection` if it is among the best results, calling `on_detection`
+  // with it under the lock.
+  void Offer(Detection detection,
+             absl::FunctionRef<void(const Detection&)> on_detection) {
+    absl::MutexLock lock(&mutex_);
+    // `detections_` is a heap with the worst detection at the front.
+    if (detections_.size() == max_results_) {
+      if (!IsBetter(detection, detections_.front())) {
+        return;
+      }
+      std::pop_heap(detections_.begin(), detections_.end(), IsBetter);
+      detections_.pop_back();
+    }
+    on_detection(detection);
+    detections_.push_back(std::move(detection));
+    std::push_heap(detections_.begin(), detections_.end(), IsBetter);
+    if (detections_.size() == max_results_) {
+      worst_score_.store(detections_.front().decryption_result.score,
+                         std::memory_order_relaxed);
+    }
+  }
+
+  // Returns the best detections, best first.
+  std::vector<Detection> Sorted() const {
+    absl::MutexLock lock(&mutex_);
+    std::vector<Detection> detections = detections_;
+    std::sort_heap(detections.begin(), detections.end(), IsBetter);
+    return detections;
+  }
+
+ private:
+  const size_t max_results_;
+  std::atomic<double> worst_score_ = std::numeric_limits<double>::infinity();
+  mutable absl::Mutex mutex_;
+  std::vector<Detection> detections_ ABSL_GUARDED_BY(mutex_);
+};
+
+SingleByteXorDetector::SingleByteXorDetector(
+    size_t max_results, cryptopals::util::ThreadPool& pool)
+    : pool_(pool),
+      top_detections_(
+          std::make_unique<TopDetections>(std::max<size_t>(max_results, 1))) {}
+
+SingleByteXorDetector::~SingleByteXorDetector() = default;
+
+absl::Status SingleByteXorDetector::Add(
+    std::span<const std::string_view> encoded_candidates,
+    cryptopals::BytesEncodedFormat format,
+    absl::FunctionRef<void(const Detection&)> on_detection) {
+  const size_t first_index = num_candidates_;
+  TopDetections& top_detections = *top_detections_;
+
+  absl::Mutex error_mutex;
+  size_t error_index = encoded_candidates.size();
+  absl::Status error;
+
+  cryptopals::util::ParallelFor(
+      encoded_candidates.size(), PARALLEL_MIN_CANDIDATES,
+      [&](size_t begin, size_t end) {
+        SingleByteXor single_byte_xor;
+        for (size_t i = begin; i < end; ++i) {
+          absl::StatusOr<Bytes> ciphertext =
+              Bytes::DecodeFromFormat(encoded_candidates[i], format);
+          if (!ciphertext.ok()) {
+            absl::MutexLock lock(&error_mutex);
+            if (i < error_index) {
+              error_index = i;
+              error = std::move(ciphertext).status();
+            }
+            return;
+          }
+
+          SingleByteXor::DecryptionResultType decryption_result =
+              single_byte_xor.Crack(ciphertext.value());
+          if (top_detections.MightAccept(decryption_result.score)) {
+            top_detections.Offer({.index = first_index + i,
+                                  .decryption_result =
+                                      std::move(decryption_result)},
+                                 on_detection);
+          }
+        }
+      },
+      pool_);
+
+  num_candidates_ += encoded_candidates.size();
+  return error;
+}
+
+std::vector<Detection> SingleByteXorDetector::results() const {
+  return top_detections_->Sorted();
+}
+
+absl::StatusOr<std::vector<Detection>> SingleByteXorDetector::Detect(
+    std::span<const std::string_view> encoded_candidates,
+    cryptopals::BytesEncodedFormat format,
+    absl::FunctionRef<void(const Detection&)> on_detection) {
+  RETURN_IF_ERROR(Add(encoded_candidates, format, on_detection));
+  return results();
+}
+
+}  // namespace cryptopals::cipher
@@ -0,0 +1,75 @@
+#ifndef CRYPTOPALS_CIPHER_SINGLE_BYTE_XOR_DETECTOR_H_
+#define CRYPTOPALS_CIPHER_SINGLE_BYTE_XOR_DETECTOR_H_
+
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "absl/functional/function_ref.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "cryptopals/cipher/single_byte_xor.h"
+#include "cryptopals/proto/cryptopals_enums.pb.h"
+#include "cryptopals/util/thread_pool.h"
+
+namespace cryptopals::cipher {
+
+// Finds the candidates among many ciphertexts that are most likely to be text
+// encrypted with single-byte XOR. Every candidate is cracked, and the best
+// results are kept in a bounded heap shared by all threads. Candidates can be
+// added in batches as they arrive, so memory use is bounded by the largest
+// batch rather than the number of candidates.
+class SingleByteXorDetector {
+ public:
+  struct Detection {
+    // The position of the candidate among all candidates.
+    size_t index;
+
+    // The best decryption of the candidate.
+    SingleByteXor::DecryptionResultType decryption_result;
+  };
+
+  // Keeps the `max_results` best detections, cracking candidates on `pool`.
+  explicit SingleByteXorDetector(
+      size_t max_results,
+      cryptopals::util::ThreadPool& pool =
+          cryptopals::util::ThreadPool::Default());
+
+  ~SingleByteXorDetector();
+
+  // Decodes every candidate in `encoded_candidates` from `format`, cracks it,
+  // and keeps the best detections. Candidates are numbered after those of
+  // earlier calls. Ties go to the candidate that comes first. `on_detection`
+  // is called with every detection that enters the running best results as
+  // soon as it is found; calls are serialized, but come from any thread.
+  // Returns the decoding error of the first malformed candidate, if any, in
+  // which case only some of `encoded_candidates` may have been added.
+  absl::Status Add(std::span<const std::string_view> encoded_candidates,
+                   cryptopals::BytesEncodedFormat format,
+                   absl::FunctionRef<void(const Detection&)> on_detection =
+                       [](const Detection&) {});
+
+  // Returns the best detections among all candidates added so far, best
+  // first.
+  std::vector<Detection> results() const;
+
+  // Adds `encoded_candidates` with Add() and returns results().
+  absl::StatusOr<std::vector<Detection>> Detect(
+      std::span<const std::string_view> encoded_candidates,
+      cryptopals::BytesEncodedFormat format,
+      absl::FunctionRef<void(const Detection&)> on_detection =
+          [](const Detection&) {});
+
+ private:
+  class TopDetections;
+
+  cryptopals::util::ThreadPool& pool_;
+  std::unique_ptr<TopDetections> top_detections_;
+  size_t num_candidates_ = 0;
+};
+
+}  // namespace cryptopals::cipher
+
+#endif  // CRYPTOPALS_CIPHER_SINGLE_BYTE_XOR_DETECTOR_H_
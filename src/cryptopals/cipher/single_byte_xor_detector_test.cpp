@@ -0,0 +1,127 @@
+#include "cryptopals/cipher/single_byte_xor_detector.h"
+
+#include <algorithm>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "googletest/status_matchers.h"
+#include "gtest/gtest.h"
+
+namespace cryptopals::cipher {
+
+using cryptopals::util::Bytes;
+
+// Returns views of `candidates`, which must outlive them.
+std::vector<std::string_view> Views(
+    const std::vector<std::string>& candidates) {
+  return std::vector<std::string_view>(candidates.begin(), candidates.end());
+}
+
+std::vector<std::string> TestCandidates(size_t num_candidates) {
+  std::vector<std::string> candidates;
+  for (size_t i = 0; i < num_candidates; ++i) {
+    Bytes noise = Bytes::CreateFromRaw(std::string(30, '\0'));
+    for (size_t j = 0; j < noise.size(); ++j) {
+      *(noise.begin() + j) = static_cast<uint8_t>((i * 131 + j * 197) ^ j * j);
+    }
+    candidates.push_back(noise.ToHex());
+  }
+  return candidates;
+}
+
+TEST(SingleByteXorDetectorTest, DetectTest) {
+  std::vector<std::string> candidates = TestCandidates(500);
+  SingleByteXor single_byte_xor;
+  Bytes plaintext = Bytes::CreateFromRaw("Now that the party is jumping\n");
+  candidates[321] = single_byte_xor.Encrypt(plaintext, 0x35).ToHex();
+
+  cryptopals::util::ThreadPool pool(3);
+  SingleByteXorDetector detector(/*max_results=*/5, pool);
+  size_t num_callbacks = 0;
+  ASSERT_OK_AND_ASSIGN(
+      std::vector<SingleByteXorDetector::Detection> detections,
+      detector.Detect(Views(candidates), cryptopals::BytesEncodedFormat::HEX,
+                      [&](const SingleByteXorDetector::Detection&) {
+                        ++num_callbacks;
+                      }));
+
+  ASSERT_EQ(detections.size(), 5);
+  EXPECT_GE(num_callbacks, 5);
+  EXPECT_EQ(detections[0].index, 321);
+  EXPECT_EQ(detections[0].decryption_result.key, 0x35);
+  EXPECT_EQ(detections[0].decryption_result.decrypted_text, plaintext);
+
+  // The results match cracking every candidate in turn.
+  std::vector<SingleByteXor::DecryptionResultType> results;
+  for (const std::string& candidate : candidates) {
+    results.push_back(single_byte_xor.Crack(Bytes::CreateFromHex(candidate)));
+  }
+  for (size_t i = 0; i < detections.size(); ++i) {
+    EXPECT_EQ(detections[i].decryption_result, results[detections[i].index]);
+    if (i > 0) {
+      EXPECT_LE(detections[i - 1].decryption_result.score,
+                detections[i].decryption_result.score);
+    }
+  }
+  for (size_t i = 0; i < results.size(); ++i) {
+    EXPECT_TRUE(i == detections[0].index ||
+                results[i].score >= detections[0].decryption_result.score);
+  }
+}
+
+TEST(SingleByteXorDetectorTest, DetectFewerCandidatesThanResultsTest) {
+  std::vector<std::string> candidates = TestCandidates(3);
+  SingleByteXorDetector detector(/*max_results=*/10);
+  ASSERT_OK_AND_ASSIGN(
+      std::vector<SingleByteXorDetector::Detection> detections,
+      detector.Detect(Views(candidates), cryptopals::BytesEncodedFormat::HEX));
+  EXPECT_EQ(detections.size(), 3);
+}
+
+TEST(SingleByteXorDetectorTest, AddInBatchesTest) {
+  std::vector<std::string> candidates = TestCandidates(100);
+  SingleByteXor single_byte_xor;
+  Bytes plaintext = Bytes::CreateFromRaw("Cooking MC's like a pound");
+  candidates[77] = single_byte_xor.Encrypt(plaintext, 0x58).ToHex();
+  const std::vector<std::string_view> views = Views(candidates);
+
+  SingleByteXorDetector detector(/*max_results=*/3);
+  for (size_t begin = 0; begin < views.size(); begin += 30) {
+    std::span<const std::string_view> batch = std::span(views).subspan(
+        begin, std::min<size_t>(30, views.size() - begin));
+    ASSERT_OK(detector.Add(batch, cryptopals::BytesEncodedFormat::HEX));
+  }
+  std::vector<SingleByteXorDetector::Detection> detections = detector.results();
+
+  // Candidates are numbered across batches, as if added at once.
+  SingleByteXorDetector whole_detector(/*max_results=*/3);
+  ASSERT_OK_AND_ASSIGN(
+      std::vector<SingleByteXorDetector::Detection> whole_detections,
+      whole_detector.Detect(views, cryptopals::BytesEncodedFormat::HEX));
+  ASSERT_EQ(detections.size(), 3);
+  EXPECT_EQ(detections[0].index, 77);
+  for (size_t i = 0; i < detections.size(); ++i) {
+    EXPECT_EQ(detections[i].index, whole_detections[i].index);
+    EXPECT_EQ(detections[i].decryption_result,
+              whole_detections[i].decryption_result);
+  }
+}
+
+TEST(SingleByteXorDetectorTest, DetectReportsFirstMalformedCandidateTest) {
+  std::vector<std::string> candidates = TestCandidates(100);
+  candidates[70] = "xx";
+  candidates[40] = "0g";
+
+  cryptopals::util::ThreadPool pool(3);
+  SingleByteXorDetector detector(/*max_results=*/1, pool);
+  absl::StatusOr<std::vector<SingleByteXorDetector::Detection>> detections =
+      detector.Detect(Views(candidates), cryptopals::BytesEncodedFormat::HEX);
+  ASSERT_EQ(detections.status().code(), absl::StatusCode::kInvalidArgument);
+  EXPECT_NE(detections.status().message().find("'g'"), std::string::npos)
+      << detections.status();
+}
+
+}  // namespace cryptopals::cipher
@@ -0,0 +1,54 @@
+#include "cryptopals/cipher/single_byte_xor.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace cryptopals::cipher {
+
+using cryptopals::util::Bytes;
+
+TEST(SingleByteXorTest, CrackTest) {
+  Bytes ciphertext = Bytes::CreateFromHex(
+      "1b37373331363f78151b7f2b783431333d78397828372d363c78373e783a393b3736");
+
+  SingleByteXor single_byte_xor;
+  SingleByteXor::DecryptionResultType result =
+      single_byte_xor.Crack(ciphertext);
+  EXPECT_EQ(result.key, 0x58);
+  EXPECT_EQ(result.decrypted_text.ToRaw(),
+            "Cooking MC's like a pound of bacon");
+}
+
+TEST(SingleByteXorTest, CrackTriesEveryKeyTest) {
+  Bytes plaintext =
+      Bytes::CreateFromRaw("Now that the party is jumping with the bass kicked");
+
+  SingleByteXor single_byte_xor;
+  SingleByteXor::DecryptionResultType result =
+      single_byte_xor.Crack(single_byte_xor.Encrypt(plaintext, 0xFF));
+  EXPECT_EQ(result.key, 0xFF);
+  EXPECT_EQ(result.decrypted_text, plaintext);
+}
+
+TEST(SingleByteXorTest, CrackTopResultsTest) {
+  Bytes ciphertext = Bytes::CreateFromHex(
+      "1b37373331363f78151b7f2b783431333d78397828372d363c78373e783a393b3736");
+
+  SingleByteXor single_byte_xor;
+  std::vector<SingleByteXor::DecryptionResultType> results =
+      single_byte_xor.Crack(ciphertext, 5);
+  ASSERT_EQ(results.size(), 5);
+  EXPECT_EQ(results[0].key, single_byte_xor.Crack(ciphertext).key);
+  for (size_t i = 1; i < results.size(); ++i) {
+    EXPECT_LE(results[i - 1].score, results[i].score);
+    EXPECT_NE(results[i - 1].key, results[i].key);
+    EXPECT_EQ(results[i].decrypted_text,
+              single_byte_xor.Decrypt(ciphertext, results[i].key));
+  }
+
+  EXPECT_EQ(single_byte_xor.Crack(ciphertext, 1000).size(), 256);
+  EXPECT_TRUE(single_byte_xor.Crack(ciphertext, 0).empty());
+}
+
+}  // namespace cryptopals::cipher
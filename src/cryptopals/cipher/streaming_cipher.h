@@ -0,0 +1,42 @@
+#ifndef CRYPTOPALS_CIPHER_STREAMING_CIPHER_H_
+#define CRYPTOPALS_CIPHER_STREAMING_CIPHER_H_
+
+#include <cstdint>
+#include <span>
+
+#include "absl/status/statusor.h"
+
+namespace cryptopals::cipher {
+
+// The StreamingCipherInterface class defines the public interface of a cipher
+// that processes a message incrementally, so that the whole message never has
+// to be held in memory. A message is passed in pieces of any size to Update(),
+// followed by a single call to Finalize().
+class StreamingCipherInterface {
+ public:
+  virtual ~StreamingCipherInterface() {}
+
+  // Processes `input` and writes as much output as is available to `output`.
+  // Returns the number of bytes written, which never exceeds
+  // MaxUpdateOutputSize(input.size()). Input that cannot be processed yet is
+  // kept until the next call. `input` and `output` must not overlap.
+  virtual absl::StatusOr<size_t> Update(std::span<const uint8_t> input,
+                                        std::span<uint8_t> output) = 0;
+
+  // Processes the rest of the message and writes it to `output`, which must
+  // hold at least MaxFinalizeOutputSize() bytes. Returns the number of bytes
+  // written. No further calls are allowed afterwards.
+  virtual absl::StatusOr<size_t> Finalize(std::span<uint8_t> output) = 0;
+
+  // Returns the size of an output buffer that is always large enough for a
+  // call to Update() with `input_size` bytes.
+  virtual size_t MaxUpdateOutputSize(size_t input_size) const = 0;
+
+  // Returns the size of an output buffer that is always large enough for the
+  // call to Finalize().
+  virtual size_t MaxFinalizeOutputSize() const = 0;
+};
+
+}  // namespace cryptopals::cipher
+
+#endif  // CRYPTOPALS_CIPHER_STREAMING_CIPHER_H_
@@ -5,6 +5,7 @@
 
 #include "cryptopals/cipher/decryption_result.h"
 #include "cryptopals/util/bytes.h"
+#include "cryptopals/util/bytes_view.h"
 
 namespace cryptopals::cipher {
 
@@ -28,12 +29,12 @@ class SymmetricCipherInterface {
   virtual ~SymmetricCipherInterface() {}
 
   // Encrypts `plaintext` using `key` and returns the encrypted ciphertext.
-  virtual cryptopals::util::Bytes Encrypt(
-      const cryptopals::util::Bytes& plaintext, KeyParamType key) const = 0;
+  virtual cryptopals::util::Bytes Encrypt(cryptopals::util::BytesView plaintext,
+                                          KeyParamType key) const = 0;
 
   // Decrypts `ciphertext` using `key` and returns the decrypted plaintext.
   virtual cryptopals::util::Bytes Decrypt(
-      const cryptopals::util::Bytes& ciphertext, KeyParamType key) const = 0;
+      cryptopals::util::BytesView ciphertext, KeyParamType key) const = 0;
 };
 
 }  // namespace cryptopals::cipher
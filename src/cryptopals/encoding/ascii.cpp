@@ -1,21 +1,28 @@
 #include "cryptopals/encoding/ascii.h"
 
+#include "cryptopals/util/byte_histogram.h"
+
 namespace cryptopals::encoding {
 
-using cryptopals::util::Bytes;
+using cryptopals::util::BytesView;
 
 absl::flat_hash_map<uint8_t, size_t> AsciiEncoding::GenerateHistogram(
-    const Bytes& input) const {
-  absl::flat_hash_map<uint8_t, size_t> histogram;
+    BytesView input) const {
+  DenseHistogramType dense_histogram = GenerateDenseHistogram(input);
 
-  for (uint8_t byte : input) {
-    if (histogram.contains(byte)) {
-      histogram.at(byte)++;
-    } else {
-      histogram.insert(std::make_pair(byte, 1));
+  absl::flat_hash_map<uint8_t, size_t> histogram;
+  for (size_t code_point = 0; code_point < dense_histogram.size();
+       ++code_point) {
+    if (dense_histogram[code_point] != 0) {
+      histogram.emplace(code_point, dense_histogram[code_point]);
     }
   }
   return histogram;
 }
 
+void AsciiEncoding::AddToDenseHistogram(BytesView input,
+                                        DenseHistogramType& histogram) const {
+  cryptopals::util::AddByteCounts(input, histogram);
+}
+
 }  // namespace cryptopals::encoding
@@ -2,7 +2,7 @@
 #define CRYPTOPALS_ENCODING_ASCII_H_
 
 #include "cryptopals/encoding/encoding.h"
-#include "cryptopals/util/bytes.h"
+#include "cryptopals/util/bytes_view.h"
 
 namespace cryptopals::encoding {
 
@@ -10,7 +10,11 @@ class AsciiEncoding : public EncodingInterface<uint8_t> {
  public:
   // Implements GenerateHistogram from EncodingInterface.
   absl::flat_hash_map<uint8_t, size_t> GenerateHistogram(
-      const cryptopals::util::Bytes& input) const override;
+      cryptopals::util::BytesView input) const override;
+
+  // Implements AddToDenseHistogram from EncodingInterface.
+  void AddToDenseHistogram(cryptopals::util::BytesView input,
+                           DenseHistogramType& histogram) const override;
 };
 
 }  // namespace cryptopals::encoding
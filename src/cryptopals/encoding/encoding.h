@@ -5,7 +5,8 @@
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/status/status.h"
-#include "cryptopals/util/bytes.h"
+#include "cryptopals/util/byte_histogram.h"
+#include "cryptopals/util/bytes_view.h"
 
 namespace cryptopals::encoding {
 
@@ -17,12 +18,37 @@ class EncodingInterface {
   // HistogramType is a reference to an absl::flat_hash_map that stores the
   // number of occurrences of several code points.
   using HistogramType = absl::flat_hash_map<CodePointType, size_t>;
+  // DenseHistogramType is a fixed-size array holding the number of
+  // occurrences of each code point below 256, indexed by code point.
+  using DenseHistogramType = cryptopals::util::ByteHistogram;
 
   virtual ~EncodingInterface() {}
 
   // Generates a histogram of the occurrences of each code point in `input`.
   virtual HistogramType GenerateHistogram(
-      const cryptopals::util::Bytes& input) const = 0;
+      cryptopals::util::BytesView input) const = 0;
+
+  // Adds the occurrences of each code point in `input` to `histogram`. Code
+  // points of 256 or more are not counted. The default implementation converts
+  // the result of GenerateHistogram(); encodings with single-byte code points
+  // should count directly.
+  virtual void AddToDenseHistogram(cryptopals::util::BytesView input,
+                                   DenseHistogramType& histogram) const {
+    for (const auto& [code_point, count] : GenerateHistogram(input)) {
+      if (code_point < histogram.size()) {
+        histogram[code_point] += count;
+      }
+    }
+  }
+
+  // Generates a dense histogram of the occurrences of each code point in
+  // `input`. See AddToDenseHistogram().
+  DenseHistogramType GenerateDenseHistogram(
+      cryptopals::util::BytesView input) const {
+    DenseHistogramType histogram = {};
+    AddToDenseHistogram(input, histogram);
+    return histogram;
+  }
 };
 
 }  // namespace cryptopals::encoding
@@ -1,21 +1,21 @@
 #include <filesystem>
 #include <fstream>
+#include <iomanip>
 #include <iostream>
 #include <sstream>
+#include <utility>
 
-#include "absl/container/flat_hash_map.h"
 #include "absl/flags/flag.h"
 #include "absl/flags/parse.h"
 #include "absl/flags/usage.h"
 #include "absl/strings/str_split.h"
 #include "cryptopals/encoding/ascii.h"
 #include "cryptopals/proto/cryptopals_enums.pb.h"
-#include "cryptopals/util/algorithm.h"
-#include "cryptopals/util/bytes.h"
+#include "cryptopals/util/bytes_view.h"
 #include "cryptopals/util/init_cryptopals.h"
 
 using cryptopals::encoding::AsciiEncoding;
-using cryptopals::util::Bytes;
+using cryptopals::util::BytesView;
 
 ABSL_FLAG(std::string, filemap, "",
           "A text file containing the absolute paths of files to process, one "
@@ -42,7 +42,7 @@ int main(int argc, char** argv) {
   }
 
   AsciiEncoding ascii_encoding;
-  AsciiEncoding::HistogramType histogram;
+  AsciiEncoding::DenseHistogramType histogram = {};
 
   size_t total_input_length = 0;
   for (const auto& file : files_list) {
@@ -51,18 +51,23 @@ int main(int argc, char** argv) {
     std::ostringstream contents;
     contents << input_stream.rdbuf();
 
-    AsciiEncoding::HistogramType file_histogram =
-        ascii_encoding.GenerateHistogram(Bytes::CreateFromRaw(contents.str()));
-    histogram = cryptopals::util::MapCombine(histogram, file_histogram,
-                                             std::plus<size_t>());
+    const std::string file_contents = std::move(contents).str();
+    ascii_encoding.AddToDenseHistogram(
+        BytesView(reinterpret_cast<const uint8_t*>(file_contents.data()),
+                  file_contents.size()),
+        histogram);
 
-    total_input_length += contents.str().size();
+    total_input_length += file_contents.size();
   }
 
-  for (auto [k, v] : histogram) {
+  for (size_t k = 0; k < histogram.size(); ++k) {
+    if (histogram[k] == 0) {
+      continue;
+    }
     std::cout << std::hex << std::setw(2) << static_cast<int>(k) << std::dec
               << ": " << std::fixed
-              << (static_cast<double>(v) / total_input_length) << std::endl;
+              << (static_cast<double>(histogram[k]) / total_input_length)
+              << std::endl;
   }
   return 0;
 }
@@ -8,82 +8,24 @@
 #include "absl/status/status_macros.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/str_cat.h"
+#include "cryptopals/util/aes_engine.h"
+#include "cryptopals/util/aes_sbox.h"
 #include "cryptopals/util/logging.h"
 
 namespace cryptopals::util {
 
-// The Rijndael S-box, and it's inverse. See
-// https://en.wikipedia.org/wiki/Rijndael_S-box.
-// clang-format off
-inline constexpr std::array<uint8_t, 256> aes_encrypt_sub = {
-  0x63, 0x7c, 0x77, 0x7b, 0xf2, 0x6b, 0x6f, 0xc5, 0x30, 0x01, 0x67, 0x2b, 0xfe, 0xd7, 0xab, 0x76,
-  0xca, 0x82, 0xc9, 0x7d, 0xfa, 0x59, 0x47, 0xf0, 0xad, 0xd4, 0xa2, 0xaf, 0x9c, 0xa4, 0x72, 0xc0,
-  0xb7, 0xfd, 0x93, 0x26, 0x36, 0x3f, 0xf7, 0xcc, 0x34, 0xa5, 0xe5, 0xf1, 0x71, 0xd8, 0x31, 0x15,
-  0x04, 0xc7, 0x23, 0xc3, 0x18, 0x96, 0x05, 0x9a, 0x07, 0x12, 0x80, 0xe2, 0xeb, 0x27, 0xb2, 0x75,
-  0x09, 0x83, 0x2c, 0x1a, 0x1b, 0x6e, 0x5a, 0xa0, 0x52, 0x3b, 0xd6, 0xb3, 0x29, 0xe3, 0x2f, 0x84,
-  0x53, 0xd1, 0x00, 0xed, 0x20, 0xfc, 0xb1, 0x5b, 0x6a, 0xcb, 0xbe, 0x39, 0x4a, 0x4c, 0x58, 0xcf,
-  0xd0, 0xef, 0xaa, 0xfb, 0x43, 0x4d, 0x33, 0x85, 0x45, 0xf9, 0x02, 0x7f, 0x50, 0x3c, 0x9f, 0xa8,
-  0x51, 0xa3, 0x40, 0x8f, 0x92, 0x9d, 0x38, 0xf5, 0xbc, 0xb6, 0xda, 0x21, 0x10, 0xff, 0xf3, 0xd2,
-  0xcd, 0x0c, 0x13, 0xec, 0x5f, 0x97, 0x44, 0x17, 0xc4, 0xa7, 0x7e, 0x3d, 0x64, 0x5d, 0x19, 0x73,
-  0x60, 0x81, 0x4f, 0xdc, 0x22, 0x2a, 0x90, 0x88, 0x46, 0xee, 0xb8, 0x14, 0xde, 0x5e, 0x0b, 0xdb,
-  0xe0, 0x32, 0x3a, 0x0a, 0x49, 0x06, 0x24, 0x5c, 0xc2, 0xd3, 0xac, 0x62, 0x91, 0x95, 0xe4, 0x79,
-  0xe7, 0xc8, 0x37, 0x6d, 0x8d, 0xd5, 0x4e, 0xa9, 0x6c, 0x56, 0xf4, 0xea, 0x65, 0x7a, 0xae, 0x08,
-  0xba, 0x78, 0x25, 0x2e, 0x1c, 0xa6, 0xb4, 0xc6, 0xe8, 0xdd, 0x74, 0x1f, 0x4b, 0xbd, 0x8b, 0x8a,
-  0x70, 0x3e, 0xb5, 0x66, 0x48, 0x03, 0xf6, 0x0e, 0x61, 0x35, 0x57, 0xb9, 0x86, 0xc1, 0x1d, 0x9e,
-  0xe1, 0xf8, 0x98, 0x11, 0x69, 0xd9, 0x8e, 0x94, 0x9b, 0x1e, 0x87, 0xe9, 0xce, 0x55, 0x28, 0xdf,
-  0x8c, 0xa1, 0x89, 0x0d, 0xbf, 0xe6, 0x42, 0x68, 0x41, 0x99, 0x2d, 0x0f, 0xb0, 0x54, 0xbb, 0x16,
-};
-inline constexpr std::array<uint8_t, 256> aes_decrypt_sub = {
-  0x52, 0x09, 0x6a, 0xd5, 0x30, 0x36, 0xa5, 0x38, 0xbf, 0x40, 0xa3, 0x9e, 0x81, 0xf3, 0xd7, 0xfb,
-  0x7c, 0xe3, 0x39, 0x82, 0x9b, 0x2f, 0xff, 0x87, 0x34, 0x8e, 0x43, 0x44, 0xc4, 0xde, 0xe9, 0xcb,
-  0x54, 0x7b, 0x94, 0x32, 0xa6, 0xc2, 0x23, 0x3d, 0xee, 0x4c, 0x95, 0x0b, 0x42, 0xfa, 0xc3, 0x4e,
-  0x08, 0x2e, 0xa1, 0x66, 0x28, 0xd9, 0x24, 0xb2, 0x76, 0x5b, 0xa2, 0x49, 0x6d, 0x8b, 0xd1, 0x25,
-  0x72, 0xf8, 0xf6, 0x64, 0x86, 0x68, 0x98, 0x16, 0xd4, 0xa4, 0x5c, 0xcc, 0x5d, 0x65, 0xb6, 0x92,
-  0x6c, 0x70, 0x48, 0x50, 0xfd, 0xed, 0xb9, 0xda, 0x5e, 0x15, 0x46, 0x57, 0xa7, 0x8d, 0x9d, 0x84,
-  0x90, 0xd8, 0xab, 0x00, 0x8c, 0xbc, 0xd3, 0x0a, 0xf7, 0xe4, 0x58, 0x05, 0xb8, 0xb3, 0x45, 0x06,
-  0xd0, 0x2c, 0x1e, 0x8f, 0xca, 0x3f, 0x0f, 0x02, 0xc1, 0xaf, 0xbd, 0x03, 0x01, 0x13, 0x8a, 0x6b,
-  0x3a, 0x91, 0x11, 0x41, 0x4f, 0x67, 0xdc, 0xea, 0x97, 0xf2, 0xcf, 0xce, 0xf0, 0xb4, 0xe6, 0x73,
-  0x96, 0xac, 0x74, 0x22, 0xe7, 0xad, 0x35, 0x85, 0xe2, 0xf9, 0x37, 0xe8, 0x1c, 0x75, 0xdf, 0x6e,
-  0x47, 0xf1, 0x1a, 0x71, 0x1d, 0x29, 0xc5, 0x89, 0x6f, 0xb7, 0x62, 0x0e, 0xaa, 0x18, 0xbe, 0x1b,
-  0xfc, 0x56, 0x3e, 0x4b, 0xc6, 0xd2, 0x79, 0x20, 0x9a, 0xdb, 0xc0, 0xfe, 0x78, 0xcd, 0x5a, 0xf4,
-  0x1f, 0xdd, 0xa8, 0x33, 0x88, 0x07, 0xc7, 0x31, 0xb1, 0x12, 0x10, 0x59, 0x27, 0x80, 0xec, 0x5f,
-  0x60, 0x51, 0x7f, 0xa9, 0x19, 0xb5, 0x4a, 0x0d, 0x2d, 0xe5, 0x7a, 0x9f, 0x93, 0xc9, 0x9c, 0xef,
-  0xa0, 0xe0, 0x3b, 0x4d, 0xae, 0x2a, 0xf5, 0xb0, 0xc8, 0xeb, 0xbb, 0x3c, 0x83, 0x53, 0x99, 0x61,
-  0x17, 0x2b, 0x04, 0x7e, 0xba, 0x77, 0xd6, 0x26, 0xe1, 0x69, 0x14, 0x63, 0x55, 0x21, 0x0c, 0x7d,
-};
-// clang-format on
-
 absl::StatusOr<Bytes> EncryptBlock(aes_block_span block, const Bytes& key) {
-  // Generate Key Schedule
-  ASSIGN_OR_RETURN(Bytes key_schedule, GenerateKeySchedule(key));
-
-  // Initialize state
-  AesState state;
-  std::copy_n(block.begin(), AesState::SIZE_BYTES, state.bytes.begin());
-
-  aes_block_span initial_round_key(key_schedule.begin(), AesState::SIZE_BYTES);
-  AddRoundKey(state, initial_round_key);
-
-  const size_t num_rounds = key.size() / WORD_SIZE + 6;
-  for (int round = 1; round < num_rounds; ++round) {
-    SubstituteBytes(state);
-    ShiftRows(state);
-    MixColumns(state);
-    aes_block_span round_key(
-        key_schedule.begin() + round * AesState::SIZE_BYTES,
-        AesState::SIZE_BYTES);
-    AddRoundKey(state, round_key);
-  }
+  ASSIGN_OR_RETURN(AesKeySchedule key_schedule, AesKeySchedule::Create(key));
 
-  // In the last round
-  SubstituteBytes(state);
-  ShiftRows(state);
-  aes_block_span final_round_key(
-      key_schedule.begin() + num_rounds * AesState::SIZE_BYTES,
-      AesState::SIZE_BYTES);
-  AddRoundKey(state, final_round_key);
+  Bytes output(AesState::SIZE_BYTES);
+  EncryptBlock(block, key_schedule,
+               aes_mutable_block_span(output.begin(), AesState::SIZE_BYTES));
+  return output;
+}
 
-  return Bytes::CreateFromRange(state.bytes.begin(), state.bytes.end());
+void EncryptBlock(aes_block_span block, const AesKeySchedule& key_schedule,
+                  aes_mutable_block_span output) {
+  GetDefaultAesEngine().EncryptBlocks(block, key_schedule, output);
 }
 
 void SubstituteBytes(AesState& state) {
@@ -135,7 +77,7 @@ void AddRoundKey(AesState& state, aes_block_span round_key) {
                  state.bytes.begin(), std::bit_xor<uint8_t>());
 }
 
-absl::StatusOr<Bytes> GenerateKeySchedule(const Bytes& key) {
+absl::StatusOr<AesKeySchedule> AesKeySchedule::Create(const Bytes& key) {
   switch (key.size()) {
     case 16:  // AES-128
     case 24:  // AES-192
@@ -146,33 +88,62 @@ absl::StatusOr<Bytes> GenerateKeySchedule(const Bytes& key) {
           absl::StrCat("Invalid key.size() ", key.size()));
   }
   const size_t key_words = key.size() / WORD_SIZE;
-  const size_t key_schedule_num_words = (key_words + 7) * AesState::SIZE_WORDS;
 
-  Bytes key_schedule = key;
-  Bytes round_constant = Bytes::CreateFromHex("01000000");
+  AesKeySchedule key_schedule;
+  key_schedule.num_rounds_ = key_words + 6;
+  const size_t key_schedule_num_words =
+      (key_schedule.num_rounds_ + 1) * AesState::SIZE_WORDS;
+
+  // The schedule is expanded one word at a time in place, so that no
+  // intermediate words need to be allocated.
+  uint8_t* words = key_schedule.round_keys_.data();
+  std::copy(key.begin(), key.end(), words);
+  uint8_t round_constant = 0x01;
 
   for (int i = key_words; i < key_schedule_num_words; ++i) {
-    Bytes prev_word(key_schedule.end() - WORD_SIZE, key_schedule.end());
+    const uint8_t* prev_word = words + (i - 1) * WORD_SIZE;
 
-    Bytes temp_word;
+    std::array<uint8_t, WORD_SIZE> temp_word;
     if (i % key_words == 0) {
-      temp_word = SubWord(RotWord(prev_word)) ^ round_constant;
-      round_constant.at(0) = xtime(round_constant.at(0));
+      // SubWord(RotWord(prev_word)) ^ round_constant
+      temp_word = {
+          static_cast<uint8_t>(aes_encrypt_sub[prev_word[1]] ^ round_constant),
+          aes_encrypt_sub[prev_word[2]], aes_encrypt_sub[prev_word[3]],
+          aes_encrypt_sub[prev_word[0]]};
+      round_constant = xtime(round_constant);
     } else if (key_words > 6 && i % key_words == 4) {
-      temp_word = SubWord(prev_word);
+      // SubWord(prev_word)
+      std::transform(prev_word, prev_word + WORD_SIZE, temp_word.begin(),
+                     [](uint8_t byte) { return aes_encrypt_sub[byte]; });
     } else {
-      temp_word = prev_word;
+      std::copy_n(prev_word, WORD_SIZE, temp_word.begin());
     }
 
-    auto prev_key_index = key_schedule.end() - key.size();
-    Bytes prev_key_word(prev_key_index, prev_key_index + WORD_SIZE);
+    const uint8_t* prev_key_word = words + (i - key_words) * WORD_SIZE;
+    std::transform(temp_word.begin(), temp_word.end(), prev_key_word,
+                   words + i * WORD_SIZE, std::bit_xor<uint8_t>());
+  }
 
-    key_schedule.Append(temp_word ^ prev_key_word);
+  // Derive the round keys for the equivalent inverse cipher.
+  key_schedule.inv_round_keys_ = key_schedule.round_keys_;
+  for (int round = 1; round < key_schedule.num_rounds_; ++round) {
+    AesState state;
+    auto round_key = key_schedule.inv_round_keys_.begin() +
+                     round * AesState::SIZE_BYTES;
+    std::copy_n(round_key, AesState::SIZE_BYTES, state.bytes.begin());
+    InvMixColumns(state);
+    std::copy_n(state.bytes.begin(), AesState::SIZE_BYTES, round_key);
   }
 
   return key_schedule;
 }
 
+absl::StatusOr<Bytes> GenerateKeySchedule(const Bytes& key) {
+  ASSIGN_OR_RETURN(AesKeySchedule key_schedule, AesKeySchedule::Create(key));
+  return Bytes::CreateFromRange(key_schedule.bytes().begin(),
+                                key_schedule.bytes().end());
+}
+
 Bytes SubWord(const Bytes& input) {
   Bytes output(input.size());
   std::transform(input.begin(), input.end(), output.begin(),
@@ -186,38 +157,18 @@ Bytes RotWord(const Bytes& input) {
   return output;
 }
 
-absl::StatusOr<cryptopals::util::Bytes> DecryptBlock(
-    aes_block_span block, const cryptopals::util::Bytes& key) {
-  // Generate Key Schedule
-  ASSIGN_OR_RETURN(Bytes key_schedule, GenerateKeySchedule(key));
-
-  // Initialize state
-  AesState state;
-  std::copy_n(block.begin(), AesState::SIZE_BYTES, state.bytes.begin());
-
-  const size_t num_rounds = key.size() / WORD_SIZE + 6;
-  aes_block_span final_round_key(
-      key_schedule.begin() + num_rounds * AesState::SIZE_BYTES,
-      AesState::SIZE_BYTES);
-  AddRoundKey(state, final_round_key);
-
-  for (int round = num_rounds - 1; round > 0; --round) {
-    InvShiftRows(state);
-    InvSubstituteBytes(state);
-    aes_block_span round_key(
-        key_schedule.begin() + round * AesState::SIZE_BYTES,
-        AesState::SIZE_BYTES);
-    AddRoundKey(state, round_key);
-    InvMixColumns(state);
-  }
+absl::StatusOr<Bytes> DecryptBlock(aes_block_span block, const Bytes& key) {
+  ASSIGN_OR_RETURN(AesKeySchedule key_schedule, AesKeySchedule::Create(key));
 
-  // In the last round
-  InvShiftRows(state);
-  InvSubstituteBytes(state);
-  aes_block_span initial_round_key(key_schedule.begin(), AesState::SIZE_BYTES);
-  AddRoundKey(state, initial_round_key);
+  Bytes output(AesState::SIZE_BYTES);
+  DecryptBlock(block, key_schedule,
+               aes_mutable_block_span(output.begin(), AesState::SIZE_BYTES));
+  return output;
+}
 
-  return Bytes::CreateFromRange(state.bytes.begin(), state.bytes.end());
+void DecryptBlock(aes_block_span block, const AesKeySchedule& key_schedule,
+                  aes_mutable_block_span output) {
+  GetDefaultAesEngine().DecryptBlocks(block, key_schedule, output);
 }
 
 void InvShiftRows(AesState& state) {
@@ -60,12 +60,78 @@ struct AesState {
 };
 
 typedef std::span<const uint8_t, AesState::SIZE_BYTES> aes_block_span;
+typedef std::span<uint8_t, AesState::SIZE_BYTES> aes_mutable_block_span;
+
+// An expanded AES key, as described in section 5.2 of the AES spec. Expanding
+// a key is expensive relative to encrypting a single block, so an
+// AesKeySchedule should be created once and reused for every block encrypted
+// or decrypted with the same key.
+class AesKeySchedule {
+ public:
+  // The number of rounds performed with the largest supported key (AES-256).
+  static constexpr size_t MAX_ROUNDS = 14;
+  // The number of bytes required to store the round keys for MAX_ROUNDS.
+  static constexpr size_t MAX_SIZE_BYTES =
+      (MAX_ROUNDS + 1) * AesState::SIZE_BYTES;
+
+  // Creates the key schedule for `key`. The size of `key` selects the variant
+  // of the cipher: 16 bytes for AES-128, 24 bytes for AES-192 and 32 bytes for
+  // AES-256. Returns an error status for any other key size.
+  static absl::StatusOr<AesKeySchedule> Create(
+      const cryptopals::util::Bytes& key);
+
+  // Returns the number of rounds performed with this key schedule.
+  inline size_t rounds() const { return num_rounds_; }
+
+  // Returns the round key used in `round`, in the range [0, rounds()].
+  inline aes_block_span RoundKey(size_t round) const {
+    return aes_block_span(round_keys_.data() + round * AesState::SIZE_BYTES,
+                          AesState::SIZE_BYTES);
+  }
+
+  // Returns every round key, concatenated in order.
+  inline std::span<const uint8_t> bytes() const {
+    return std::span<const uint8_t>(
+        round_keys_.data(), (num_rounds_ + 1) * AesState::SIZE_BYTES);
+  }
+
+  // Returns the round key used in `round` of the equivalent inverse cipher
+  // described in section 5.3.5 of the AES spec. InvMixColumns() has been
+  // applied to the round keys in the range [1, rounds() - 1], which lets a
+  // decryption round use the same structure as an encryption round.
+  inline aes_block_span InvRoundKey(size_t round) const {
+    return aes_block_span(
+        inv_round_keys_.data() + round * AesState::SIZE_BYTES,
+        AesState::SIZE_BYTES);
+  }
+
+ private:
+  AesKeySchedule() = default;
+
+  // The number of rounds performed with this key schedule.
+  size_t num_rounds_ = 0;
+  // The round keys, stored contiguously. Only the first (rounds() + 1) round
+  // keys are used.
+  alignas(AesState::SIZE_BYTES)
+      std::array<uint8_t, MAX_SIZE_BYTES> round_keys_ = {0};
+  // The round keys for the equivalent inverse cipher, indexed the same way as
+  // `round_keys_`.
+  alignas(AesState::SIZE_BYTES)
+      std::array<uint8_t, MAX_SIZE_BYTES> inv_round_keys_ = {0};
+};
 
 // Encrypts a single `block` of bytes using the provided `key` according to the
 // AES spec. Returns the encrypted block or an error status.
 absl::StatusOr<cryptopals::util::Bytes> EncryptBlock(
     aes_block_span block, const cryptopals::util::Bytes& key);
 
+// Encrypts a single `block` of bytes using the expanded `key_schedule` and
+// writes the encrypted block to `output`. `block` and `output` may refer to the
+// same memory. The block is encrypted with GetDefaultAesEngine(); see
+// aes_engine.h to select a specific implementation.
+void EncryptBlock(aes_block_span block, const AesKeySchedule& key_schedule,
+                  aes_mutable_block_span output);
+
 // Modifies state to substitute the bytes according to section 5.1.1 of the
 // AES spec.
 void SubstituteBytes(AesState& state);
@@ -81,7 +147,8 @@ void MixColumns(AesState& state);
 void AddRoundKey(AesState& state, aes_block_span round_key);
 
 // Expands the key according to section 5.2 of the AES spec. Returns the
-// expanded key schedule or an error status.
+// expanded key schedule or an error status. Prefer AesKeySchedule::Create() to
+// avoid copying the round keys into a Bytes object.
 absl::StatusOr<cryptopals::util::Bytes> GenerateKeySchedule(
     const cryptopals::util::Bytes& key);
 
@@ -97,6 +164,13 @@ cryptopals::util::Bytes RotWord(const cryptopals::util::Bytes& input);
 absl::StatusOr<cryptopals::util::Bytes> DecryptBlock(
     aes_block_span block, const cryptopals::util::Bytes& key);
 
+// Decrypts a single `block` of bytes using the expanded `key_schedule` and
+// writes the decrypted block to `output`. `block` and `output` may refer to the
+// same memory. The block is decrypted with GetDefaultAesEngine(); see
+// aes_engine.h to select a specific implementation.
+void DecryptBlock(aes_block_span block, const AesKeySchedule& key_schedule,
+                  aes_mutable_block_span output);
+
 // Modifies state to shift the rows according to section 5.3.1 of the AES spec.
 void InvShiftRows(AesState& state);
 
@@ -0,0 +1,473 @@
+// DISCLAIMER: This algorithm is implemented for educational purposes only. By
+// no means is it guaranteed to be secure.
+//
+// The bitsliced representation and the S-box circuit follow the "ct64"
+// construction described by Thomas Pornin for BearSSL
+// (https://www.bearssl.org/constanttime.html), which in turn uses the S-box
+// circuit of Boyar and Peralta (https://eprint.iacr.org/2011/332).
+
+#include "cryptopals/util/aes_bitsliced_engine.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <span>
+
+namespace cryptopals::util {
+namespace {
+
+// The bitsliced state of BitslicedAesEngine::BATCH_BLOCKS blocks. Word i holds
+// bit i of every byte of the batch.
+typedef std::array<uint64_t, 8> BitslicedState;
+
+// The bitsliced round keys for the largest key schedule. Each round key is
+// replicated across every block of the batch.
+typedef std::array<BitslicedState, AesKeySchedule::MAX_ROUNDS + 1>
+    BitslicedKeySchedule;
+
+constexpr size_t BATCH_BYTES =
+    BitslicedAesEngine::BATCH_BLOCKS * AesState::SIZE_BYTES;
+
+inline uint32_t LoadWord(const uint8_t* input) {
+  return static_cast<uint32_t>(input[0]) |
+         static_cast<uint32_t>(input[1]) << 8 |
+         static_cast<uint32_t>(input[2]) << 16 |
+         static_cast<uint32_t>(input[3]) << 24;
+}
+
+inline void StoreWord(uint32_t word, uint8_t* output) {
+  output[0] = word;
+  output[1] = word >> 8;
+  output[2] = word >> 16;
+  output[3] = word >> 24;
+}
+
+// Spreads the four words of a block over two 64-bit words, so that ortho() can
+// gather the same bit of each byte into a single word.
+void InterleaveIn(const uint32_t* w, uint64_t& q0, uint64_t& q1) {
+  std::array<uint64_t, 4> x = {w[0], w[1], w[2], w[3]};
+  for (uint64_t& xi : x) {
+    xi |= xi << 16;
+    xi &= 0x0000FFFF0000FFFF;
+    xi |= xi << 8;
+    xi &= 0x00FF00FF00FF00FF;
+  }
+  q0 = x[0] | (x[2] << 8);
+  q1 = x[1] | (x[3] << 8);
+}
+
+// Performs the reverse operation of InterleaveIn.
+void InterleaveOut(uint64_t q0, uint64_t q1, uint32_t* w) {
+  std::array<uint64_t, 4> x = {
+      q0 & 0x00FF00FF00FF00FF, q1 & 0x00FF00FF00FF00FF,
+      (q0 >> 8) & 0x00FF00FF00FF00FF, (q1 >> 8) & 0x00FF00FF00FF00FF};
+  for (int i = 0; i < 4; ++i) {
+    x[i] |= x[i] >> 8;
+    x[i] &= 0x0000FFFF0000FFFF;
+    w[i] = static_cast<uint32_t>(x[i]) | static_cast<uint32_t>(x[i] >> 16);
+  }
+}
+
+// Exchanges the bits selected by `high_mask` in `x` with the bits selected by
+// `low_mask` in `y`; `shift` is the distance between them.
+inline void SwapBits(uint64_t& x, uint64_t& y, uint64_t low_mask,
+                     uint64_t high_mask, int shift) {
+  const uint64_t a = x;
+  const uint64_t b = y;
+  x = (a & low_mask) | ((b & low_mask) << shift);
+  y = ((a & high_mask) >> shift) | (b & high_mask);
+}
+
+// Transposes the bits of the state between the interleaved byte order and the
+// bitsliced order. The transformation is its own inverse.
+void Ortho(BitslicedState& q) {
+  for (int i = 0; i < 8; i += 2) {
+    SwapBits(q[i], q[i + 1], 0x5555555555555555, 0xAAAAAAAAAAAAAAAA, 1);
+  }
+  for (int i : {0, 1, 4, 5}) {
+    SwapBits(q[i], q[i + 2], 0x3333333333333333, 0xCCCCCCCCCCCCCCCC, 2);
+  }
+  for (int i = 0; i < 4; ++i) {
+    SwapBits(q[i], q[i + 4], 0x0F0F0F0F0F0F0F0F, 0xF0F0F0F0F0F0F0F0, 4);
+  }
+}
+
+// Converts BATCH_BLOCKS blocks from `input` into the bitsliced state `q`.
+void LoadBatch(const uint8_t* input, BitslicedState& q) {
+  for (int i = 0; i < BitslicedAesEngine::BATCH_BLOCKS; ++i) {
+    const uint8_t* block = input + i * AesState::SIZE_BYTES;
+    std::array<uint32_t, AesState::SIZE_WORDS> w = {
+        LoadWord(block), LoadWord(block + 4), LoadWord(block + 8),
+        LoadWord(block + 12)};
+    InterleaveIn(w.data(), q[i], q[i + 4]);
+  }
+  Ortho(q);
+}
+
+// Converts the bitsliced state `q` back into BATCH_BLOCKS blocks in `output`.
+void StoreBatch(BitslicedState& q, uint8_t* output) {
+  Ortho(q);
+  for (int i = 0; i < BitslicedAesEngine::BATCH_BLOCKS; ++i) {
+    uint8_t* block = output + i * AesState::SIZE_BYTES;
+    std::array<uint32_t, AesState::SIZE_WORDS> w;
+    InterleaveOut(q[i], q[i + 4], w.data());
+    for (int j = 0; j < AesState::SIZE_WORDS; ++j) {
+      StoreWord(w[j], block + j * WORD_SIZE);
+    }
+  }
+}
+
+// Converts the round keys of `key_schedule` into the bitsliced representation,
+// replicating each round key across every block of a batch.
+void ExpandKeySchedule(const AesKeySchedule& key_schedule,
+                       BitslicedKeySchedule& bitsliced_keys) {
+  for (size_t round = 0; round <= key_schedule.rounds(); ++round) {
+    const uint8_t* round_key = key_schedule.RoundKey(round).data();
+    std::array<uint32_t, AesState::SIZE_WORDS> w = {
+        LoadWord(round_key), LoadWord(round_key + 4), LoadWord(round_key + 8),
+        LoadWord(round_key + 12)};
+
+    BitslicedState& q = bitsliced_keys[round];
+    InterleaveIn(w.data(), q[0], q[4]);
+    for (int i = 1; i < 4; ++i) {
+      q[i] = q[0];
+      q[i + 4] = q[4];
+    }
+    Ortho(q);
+  }
+}
+
+// Applies the S-box to every byte of the state with the 113 gate circuit of
+// Boyar and Peralta.
+void SubstituteBytes(BitslicedState& q) {
+  const uint64_t x0 = q[7];
+  const uint64_t x1 = q[6];
+  const uint64_t x2 = q[5];
+  const uint64_t x3 = q[4];
+  const uint64_t x4 = q[3];
+  const uint64_t x5 = q[2];
+  const uint64_t x6 = q[1];
+  const uint64_t x7 = q[0];
+
+  // Top linear transformation.
+  const uint64_t y14 = x3 ^ x5;
+  const uint64_t y13 = x0 ^ x6;
+  const uint64_t y9 = x0 ^ x3;
+  const uint64_t y8 = x0 ^ x5;
+  const uint64_t t0 = x1 ^ x2;
+  const uint64_t y1 = t0 ^ x7;
+  const uint64_t y4 = y1 ^ x3;
+  const uint64_t y12 = y13 ^ y14;
+  const uint64_t y2 = y1 ^ x0;
+  const uint64_t y5 = y1 ^ x6;
+  const uint64_t y3 = y5 ^ y8;
+  const uint64_t t1 = x4 ^ y12;
+  const uint64_t y15 = t1 ^ x5;
+  const uint64_t y20 = t1 ^ x1;
+  const uint64_t y6 = y15 ^ x7;
+  const uint64_t y10 = y15 ^ t0;
+  const uint64_t y11 = y20 ^ y9;
+  const uint64_t y7 = x7 ^ y11;
+  const uint64_t y17 = y10 ^ y11;
+  const uint64_t y19 = y10 ^ y8;
+  const uint64_t y16 = t0 ^ y11;
+  const uint64_t y21 = y13 ^ y16;
+  const uint64_t y18 = x0 ^ y16;
+
+  // Non-linear section.
+  const uint64_t t2 = y12 & y15;
+  const uint64_t t3 = y3 & y6;
+  const uint64_t t4 = t3 ^ t2;
+  const uint64_t t5 = y4 & x7;
+  const uint64_t t6 = t5 ^ t2;
+  const uint64_t t7 = y13 & y16;
+  const uint64_t t8 = y5 & y1;
+  const uint64_t t9 = t8 ^ t7;
+  const uint64_t t10 = y2 & y7;
+  const uint64_t t11 = t10 ^ t7;
+  const uint64_t t12 = y9 & y11;
+  const uint64_t t13 = y14 & y17;
+  const uint64_t t14 = t13 ^ t12;
+  const uint64_t t15 = y8 & y10;
+  const uint64_t t16 = t15 ^ t12;
+  const uint64_t t17 = t4 ^ t14;
+  const uint64_t t18 = t6 ^ t16;
+  const uint64_t t19 = t9 ^ t14;
+  const uint64_t t20 = t11 ^ t16;
+  const uint64_t t21 = t17 ^ y20;
+  const uint64_t t22 = t18 ^ y19;
+  const uint64_t t23 = t19 ^ y21;
+  const uint64_t t24 = t20 ^ y18;
+
+  const uint64_t t25 = t21 ^ t22;
+  const uint64_t t26 = t21 & t23;
+  const uint64_t t27 = t24 ^ t26;
+  const uint64_t t28 = t25 & t27;
+  const uint64_t t29 = t28 ^ t22;
+  const uint64_t t30 = t23 ^ t24;
+  const uint64_t t31 = t22 ^ t26;
+  const uint64_t t32 = t31 & t30;
+  const uint64_t t33 = t32 ^ t24;
+  const uint64_t t34 = t23 ^ t33;
+  const uint64_t t35 = t27 ^ t33;
+  const uint64_t t36 = t24 & t35;
+  const uint64_t t37 = t36 ^ t34;
+  const uint64_t t38 = t27 ^ t36;
+  const uint64_t t39 = t29 & t38;
+  const uint64_t t40 = t25 ^ t39;
+
+  const uint64_t t41 = t40 ^ t37;
+  const uint64_t t42 = t29 ^ t33;
+  const uint64_t t43 = t29 ^ t40;
+  const uint64_t t44 = t33 ^ t37;
+  const uint64_t t45 = t42 ^ t41;
+  const uint64_t z0 = t44 & y15;
+  const uint64_t z1 = t37 & y6;
+  const uint64_t z2 = t33 & x7;
+  const uint64_t z3 = t43 & y16;
+  const uint64_t z4 = t40 & y1;
+  const uint64_t z5 = t29 & y7;
+  const uint64_t z6 = t42 & y11;
+  const uint64_t z7 = t45 & y17;
+  const uint64_t z8 = t41 & y10;
+  const uint64_t z9 = t44 & y12;
+  const uint64_t z10 = t37 & y3;
+  const uint64_t z11 = t33 & y4;
+  const uint64_t z12 = t43 & y13;
+  const uint64_t z13 = t40 & y5;
+  const uint64_t z14 = t29 & y2;
+  const uint64_t z15 = t42 & y9;
+  const uint64_t z16 = t45 & y14;
+  const uint64_t z17 = t41 & y8;
+
+  // Bottom linear transformation.
+  const uint64_t t46 = z15 ^ z16;
+  const uint64_t t47 = z10 ^ z11;
+  const uint64_t t48 = z5 ^ z13;
+  const uint64_t t49 = z9 ^ z10;
+  const uint64_t t50 = z2 ^ z12;
+  const uint64_t t51 = z2 ^ z5;
+  const uint64_t t52 = z7 ^ z8;
+  const uint64_t t53 = z0 ^ z3;
+  const uint64_t t54 = z6 ^ z7;
+  const uint64_t t55 = z16 ^ z17;
+  const uint64_t t56 = z12 ^ t48;
+  const uint64_t t57 = t50 ^ t53;
+  const uint64_t t58 = z4 ^ t46;
+  const uint64_t t59 = z3 ^ t54;
+  const uint64_t t60 = t46 ^ t57;
+  const uint64_t t61 = z14 ^ t57;
+  const uint64_t t62 = t52 ^ t58;
+  const uint64_t t63 = t49 ^ t58;
+  const uint64_t t64 = z4 ^ t59;
+  const uint64_t t65 = t61 ^ t62;
+  const uint64_t t66 = z1 ^ t63;
+  const uint64_t s0 = t59 ^ t63;
+  const uint64_t s6 = t56 ^ ~t62;
+  const uint64_t s7 = t48 ^ ~t60;
+  const uint64_t t67 = t64 ^ t65;
+  const uint64_t s3 = t53 ^ t66;
+  const uint64_t s4 = t51 ^ t66;
+  const uint64_t s5 = t47 ^ t65;
+  const uint64_t s1 = t64 ^ ~s3;
+  const uint64_t s2 = t55 ^ ~t67;
+
+  q[7] = s0;
+  q[6] = s1;
+  q[5] = s2;
+  q[4] = s3;
+  q[3] = s4;
+  q[2] = s5;
+  q[1] = s6;
+  q[0] = s7;
+}
+
+// Computes y = A^-1(x ^ 0x63) on every byte of the state, where A is the
+// affine transformation of the S-box. InvSubstituteBytes() is built from it.
+void InvAffineTransform(BitslicedState& q) {
+  const uint64_t q0 = ~q[0];
+  const uint64_t q1 = ~q[1];
+  const uint64_t q2 = q[2];
+  const uint64_t q3 = q[3];
+  const uint64_t q4 = q[4];
+  const uint64_t q5 = ~q[5];
+  const uint64_t q6 = ~q[6];
+  const uint64_t q7 = q[7];
+  q[7] = q1 ^ q4 ^ q6;
+  q[6] = q0 ^ q3 ^ q5;
+  q[5] = q7 ^ q2 ^ q4;
+  q[4] = q6 ^ q1 ^ q3;
+  q[3] = q5 ^ q0 ^ q2;
+  q[2] = q4 ^ q7 ^ q1;
+  q[1] = q3 ^ q6 ^ q0;
+  q[0] = q2 ^ q5 ^ q7;
+}
+
+// Applies the inverse S-box to every byte of the state. The S-box is an
+// inversion in GF(2^8) followed by A and 0x63, so the inverse S-box is obtained
+// by undoing the affine step, applying the S-box and undoing it once more.
+void InvSubstituteBytes(BitslicedState& q) {
+  InvAffineTransform(q);
+  SubstituteBytes(q);
+  InvAffineTransform(q);
+}
+
+void ShiftRows(BitslicedState& q) {
+  for (uint64_t& x : q) {
+    x = (x & 0x000000000000FFFF) | ((x & 0x00000000FFF00000) >> 4) |
+        ((x & 0x00000000000F0000) << 12) | ((x & 0x0000FF0000000000) >> 8) |
+        ((x & 0x000000FF00000000) << 8) | ((x & 0xF000000000000000) >> 12) |
+        ((x & 0x0FFF000000000000) << 4);
+  }
+}
+
+void InvShiftRows(BitslicedState& q) {
+  for (uint64_t& x : q) {
+    x = (x & 0x000000000000FFFF) | ((x & 0x000000000FFF0000) << 4) |
+        ((x & 0x00000000F0000000) >> 12) | ((x & 0x000000FF00000000) << 8) |
+        ((x & 0x0000FF0000000000) >> 8) | ((x & 0x000F000000000000) << 12) |
+        ((x & 0xFFF0000000000000) >> 4);
+  }
+}
+
+// Rotates each column of the state by one row (16 bits) or by two rows
+// (32 bits).
+inline uint64_t RotateRow(uint64_t x) { return (x >> 16) | (x << 48); }
+inline uint64_t RotateTwoRows(uint64_t x) { return (x << 32) | (x >> 32); }
+
+// Multiplies each column by the matrix of section 5.1.3 of the AES spec. For
+// output bit plane i, `q` supplies row r, `r` supplies row r + 1 and
+// RotateTwoRows() supplies rows r + 2 and r + 3.
+void MixColumns(BitslicedState& q) {
+  const BitslicedState s = q;
+  BitslicedState r;
+  for (int i = 0; i < 8; ++i) {
+    r[i] = RotateRow(s[i]);
+  }
+
+  q[0] = s[7] ^ r[7] ^ r[0] ^ RotateTwoRows(s[0] ^ r[0]);
+  q[1] = s[0] ^ r[0] ^ s[7] ^ r[7] ^ r[1] ^ RotateTwoRows(s[1] ^ r[1]);
+  q[2] = s[1] ^ r[1] ^ r[2] ^ RotateTwoRows(s[2] ^ r[2]);
+  q[3] = s[2] ^ r[2] ^ s[7] ^ r[7] ^ r[3] ^ RotateTwoRows(s[3] ^ r[3]);
+  q[4] = s[3] ^ r[3] ^ s[7] ^ r[7] ^ r[4] ^ RotateTwoRows(s[4] ^ r[4]);
+  q[5] = s[4] ^ r[4] ^ r[5] ^ RotateTwoRows(s[5] ^ r[5]);
+  q[6] = s[5] ^ r[5] ^ r[6] ^ RotateTwoRows(s[6] ^ r[6]);
+  q[7] = s[6] ^ r[6] ^ r[7] ^ RotateTwoRows(s[7] ^ r[7]);
+}
+
+// Multiplies each column by the matrix of section 5.3.3 of the AES spec.
+void InvMixColumns(BitslicedState& q) {
+  const BitslicedState s = q;
+  BitslicedState r;
+  for (int i = 0; i < 8; ++i) {
+    r[i] = RotateRow(s[i]);
+  }
+
+  // clang-format off
+  q[0] = s[5] ^ s[6] ^ s[7] ^ r[0] ^ r[5] ^ r[7] ^
+         RotateTwoRows(s[0] ^ s[5] ^ s[6] ^ r[0] ^ r[5]);
+  q[1] = s[0] ^ s[5] ^ r[0] ^ r[1] ^ r[5] ^ r[6] ^ r[7] ^
+         RotateTwoRows(s[1] ^ s[5] ^ s[7] ^ r[1] ^ r[5] ^ r[6]);
+  q[2] = s[0] ^ s[1] ^ s[6] ^ r[1] ^ r[2] ^ r[6] ^ r[7] ^
+         RotateTwoRows(s[0] ^ s[2] ^ s[6] ^ r[2] ^ r[6] ^ r[7]);
+  q[3] = s[0] ^ s[1] ^ s[2] ^ s[5] ^ s[6] ^ r[0] ^ r[2] ^ r[3] ^ r[5] ^
+         RotateTwoRows(s[0] ^ s[1] ^ s[3] ^ s[5] ^ s[6] ^ s[7] ^ r[0] ^ r[3] ^ r[5] ^ r[7]);
+  q[4] = s[1] ^ s[2] ^ s[3] ^ s[5] ^ r[1] ^ r[3] ^ r[4] ^ r[5] ^ r[6] ^ r[7] ^
+         RotateTwoRows(s[1] ^ s[2] ^ s[4] ^ s[5] ^ s[7] ^ r[1] ^ r[4] ^ r[5] ^ r[6]);
+  q[5] = s[2] ^ s[3] ^ s[4] ^ s[6] ^ r[2] ^ r[4] ^ r[5] ^ r[6] ^ r[7] ^
+         RotateTwoRows(s[2] ^ s[3] ^ s[5] ^ s[6] ^ r[2] ^ r[5] ^ r[6] ^ r[7]);
+  q[6] = s[3] ^ s[4] ^ s[5] ^ s[7] ^ r[3] ^ r[5] ^ r[6] ^ r[7] ^
+         RotateTwoRows(s[3] ^ s[4] ^ s[6] ^ s[7] ^ r[3] ^ r[6] ^ r[7]);
+  q[7] = s[4] ^ s[5] ^ s[6] ^ r[4] ^ r[6] ^ r[7] ^
+         RotateTwoRows(s[4] ^ s[5] ^ s[7] ^ r[4] ^ r[7]);
+  // clang-format on
+}
+
+void AddRoundKey(BitslicedState& q, const BitslicedState& round_key) {
+  for (int i = 0; i < 8; ++i) {
+    q[i] ^= round_key[i];
+  }
+}
+
+void EncryptBatch(BitslicedState& q, const BitslicedKeySchedule& round_keys,
+                  size_t num_rounds) {
+  AddRoundKey(q, round_keys[0]);
+  for (size_t round = 1; round < num_rounds; ++round) {
+    SubstituteBytes(q);
+    ShiftRows(q);
+    MixColumns(q);
+    AddRoundKey(q, round_keys[round]);
+  }
+
+  // In the last round
+  SubstituteBytes(q);
+  ShiftRows(q);
+  AddRoundKey(q, round_keys[num_rounds]);
+}
+
+void DecryptBatch(BitslicedState& q, const BitslicedKeySchedule& round_keys,
+                  size_t num_rounds) {
+  AddRoundKey(q, round_keys[num_rounds]);
+  for (size_t round = num_rounds - 1; round > 0; --round) {
+    InvShiftRows(q);
+    InvSubstituteBytes(q);
+    AddRoundKey(q, round_keys[round]);
+    InvMixColumns(q);
+  }
+
+  // In the last round
+  InvShiftRows(q);
+  InvSubstituteBytes(q);
+  AddRoundKey(q, round_keys[0]);
+}
+
+// Applies `process_batch` to every batch of blocks in `input`. A final partial
+// batch is staged through a zero-padded buffer; only the size of the message
+// affects which path is taken.
+template <typename ProcessBatch>
+void ForEachBatch(std::span<const uint8_t> input, std::span<uint8_t> output,
+                  ProcessBatch&& process_batch) {
+  BitslicedState q;
+  size_t i = 0;
+  for (; i + BATCH_BYTES <= input.size(); i += BATCH_BYTES) {
+    LoadBatch(input.data() + i, q);
+    process_batch(q);
+    StoreBatch(q, output.data() + i);
+  }
+
+  if (i < input.size()) {
+    std::array<uint8_t, BATCH_BYTES> buffer = {0};
+    const size_t remaining = input.size() - i;
+    std::copy_n(input.begin() + i, remaining, buffer.begin());
+    LoadBatch(buffer.data(), q);
+    process_batch(q);
+    StoreBatch(q, buffer.data());
+    std::copy_n(buffer.begin(), remaining, output.begin() + i);
+  }
+}
+
+}  // namespace
+
+void BitslicedAesEngine::EncryptBlocks(std::span<const uint8_t> input,
+                                       const AesKeySchedule& key_schedule,
+                                       std::span<uint8_t> output) const {
+  BitslicedKeySchedule round_keys;
+  ExpandKeySchedule(key_schedule, round_keys);
+
+  ForEachBatch(input, output, [&](BitslicedState& q) {
+    EncryptBatch(q, round_keys, key_schedule.rounds());
+  });
+}
+
+void BitslicedAesEngine::DecryptBlocks(std::span<const uint8_t> input,
+                                       const AesKeySchedule& key_schedule,
+                                       std::span<uint8_t> output) const {
+  BitslicedKeySchedule round_keys;
+  ExpandKeySchedule(key_schedule, round_keys);
+
+  ForEachBatch(input, output, [&](BitslicedState& q) {
+    DecryptBatch(q, round_keys, key_schedule.rounds());
+  });
+}
+
+}  // namespace cryptopals::util
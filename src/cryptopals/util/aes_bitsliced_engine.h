@@ -0,0 +1,42 @@
+// DISCLAIMER: This algorithm is implemented for educational purposes only. By
+// no means is it guaranteed to be secure.
+#ifndef CRYPTOPALS_UTIL_AES_BITSLICED_ENGINE_H_
+#define CRYPTOPALS_UTIL_AES_BITSLICED_ENGINE_H_
+
+#include "cryptopals/util/aes_engine.h"
+
+namespace cryptopals::util {
+
+// An AES engine that stores the state of several blocks as eight 64-bit words,
+// where word i holds bit i of every byte of every block. The S-box is computed
+// with a fixed circuit of boolean operations instead of a table lookup, so the
+// engine runs in constant time: no memory access or branch depends on the key
+// or the data.
+//
+// Blocks are processed in batches of BATCH_BLOCKS. Messages that are not a
+// multiple of the batch size are padded internally, so the engine is most
+// efficient for large, multi-block messages.
+class BitslicedAesEngine : public AesEngineInterface {
+ public:
+  // The number of blocks encrypted in parallel.
+  static constexpr size_t BATCH_BLOCKS = 4;
+
+  // Implements backend from AesEngineInterface.
+  cryptopals::AesBackend backend() const override {
+    return cryptopals::AesBackend::BITSLICED;
+  }
+
+  // Implements EncryptBlocks from AesEngineInterface.
+  void EncryptBlocks(std::span<const uint8_t> input,
+                     const AesKeySchedule& key_schedule,
+                     std::span<uint8_t> output) const override;
+
+  // Implements DecryptBlocks from AesEngineInterface.
+  void DecryptBlocks(std::span<const uint8_t> input,
+                     const AesKeySchedule& key_schedule,
+                     std::span<uint8_t> output) const override;
+};
+
+}  // namespace cryptopals::util
+
+#endif  // CRYPTOPALS_UTIL_AES_BITSLICED_ENGINE_H_
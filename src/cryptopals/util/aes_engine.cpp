@@ -0,0 +1,54 @@
+// DISCLAIMER: This algorithm is implemented for educational purposes only. By
+// no means is it guaranteed to be secure.
+
+#include "cryptopals/util/aes_engine.h"
+
+#include "absl/status/status.h"
+#include "absl/status/status_macros.h"
+#include "cryptopals/util/aes_bitsliced_engine.h"
+#include "cryptopals/util/aes_ni_engine.h"
+#include "cryptopals/util/aes_reference_engine.h"
+#include "cryptopals/util/aes_ttable_engine.h"
+
+namespace cryptopals::util {
+namespace {
+
+// The engines are stateless, so a single instance of each is shared.
+const ReferenceAesEngine reference_engine;
+const TTableAesEngine ttable_engine;
+const AesNiEngine aes_ni_engine;
+const BitslicedAesEngine bitsliced_engine;
+
+}  // namespace
+
+absl::StatusOr<const AesEngineInterface*> GetAesEngine(
+    cryptopals::AesBackend backend) {
+  switch (backend) {
+    case cryptopals::AesBackend::REFERENCE:
+      return &reference_engine;
+    case cryptopals::AesBackend::T_TABLE:
+      return &ttable_engine;
+    case cryptopals::AesBackend::AES_NI:
+      if (!AesNiEngine::IsSupported()) {
+        return absl::FailedPreconditionError(
+            "AES-NI is not supported by this processor");
+      }
+      return &aes_ni_engine;
+    case cryptopals::AesBackend::BITSLICED:
+      return &bitsliced_engine;
+    default:
+      return absl::InvalidArgumentErrorBuilder()
+             << "Unsupported AES backend: " << AesBackend_Name(backend);
+  }
+}
+
+const AesEngineInterface& GetDefaultAesEngine() {
+  // Hardware support is detected once, at the first call.
+  static const AesEngineInterface* const default_engine =
+      AesNiEngine::IsSupported()
+          ? static_cast<const AesEngineInterface*>(&aes_ni_engine)
+          : static_cast<const AesEngineInterface*>(&ttable_engine);
+  return *default_engine;
+}
+
+}  // namespace cryptopals::util
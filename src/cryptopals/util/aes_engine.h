@@ -0,0 +1,55 @@
+// Interfaces for selecting the implementation of the AES block cipher. Several
+// engines implement the same block operations with different performance and
+// security tradeoffs; see cryptopals::AesBackend for the available choices.
+//
+// DISCLAIMER: This algorithm is implemented for educational purposes only. By
+// no means is it guaranteed to be secure.
+#ifndef CRYPTOPALS_UTIL_AES_ENGINE_H_
+#define CRYPTOPALS_UTIL_AES_ENGINE_H_
+
+#include <cstdint>
+#include <span>
+
+#include "absl/status/statusor.h"
+#include "cryptopals/proto/cryptopals_enums.pb.h"
+#include "cryptopals/util/aes.h"
+
+namespace cryptopals::util {
+
+// The AesEngineInterface class describes the public interface required for an
+// engine that computes AES block operations.
+class AesEngineInterface {
+ public:
+  virtual ~AesEngineInterface() {}
+
+  // Returns the backend that this engine implements.
+  virtual cryptopals::AesBackend backend() const = 0;
+
+  // Encrypts each block of `input` using `key_schedule` and writes the
+  // encrypted blocks to `output`. The size of `input` must be a multiple of
+  // AesState::SIZE_BYTES and `output` must be at least as large as `input`.
+  // `input` and `output` may refer to the same memory.
+  virtual void EncryptBlocks(std::span<const uint8_t> input,
+                             const AesKeySchedule& key_schedule,
+                             std::span<uint8_t> output) const = 0;
+
+  // Decrypts each block of `input` using `key_schedule` and writes the
+  // decrypted blocks to `output`. The same requirements as EncryptBlocks()
+  // apply to `input` and `output`.
+  virtual void DecryptBlocks(std::span<const uint8_t> input,
+                             const AesKeySchedule& key_schedule,
+                             std::span<uint8_t> output) const = 0;
+};
+
+// Returns the engine that implements `backend`. Returns an error status if the
+// backend is unknown or is not supported on this machine.
+absl::StatusOr<const AesEngineInterface*> GetAesEngine(
+    cryptopals::AesBackend backend);
+
+// Returns the fastest engine supported on this machine. This is the engine used
+// by EncryptBlock() and DecryptBlock().
+const AesEngineInterface& GetDefaultAesEngine();
+
+}  // namespace cryptopals::util
+
+#endif  // CRYPTOPALS_UTIL_AES_ENGINE_H_
@@ -0,0 +1,170 @@
+// DISCLAIMER: This algorithm is implemented for educational purposes only. By
+// no means is it guaranteed to be secure.
+
+#include "cryptopals/util/aes_ni_engine.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+#include "cryptopals/util/logging.h"
+
+namespace cryptopals::util {
+
+#if defined(__x86_64__) || defined(__i386__)
+
+namespace {
+
+// The number of independent blocks processed in each iteration. AESENC has a
+// latency of several cycles but can be issued every cycle, so interleaving
+// this many blocks keeps the unit busy. The loops over the blocks are unrolled
+// so that every block stays in a register.
+constexpr size_t PIPELINE_BLOCKS = 8;
+
+// The functions below are compiled for processors with AES-NI regardless of
+// the flags used for the rest of the build. They are only reached after
+// AesNiEngine::IsSupported() has been checked.
+
+// Loads the round keys for the cipher (or the equivalent inverse cipher when
+// `inverse` is set) from `key_schedule` into `round_keys`.
+__attribute__((target("aes"))) void LoadRoundKeys(
+    const AesKeySchedule& key_schedule, bool inverse, __m128i* round_keys) {
+  for (size_t round = 0; round <= key_schedule.rounds(); ++round) {
+    aes_block_span round_key = inverse ? key_schedule.InvRoundKey(round)
+                                       : key_schedule.RoundKey(round);
+    round_keys[round] =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(round_key.data()));
+  }
+}
+
+__attribute__((target("aes"))) void EncryptBlocksAesNi(
+    const uint8_t* input, const AesKeySchedule& key_schedule, uint8_t* output,
+    size_t num_blocks) {
+  const size_t num_rounds = key_schedule.rounds();
+  __m128i round_keys[AesKeySchedule::MAX_ROUNDS + 1];
+  LoadRoundKeys(key_schedule, /*inverse=*/false, round_keys);
+
+  const __m128i* in = reinterpret_cast<const __m128i*>(input);
+  __m128i* out = reinterpret_cast<__m128i*>(output);
+
+  size_t i = 0;
+  for (; i + PIPELINE_BLOCKS <= num_blocks; i += PIPELINE_BLOCKS) {
+    __m128i blocks[PIPELINE_BLOCKS];
+#pragma GCC unroll 8
+    for (size_t j = 0; j < PIPELINE_BLOCKS; ++j) {
+      blocks[j] = _mm_xor_si128(_mm_loadu_si128(in + i + j), round_keys[0]);
+    }
+    for (size_t round = 1; round < num_rounds; ++round) {
+#pragma GCC unroll 8
+      for (size_t j = 0; j < PIPELINE_BLOCKS; ++j) {
+        blocks[j] = _mm_aesenc_si128(blocks[j], round_keys[round]);
+      }
+    }
+#pragma GCC unroll 8
+    for (size_t j = 0; j < PIPELINE_BLOCKS; ++j) {
+      _mm_storeu_si128(
+          out + i + j,
+          _mm_aesenclast_si128(blocks[j], round_keys[num_rounds]));
+    }
+  }
+
+  // Encrypt any remaining blocks one at a time.
+  for (; i < num_blocks; ++i) {
+    __m128i block = _mm_xor_si128(_mm_loadu_si128(in + i), round_keys[0]);
+    for (size_t round = 1; round < num_rounds; ++round) {
+      block = _mm_aesenc_si128(block, round_keys[round]);
+    }
+    _mm_storeu_si128(out + i,
+                     _mm_aesenclast_si128(block, round_keys[num_rounds]));
+  }
+}
+
+__attribute__((target("aes"))) void DecryptBlocksAesNi(
+    const uint8_t* input, const AesKeySchedule& key_schedule, uint8_t* output,
+    size_t num_blocks) {
+  const size_t num_rounds = key_schedule.rounds();
+  __m128i round_keys[AesKeySchedule::MAX_ROUNDS + 1];
+  LoadRoundKeys(key_schedule, /*inverse=*/true, round_keys);
+
+  const __m128i* in = reinterpret_cast<const __m128i*>(input);
+  __m128i* out = reinterpret_cast<__m128i*>(output);
+
+  size_t i = 0;
+  for (; i + PIPELINE_BLOCKS <= num_blocks; i += PIPELINE_BLOCKS) {
+    __m128i blocks[PIPELINE_BLOCKS];
+#pragma GCC unroll 8
+    for (size_t j = 0; j < PIPELINE_BLOCKS; ++j) {
+      blocks[j] =
+          _mm_xor_si128(_mm_loadu_si128(in + i + j), round_keys[num_rounds]);
+    }
+    for (size_t round = num_rounds - 1; round > 0; --round) {
+#pragma GCC unroll 8
+      for (size_t j = 0; j < PIPELINE_BLOCKS; ++j) {
+        blocks[j] = _mm_aesdec_si128(blocks[j], round_keys[round]);
+      }
+    }
+#pragma GCC unroll 8
+    for (size_t j = 0; j < PIPELINE_BLOCKS; ++j) {
+      _mm_storeu_si128(out + i + j,
+                       _mm_aesdeclast_si128(blocks[j], round_keys[0]));
+    }
+  }
+
+  // Decrypt any remaining blocks one at a time.
+  for (; i < num_blocks; ++i) {
+    __m128i block =
+        _mm_xor_si128(_mm_loadu_si128(in + i), round_keys[num_rounds]);
+    for (size_t round = num_rounds - 1; round > 0; --round) {
+      block = _mm_aesdec_si128(block, round_keys[round]);
+    }
+    _mm_storeu_si128(out + i, _mm_aesdeclast_si128(block, round_keys[0]));
+  }
+}
+
+}  // namespace
+
+bool AesNiEngine::IsSupported() {
+  static const bool is_supported = []() {
+    unsigned int eax, ebx, ecx, edx;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+      return false;
+    }
+    return (ecx & bit_AES) != 0 && (edx & bit_SSE2) != 0;
+  }();
+  return is_supported;
+}
+
+void AesNiEngine::EncryptBlocks(std::span<const uint8_t> input,
+                                const AesKeySchedule& key_schedule,
+                                std::span<uint8_t> output) const {
+  EncryptBlocksAesNi(input.data(), key_schedule, output.data(),
+                     input.size() / AesState::SIZE_BYTES);
+}
+
+void AesNiEngine::DecryptBlocks(std::span<const uint8_t> input,
+                                const AesKeySchedule& key_schedule,
+                                std::span<uint8_t> output) const {
+  DecryptBlocksAesNi(input.data(), key_schedule, output.data(),
+                     input.size() / AesState::SIZE_BYTES);
+}
+
+#else  // defined(__x86_64__) || defined(__i386__)
+
+bool AesNiEngine::IsSupported() { return false; }
+
+void AesNiEngine::EncryptBlocks(std::span<const uint8_t> input,
+                                const AesKeySchedule& key_schedule,
+                                std::span<uint8_t> output) const {
+  LOG(FATAL) << "AES-NI is not supported on this architecture";
+}
+
+void AesNiEngine::DecryptBlocks(std::span<const uint8_t> input,
+                                const AesKeySchedule& key_schedule,
+                                std::span<uint8_t> output) const {
+  LOG(FATAL) << "AES-NI is not supported on this architecture";
+}
+
+#endif  // defined(__x86_64__) || defined(__i386__)
+
+}  // namespace cryptopals::util
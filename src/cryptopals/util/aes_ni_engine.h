@@ -0,0 +1,39 @@
+// DISCLAIMER: This algorithm is implemented for educational purposes only. By
+// no means is it guaranteed to be secure.
+#ifndef CRYPTOPALS_UTIL_AES_NI_ENGINE_H_
+#define CRYPTOPALS_UTIL_AES_NI_ENGINE_H_
+
+#include "cryptopals/util/aes_engine.h"
+
+namespace cryptopals::util {
+
+// An AES engine that uses the AES-NI instructions (AESENC, AESENCLAST, AESDEC
+// and AESDECLAST) available on x86 processors. Each round of the cipher is a
+// single instruction, so throughput is limited by the instruction latency; to
+// hide it, several independent blocks are processed in each iteration.
+//
+// The engine may only be used when IsSupported() returns true.
+class AesNiEngine : public AesEngineInterface {
+ public:
+  // Returns true if the processor supports the AES-NI instructions.
+  static bool IsSupported();
+
+  // Implements backend from AesEngineInterface.
+  cryptopals::AesBackend backend() const override {
+    return cryptopals::AesBackend::AES_NI;
+  }
+
+  // Implements EncryptBlocks from AesEngineInterface.
+  void EncryptBlocks(std::span<const uint8_t> input,
+                     const AesKeySchedule& key_schedule,
+                     std::span<uint8_t> output) const override;
+
+  // Implements DecryptBlocks from AesEngineInterface.
+  void DecryptBlocks(std::span<const uint8_t> input,
+                     const AesKeySchedule& key_schedule,
+                     std::span<uint8_t> output) const override;
+};
+
+}  // namespace cryptopals::util
+
+#endif  // CRYPTOPALS_UTIL_AES_NI_ENGINE_H_
@@ -0,0 +1,66 @@
+// DISCLAIMER: This algorithm is implemented for educational purposes only. By
+// no means is it guaranteed to be secure.
+
+#include "cryptopals/util/aes_reference_engine.h"
+
+#include <algorithm>
+
+namespace cryptopals::util {
+
+void ReferenceAesEngine::EncryptBlocks(std::span<const uint8_t> input,
+                                       const AesKeySchedule& key_schedule,
+                                       std::span<uint8_t> output) const {
+  const size_t num_rounds = key_schedule.rounds();
+
+  for (size_t i = 0; i < input.size(); i += AesState::SIZE_BYTES) {
+    // Initialize state
+    AesState state;
+    std::copy_n(input.begin() + i, AesState::SIZE_BYTES, state.bytes.begin());
+
+    AddRoundKey(state, key_schedule.RoundKey(0));
+
+    for (int round = 1; round < num_rounds; ++round) {
+      SubstituteBytes(state);
+      ShiftRows(state);
+      MixColumns(state);
+      AddRoundKey(state, key_schedule.RoundKey(round));
+    }
+
+    // In the last round
+    SubstituteBytes(state);
+    ShiftRows(state);
+    AddRoundKey(state, key_schedule.RoundKey(num_rounds));
+
+    std::copy_n(state.bytes.begin(), AesState::SIZE_BYTES, output.begin() + i);
+  }
+}
+
+void ReferenceAesEngine::DecryptBlocks(std::span<const uint8_t> input,
+                                       const AesKeySchedule& key_schedule,
+                                       std::span<uint8_t> output) const {
+  const size_t num_rounds = key_schedule.rounds();
+
+  for (size_t i = 0; i < input.size(); i += AesState::SIZE_BYTES) {
+    // Initialize state
+    AesState state;
+    std::copy_n(input.begin() + i, AesState::SIZE_BYTES, state.bytes.begin());
+
+    AddRoundKey(state, key_schedule.RoundKey(num_rounds));
+
+    for (int round = num_rounds - 1; round > 0; --round) {
+      InvShiftRows(state);
+      InvSubstituteBytes(state);
+      AddRoundKey(state, key_schedule.RoundKey(round));
+      InvMixColumns(state);
+    }
+
+    // In the last round
+    InvShiftRows(state);
+    InvSubstituteBytes(state);
+    AddRoundKey(state, key_schedule.RoundKey(0));
+
+    std::copy_n(state.bytes.begin(), AesState::SIZE_BYTES, output.begin() + i);
+  }
+}
+
+}  // namespace cryptopals::util
@@ -0,0 +1,33 @@
+// DISCLAIMER: This algorithm is implemented for educational purposes only. By
+// no means is it guaranteed to be secure.
+#ifndef CRYPTOPALS_UTIL_AES_REFERENCE_ENGINE_H_
+#define CRYPTOPALS_UTIL_AES_REFERENCE_ENGINE_H_
+
+#include "cryptopals/util/aes_engine.h"
+
+namespace cryptopals::util {
+
+// An AES engine that applies each step of the cipher to an AesState exactly as
+// it is described in the AES spec. It is the slowest engine, and exists as a
+// readable baseline to test the other engines against.
+class ReferenceAesEngine : public AesEngineInterface {
+ public:
+  // Implements backend from AesEngineInterface.
+  cryptopals::AesBackend backend() const override {
+    return cryptopals::AesBackend::REFERENCE;
+  }
+
+  // Implements EncryptBlocks from AesEngineInterface.
+  void EncryptBlocks(std::span<const uint8_t> input,
+                     const AesKeySchedule& key_schedule,
+                     std::span<uint8_t> output) const override;
+
+  // Implements DecryptBlocks from AesEngineInterface.
+  void DecryptBlocks(std::span<const uint8_t> input,
+                     const AesKeySchedule& key_schedule,
+                     std::span<uint8_t> output) const override;
+};
+
+}  // namespace cryptopals::util
+
+#endif  // CRYPTOPALS_UTIL_AES_REFERENCE_ENGINE_H_
@@ -1,7 +1,11 @@
 #include "cryptopals/util/aes.h"
 
 #include <algorithm>
+#include <random>
+#include <string_view>
+#include <tuple>
 
+#include "cryptopals/util/aes_engine.h"
 #include "cryptopals/util/bytes.h"
 #include "gmock/gmock.h"
 #include "googletest/status_matchers.h"
@@ -45,6 +49,22 @@ TEST(AesTest, GenerateKeySchedule) {
   EXPECT_EQ(generated_schedule, expected_schedule);
 }
 
+TEST(AesTest, AesKeySchedule) {
+  Bytes input_key = Bytes::CreateFromHex("2b7e151628aed2a6abf7158809cf4f3c");
+  ASSERT_OK_AND_ASSIGN(AesKeySchedule key_schedule,
+                       AesKeySchedule::Create(input_key));
+  EXPECT_EQ(key_schedule.rounds(), 10);
+  EXPECT_EQ(Bytes::CreateFromRange(key_schedule.RoundKey(1).begin(),
+                                   key_schedule.RoundKey(1).end()),
+            Bytes::CreateFromHex("a0fafe1788542cb123a339392a6c7605"));
+  EXPECT_EQ(Bytes::CreateFromRange(key_schedule.RoundKey(10).begin(),
+                                   key_schedule.RoundKey(10).end()),
+            Bytes::CreateFromHex("d014f9a8c9ee2589e13f0cc8b6630ca6"));
+
+  EXPECT_FALSE(AesKeySchedule::Create(Bytes::CreateFromHex("00")).ok());
+  EXPECT_FALSE(AesKeySchedule::Create(Bytes(20)).ok());
+}
+
 TEST(AesTest, EncryptBlockHelpers) {
   Bytes input_bytes_1 =
       Bytes::CreateFromHex("193de3bea0f4e22b9ac68d2ae9f84808");
@@ -136,6 +156,52 @@ TEST_P(Aes128Test, DecryptBlock) {
   EXPECT_EQ(decryption_result, Bytes::CreateFromHex(plaintext));
 }
 
+// This array stores the key, plaintext and ciphertext of the example vectors
+// from appendix C of the AES spec, which cover each of the supported key sizes.
+std::array<std::tuple<std::string_view, std::string_view, std::string_view>, 3>
+    aes_key_size_tests = {{
+        {"000102030405060708090a0b0c0d0e0f",
+         "00112233445566778899aabbccddeeff",
+         "69c4e0d86a7b0430d8cdb78070b4c55a"},
+        {"000102030405060708090a0b0c0d0e0f1011121314151617",
+         "00112233445566778899aabbccddeeff",
+         "dda97ca4864cdfe06eaf70a0ec0d7191"},
+        {"000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f",
+         "00112233445566778899aabbccddeeff",
+         "8ea2b7ca516745bfeafc49904b496089"},
+    }};
+
+class AesKeySizeTest
+    : public testing::TestWithParam<
+          std::tuple<std::string_view, std::string_view, std::string_view>> {
+ public:
+};
+
+TEST_P(AesKeySizeTest, EncryptBlock) {
+  auto [key, plaintext, ciphertext] = GetParam();
+  ASSERT_OK_AND_ASSIGN(AesKeySchedule key_schedule,
+                       AesKeySchedule::Create(Bytes::CreateFromHex(key)));
+
+  Bytes block = Bytes::CreateFromHex(plaintext);
+  EncryptBlock(aes_block_span{block.begin(), block.size()}, key_schedule,
+               aes_mutable_block_span{block.begin(), block.size()});
+  EXPECT_EQ(block, Bytes::CreateFromHex(ciphertext));
+}
+
+TEST_P(AesKeySizeTest, DecryptBlock) {
+  auto [key, plaintext, ciphertext] = GetParam();
+  ASSERT_OK_AND_ASSIGN(AesKeySchedule key_schedule,
+                       AesKeySchedule::Create(Bytes::CreateFromHex(key)));
+
+  Bytes block = Bytes::CreateFromHex(ciphertext);
+  DecryptBlock(aes_block_span{block.begin(), block.size()}, key_schedule,
+               aes_mutable_block_span{block.begin(), block.size()});
+  EXPECT_EQ(block, Bytes::CreateFromHex(plaintext));
+}
+
+INSTANTIATE_TEST_SUITE_P(AesKeySizeParameterized, AesKeySizeTest,
+                         testing::ValuesIn(aes_key_size_tests));
+
 // This array stores a series of plaintext and ciphertext blocks encrypted with
 // the 128-bit key of all 0s.
 std::array<std::pair<std::string_view, std::string_view>, 128> aes128_tests = {{
@@ -272,4 +338,114 @@ std::array<std::pair<std::string_view, std::string_view>, 128> aes128_tests = {{
 INSTANTIATE_TEST_SUITE_P(Aes128Parameterized, Aes128Test,
                          testing::ValuesIn(aes128_tests));
 
+// Tests every AES engine against the vectors above, and against the reference
+// engine for longer messages. Engines that are not supported on this machine
+// are skipped.
+class AesEngineTest : public testing::TestWithParam<cryptopals::AesBackend> {
+ protected:
+  void SetUp() override {
+    absl::StatusOr<const AesEngineInterface*> engine = GetAesEngine(GetParam());
+    if (!engine.ok()) {
+      GTEST_SKIP() << engine.status();
+    }
+    engine_ = engine.value();
+  }
+
+  const AesEngineInterface* engine_ = nullptr;
+};
+
+TEST_P(AesEngineTest, Aes128Vectors) {
+  ASSERT_OK_AND_ASSIGN(
+      AesKeySchedule key_schedule,
+      AesKeySchedule::Create(
+          Bytes::CreateFromHex("00000000000000000000000000000000")));
+
+  for (auto [plaintext, ciphertext] : aes128_tests) {
+    Bytes plain_bytes = Bytes::CreateFromHex(plaintext);
+    Bytes cipher_bytes = Bytes::CreateFromHex(ciphertext);
+    Bytes output(AesState::SIZE_BYTES);
+
+    engine_->EncryptBlocks({plain_bytes.begin(), plain_bytes.size()},
+                           key_schedule, {output.begin(), output.size()});
+    EXPECT_EQ(output, cipher_bytes) << plaintext;
+
+    engine_->DecryptBlocks({cipher_bytes.begin(), cipher_bytes.size()},
+                           key_schedule, {output.begin(), output.size()});
+    EXPECT_EQ(output, plain_bytes) << ciphertext;
+  }
+}
+
+TEST_P(AesEngineTest, KeySizeVectors) {
+  for (auto [key, plaintext, ciphertext] : aes_key_size_tests) {
+    ASSERT_OK_AND_ASSIGN(AesKeySchedule key_schedule,
+                         AesKeySchedule::Create(Bytes::CreateFromHex(key)));
+    Bytes plain_bytes = Bytes::CreateFromHex(plaintext);
+    Bytes cipher_bytes = Bytes::CreateFromHex(ciphertext);
+    Bytes output(AesState::SIZE_BYTES);
+
+    engine_->EncryptBlocks({plain_bytes.begin(), plain_bytes.size()},
+                           key_schedule, {output.begin(), output.size()});
+    EXPECT_EQ(output, cipher_bytes) << key;
+
+    engine_->DecryptBlocks({cipher_bytes.begin(), cipher_bytes.size()},
+                           key_schedule, {output.begin(), output.size()});
+    EXPECT_EQ(output, plain_bytes) << key;
+  }
+}
+
+TEST_P(AesEngineTest, MatchesReferenceEngine) {
+  ASSERT_OK_AND_ASSIGN(const AesEngineInterface* reference_engine,
+                       GetAesEngine(cryptopals::AesBackend::REFERENCE));
+  std::mt19937 generator(/*seed=*/197);
+  std::uniform_int_distribution<int> distribution(0, 255);
+  auto random_bytes = [&](size_t size) {
+    Bytes bytes(size);
+    std::generate(bytes.begin(), bytes.end(),
+                  [&]() { return distribution(generator); });
+    return bytes;
+  };
+
+  // An odd number of blocks exercises any partial batches in the engine.
+  constexpr size_t num_blocks = 67;
+  for (size_t key_size : {16, 24, 32}) {
+    ASSERT_OK_AND_ASSIGN(AesKeySchedule key_schedule,
+                         AesKeySchedule::Create(random_bytes(key_size)));
+    Bytes input = random_bytes(num_blocks * AesState::SIZE_BYTES);
+    Bytes expected(input.size());
+    Bytes output(input.size());
+
+    reference_engine->EncryptBlocks({input.begin(), input.size()},
+                                    key_schedule,
+                                    {expected.begin(), expected.size()});
+    engine_->EncryptBlocks({input.begin(), input.size()}, key_schedule,
+                           {output.begin(), output.size()});
+    EXPECT_EQ(output, expected) << key_size;
+
+    reference_engine->DecryptBlocks({input.begin(), input.size()},
+                                    key_schedule,
+                                    {expected.begin(), expected.size()});
+    engine_->DecryptBlocks({input.begin(), input.size()}, key_schedule,
+                           {output.begin(), output.size()});
+    EXPECT_EQ(output, expected) << key_size;
+
+    // Encrypt and decrypt in place.
+    output = input;
+    engine_->EncryptBlocks({output.begin(), output.size()}, key_schedule,
+                           {output.begin(), output.size()});
+    engine_->DecryptBlocks({output.begin(), output.size()}, key_schedule,
+                           {output.begin(), output.size()});
+    EXPECT_EQ(output, input) << key_size;
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    AesEngineParameterized, AesEngineTest,
+    testing::Values(cryptopals::AesBackend::REFERENCE,
+                    cryptopals::AesBackend::T_TABLE,
+                    cryptopals::AesBackend::AES_NI,
+                    cryptopals::AesBackend::BITSLICED),
+    [](const testing::TestParamInfo<cryptopals::AesBackend>& info) {
+      return cryptopals::AesBackend_Name(info.param);
+    });
+
 }  // namespace cryptopals::util
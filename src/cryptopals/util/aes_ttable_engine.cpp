@@ -0,0 +1,192 @@
+// DISCLAIMER: This algorithm is implemented for educational purposes only. By
+// no means is it guaranteed to be secure.
+
+#include "cryptopals/util/aes_ttable_engine.h"
+
+#include <array>
+#include <bit>
+#include <cstdint>
+
+#include "cryptopals/util/aes_sbox.h"
+
+namespace cryptopals::util {
+namespace {
+
+typedef std::array<uint32_t, 256> TTable;
+
+// The state and round keys are handled as four 32-bit columns. Row 0 of a
+// column is stored in the least significant byte of the word, which keeps the
+// conversion between bytes and words independent of the host byte order.
+inline constexpr uint32_t PackColumn(uint8_t row0, uint8_t row1, uint8_t row2,
+                                     uint8_t row3) {
+  return static_cast<uint32_t>(row0) | static_cast<uint32_t>(row1) << 8 |
+         static_cast<uint32_t>(row2) << 16 | static_cast<uint32_t>(row3) << 24;
+}
+
+inline uint32_t LoadColumn(const uint8_t* input) {
+  return PackColumn(input[0], input[1], input[2], input[3]);
+}
+
+inline void StoreColumn(uint32_t column, uint8_t* output) {
+  output[0] = column;
+  output[1] = column >> 8;
+  output[2] = column >> 16;
+  output[3] = column >> 24;
+}
+
+// Returns the byte of `column` in `row`.
+inline constexpr uint8_t Row(uint32_t column, int row) {
+  return column >> (8 * row);
+}
+
+// Builds the table that maps a byte in `row` of the input state to its
+// contribution to a column of the output state. The mixing matrices are
+// circulant, so the table for each row is the table for row 0 rotated by one
+// byte per row.
+constexpr TTable MakeEncryptTable(int row) {
+  TTable table = {0};
+  for (int i = 0; i < table.size(); ++i) {
+    const uint8_t s = aes_encrypt_sub[i];
+    table[i] = std::rotl(PackColumn(mul(s, 2), s, s, mul(s, 3)), 8 * row);
+  }
+  return table;
+}
+
+constexpr TTable MakeDecryptTable(int row) {
+  TTable table = {0};
+  for (int i = 0; i < table.size(); ++i) {
+    const uint8_t s = aes_decrypt_sub[i];
+    table[i] = std::rotl(
+        PackColumn(mul(s, 0xe), mul(s, 0x9), mul(s, 0xd), mul(s, 0xb)),
+        8 * row);
+  }
+  return table;
+}
+
+constexpr std::array<TTable, 4> encrypt_tables = {
+    MakeEncryptTable(0), MakeEncryptTable(1), MakeEncryptTable(2),
+    MakeEncryptTable(3)};
+constexpr std::array<TTable, 4> decrypt_tables = {
+    MakeDecryptTable(0), MakeDecryptTable(1), MakeDecryptTable(2),
+    MakeDecryptTable(3)};
+
+// Computes SubBytes, ShiftRows and MixColumns for one output column. ShiftRows
+// moves row r of column (c + r) into column c, so `s0` through `s3` are the
+// input columns c, c + 1, c + 2 and c + 3.
+inline uint32_t EncryptColumn(uint32_t s0, uint32_t s1, uint32_t s2,
+                              uint32_t s3) {
+  return encrypt_tables[0][Row(s0, 0)] ^ encrypt_tables[1][Row(s1, 1)] ^
+         encrypt_tables[2][Row(s2, 2)] ^ encrypt_tables[3][Row(s3, 3)];
+}
+
+// Computes SubBytes and ShiftRows (without MixColumns) for one output column.
+inline uint32_t EncryptFinalColumn(uint32_t s0, uint32_t s1, uint32_t s2,
+                                   uint32_t s3) {
+  return PackColumn(aes_encrypt_sub[Row(s0, 0)], aes_encrypt_sub[Row(s1, 1)],
+                    aes_encrypt_sub[Row(s2, 2)], aes_encrypt_sub[Row(s3, 3)]);
+}
+
+// Computes InvSubBytes, InvShiftRows and InvMixColumns for one output column.
+// InvShiftRows moves row r of column (c - r) into column c, so `s0` through
+// `s3` are the input columns c, c - 1, c - 2 and c - 3.
+inline uint32_t DecryptColumn(uint32_t s0, uint32_t s1, uint32_t s2,
+                              uint32_t s3) {
+  return decrypt_tables[0][Row(s0, 0)] ^ decrypt_tables[1][Row(s1, 1)] ^
+         decrypt_tables[2][Row(s2, 2)] ^ decrypt_tables[3][Row(s3, 3)];
+}
+
+// Computes InvSubBytes and InvShiftRows (without InvMixColumns) for one output
+// column.
+inline uint32_t DecryptFinalColumn(uint32_t s0, uint32_t s1, uint32_t s2,
+                                   uint32_t s3) {
+  return PackColumn(aes_decrypt_sub[Row(s0, 0)], aes_decrypt_sub[Row(s1, 1)],
+                    aes_decrypt_sub[Row(s2, 2)], aes_decrypt_sub[Row(s3, 3)]);
+}
+
+void EncryptBlock(const uint8_t* input, const AesKeySchedule& key_schedule,
+                  uint8_t* output) {
+  const size_t num_rounds = key_schedule.rounds();
+  const uint8_t* round_key = key_schedule.RoundKey(0).data();
+
+  uint32_t s0 = LoadColumn(input) ^ LoadColumn(round_key);
+  uint32_t s1 = LoadColumn(input + 4) ^ LoadColumn(round_key + 4);
+  uint32_t s2 = LoadColumn(input + 8) ^ LoadColumn(round_key + 8);
+  uint32_t s3 = LoadColumn(input + 12) ^ LoadColumn(round_key + 12);
+
+  for (int round = 1; round < num_rounds; ++round) {
+    round_key += AesState::SIZE_BYTES;
+    uint32_t t0 = EncryptColumn(s0, s1, s2, s3) ^ LoadColumn(round_key);
+    uint32_t t1 = EncryptColumn(s1, s2, s3, s0) ^ LoadColumn(round_key + 4);
+    uint32_t t2 = EncryptColumn(s2, s3, s0, s1) ^ LoadColumn(round_key + 8);
+    uint32_t t3 = EncryptColumn(s3, s0, s1, s2) ^ LoadColumn(round_key + 12);
+    s0 = t0;
+    s1 = t1;
+    s2 = t2;
+    s3 = t3;
+  }
+
+  // In the last round
+  round_key += AesState::SIZE_BYTES;
+  StoreColumn(EncryptFinalColumn(s0, s1, s2, s3) ^ LoadColumn(round_key),
+              output);
+  StoreColumn(EncryptFinalColumn(s1, s2, s3, s0) ^ LoadColumn(round_key + 4),
+              output + 4);
+  StoreColumn(EncryptFinalColumn(s2, s3, s0, s1) ^ LoadColumn(round_key + 8),
+              output + 8);
+  StoreColumn(EncryptFinalColumn(s3, s0, s1, s2) ^ LoadColumn(round_key + 12),
+              output + 12);
+}
+
+void DecryptBlock(const uint8_t* input, const AesKeySchedule& key_schedule,
+                  uint8_t* output) {
+  const size_t num_rounds = key_schedule.rounds();
+  const uint8_t* round_key = key_schedule.InvRoundKey(num_rounds).data();
+
+  uint32_t s0 = LoadColumn(input) ^ LoadColumn(round_key);
+  uint32_t s1 = LoadColumn(input + 4) ^ LoadColumn(round_key + 4);
+  uint32_t s2 = LoadColumn(input + 8) ^ LoadColumn(round_key + 8);
+  uint32_t s3 = LoadColumn(input + 12) ^ LoadColumn(round_key + 12);
+
+  for (int round = num_rounds - 1; round > 0; --round) {
+    round_key -= AesState::SIZE_BYTES;
+    uint32_t t0 = DecryptColumn(s0, s3, s2, s1) ^ LoadColumn(round_key);
+    uint32_t t1 = DecryptColumn(s1, s0, s3, s2) ^ LoadColumn(round_key + 4);
+    uint32_t t2 = DecryptColumn(s2, s1, s0, s3) ^ LoadColumn(round_key + 8);
+    uint32_t t3 = DecryptColumn(s3, s2, s1, s0) ^ LoadColumn(round_key + 12);
+    s0 = t0;
+    s1 = t1;
+    s2 = t2;
+    s3 = t3;
+  }
+
+  // In the last round
+  round_key -= AesState::SIZE_BYTES;
+  StoreColumn(DecryptFinalColumn(s0, s3, s2, s1) ^ LoadColumn(round_key),
+              output);
+  StoreColumn(DecryptFinalColumn(s1, s0, s3, s2) ^ LoadColumn(round_key + 4),
+              output + 4);
+  StoreColumn(DecryptFinalColumn(s2, s1, s0, s3) ^ LoadColumn(round_key + 8),
+              output + 8);
+  StoreColumn(DecryptFinalColumn(s3, s2, s1, s0) ^ LoadColumn(round_key + 12),
+              output + 12);
+}
+
+}  // namespace
+
+void TTableAesEngine::EncryptBlocks(std::span<const uint8_t> input,
+                                    const AesKeySchedule& key_schedule,
+                                    std::span<uint8_t> output) const {
+  for (size_t i = 0; i < input.size(); i += AesState::SIZE_BYTES) {
+    EncryptBlock(input.data() + i, key_schedule, output.data() + i);
+  }
+}
+
+void TTableAesEngine::DecryptBlocks(std::span<const uint8_t> input,
+                                    const AesKeySchedule& key_schedule,
+                                    std::span<uint8_t> output) const {
+  for (size_t i = 0; i < input.size(); i += AesState::SIZE_BYTES) {
+    DecryptBlock(input.data() + i, key_schedule, output.data() + i);
+  }
+}
+
+}  // namespace cryptopals::util
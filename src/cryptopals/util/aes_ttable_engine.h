@@ -0,0 +1,37 @@
+// DISCLAIMER: This algorithm is implemented for educational purposes only. By
+// no means is it guaranteed to be secure.
+#ifndef CRYPTOPALS_UTIL_AES_TTABLE_ENGINE_H_
+#define CRYPTOPALS_UTIL_AES_TTABLE_ENGINE_H_
+
+#include "cryptopals/util/aes_engine.h"
+
+namespace cryptopals::util {
+
+// An AES engine that operates on the state as four 32-bit columns. SubBytes,
+// ShiftRows and MixColumns are merged into four 1 KiB lookup tables per
+// direction, so that each round costs 16 table lookups and a handful of XORs.
+// The tables are generated at compile time from the S-boxes and mul().
+//
+// Note that the table lookups are indexed by secret data, so this engine is
+// susceptible to cache-timing attacks.
+class TTableAesEngine : public AesEngineInterface {
+ public:
+  // Implements backend from AesEngineInterface.
+  cryptopals::AesBackend backend() const override {
+    return cryptopals::AesBackend::T_TABLE;
+  }
+
+  // Implements EncryptBlocks from AesEngineInterface.
+  void EncryptBlocks(std::span<const uint8_t> input,
+                     const AesKeySchedule& key_schedule,
+                     std::span<uint8_t> output) const override;
+
+  // Implements DecryptBlocks from AesEngineInterface.
+  void DecryptBlocks(std::span<const uint8_t> input,
+                     const AesKeySchedule& key_schedule,
+                     std::span<uint8_t> output) const override;
+};
+
+}  // namespace cryptopals::util
+
+#endif  // CRYPTOPALS_UTIL_AES_TTABLE_ENGINE_H_
@@ -0,0 +1,116 @@
+#ifndef CRYPTOPALS_UTIL_BOUNDED_QUEUE_H_
+#define CRYPTOPALS_UTIL_BOUNDED_QUEUE_H_
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace cryptopals::util {
+
+// A fixed-capacity FIFO queue that any number of threads can push to and pop
+// from without taking a lock. Every push and pop claims a ticket with a single
+// atomic increment, which assigns it a slot and a turn on that slot. A thread
+// only blocks, sleeping on the slot's sequence number rather than spinning,
+// when its slot is not ready: that is, when the queue is full for a push or
+// empty for a pop.
+template <typename T>
+class BoundedQueue {
+ public:
+  // Holds at least `capacity` values. The capacity is rounded up to a power of
+  // two, and to at least two so that a slot's turns to push and to pop differ.
+  explicit BoundedQueue(size_t capacity)
+      : capacity_(std::bit_ceil(std::max<size_t>(capacity, 2))),
+        slots_(capacity_) {
+    for (size_t i = 0; i < capacity_; ++i) {
+      slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  BoundedQueue(const BoundedQueue&) = delete;
+  BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+  // Appends `value`, waiting for room if the queue is full.
+  void Push(T value) {
+    const size_t ticket = tail_.fetch_add(1, std::memory_order_relaxed);
+    Slot& slot = slots_[ticket & (capacity_ - 1)];
+    WaitForSequence(slot, ticket);
+    slot.value = std::move(value);
+    Release(slot, ticket + 1);
+  }
+
+  // Removes and returns the oldest value, waiting for one if the queue is
+  // empty.
+  T Pop() {
+    const size_t ticket = head_.fetch_add(1, std::memory_order_relaxed);
+    Slot& slot = slots_[ticket & (capacity_ - 1)];
+    WaitForSequence(slot, ticket + 1);
+    return Take(slot, ticket);
+  }
+
+  // Removes and returns the oldest value if one is ready, without waiting.
+  std::optional<T> TryPop() {
+    size_t ticket = head_.load(std::memory_order_relaxed);
+    while (true) {
+      Slot& slot = slots_[ticket & (capacity_ - 1)];
+      if (slot.sequence.load(std::memory_order_acquire) == ticket + 1) {
+        if (head_.compare_exchange_weak(ticket, ticket + 1,
+                                        std::memory_order_relaxed)) {
+          return Take(slot, ticket);
+        }
+      } else {
+        // The slot is empty, unless another thread took this ticket first.
+        const size_t previous_ticket = ticket;
+        ticket = head_.load(std::memory_order_relaxed);
+        if (ticket == previous_ticket) {
+          return std::nullopt;
+        }
+      }
+    }
+  }
+
+  size_t capacity() const { return capacity_; }
+
+ private:
+  // The cache line size, which keeps the slots and the two ends of the queue
+  // from sharing lines between threads.
+  static constexpr size_t CACHE_LINE_BYTES = 64;
+
+  // A slot is ready to push ticket t when its sequence is t, and ready to pop
+  // ticket t when its sequence is t + 1.
+  struct alignas(CACHE_LINE_BYTES) Slot {
+    std::atomic<size_t> sequence;
+    T value;
+  };
+
+  static void WaitForSequence(Slot& slot, size_t sequence) {
+    size_t current;
+    while ((current = slot.sequence.load(std::memory_order_acquire)) !=
+           sequence) {
+      slot.sequence.wait(current, std::memory_order_relaxed);
+    }
+  }
+
+  static void Release(Slot& slot, size_t sequence) {
+    slot.sequence.store(sequence, std::memory_order_release);
+    slot.sequence.notify_all();
+  }
+
+  T Take(Slot& slot, size_t ticket) {
+    T value = std::move(slot.value);
+    Release(slot, ticket + capacity_);
+    return value;
+  }
+
+  const size_t capacity_;
+  std::vector<Slot> slots_;
+  alignas(CACHE_LINE_BYTES) std::atomic<size_t> head_ = 0;
+  alignas(CACHE_LINE_BYTES) std::atomic<size_t> tail_ = 0;
+};
+
+}  // namespace cryptopals::util
+
+#endif  // CRYPTOPALS_UTIL_BOUNDED_QUEUE_H_
@@ -0,0 +1,61 @@
+#include "cryptopals/util/bounded_queue.h"
+
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace cryptopals::util {
+
+TEST(BoundedQueueTest, PopsInOrder) {
+  BoundedQueue<int> queue(3);
+  EXPECT_EQ(queue.capacity(), 4);
+  EXPECT_EQ(queue.TryPop(), std::nullopt);
+  for (int round = 0; round < 3; ++round) {
+    for (int i = 0; i < 4; ++i) {
+      queue.Push(round * 4 + i);
+    }
+    EXPECT_EQ(queue.TryPop(), round * 4);
+    for (int i = 1; i < 4; ++i) {
+      EXPECT_EQ(queue.Pop(), round * 4 + i);
+    }
+    EXPECT_EQ(queue.TryPop(), std::nullopt);
+  }
+}
+
+TEST(BoundedQueueTest, PassesEveryValueBetweenThreads) {
+  constexpr int NUM_THREADS = 3;
+  constexpr int NUM_VALUES = 10000;
+  BoundedQueue<std::optional<int>> queue(8);
+
+  std::vector<std::thread> producers;
+  for (int t = 0; t < NUM_THREADS; ++t) {
+    producers.emplace_back([&queue, t] {
+      for (int i = t; i < NUM_VALUES; i += NUM_THREADS) {
+        queue.Push(i);
+      }
+      queue.Push(std::nullopt);
+    });
+  }
+
+  // Each producer's values arrive in the order it pushed them.
+  std::vector<int> last_value(NUM_THREADS, -1);
+  std::vector<int> counts(NUM_VALUES, 0);
+  for (int num_ended = 0; num_ended < NUM_THREADS;) {
+    std::optional<int> value = queue.Pop();
+    if (!value.has_value()) {
+      ++num_ended;
+      continue;
+    }
+    EXPECT_GT(*value, last_value[*value % NUM_THREADS]);
+    last_value[*value % NUM_THREADS] = *value;
+    ++counts[*value];
+  }
+  for (std::thread& producer : producers) {
+    producer.join();
+  }
+  EXPECT_EQ(counts, std::vector<int>(NUM_VALUES, 1));
+}
+
+}  // namespace cryptopals::util
@@ -0,0 +1,79 @@
+#include "cryptopals/util/byte_histogram.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace cryptopals::util {
+namespace {
+
+// Consecutive bytes are counted in separate banks, which are summed at the
+// end. Runs of the same byte are common in text, and with a single table each
+// increment would wait for the store of the previous one to the same counter.
+constexpr size_t NUM_BANKS = sizeof(uint64_t);
+
+// The counters in each bank are 32 bits wide so that all banks fit in the L1
+// cache together. Input is counted in blocks small enough that they cannot
+// overflow.
+constexpr size_t MAX_BLOCK_BYTES = size_t{1} << 31;
+
+// Below this size, clearing and summing the banks costs more than the stalls
+// they avoid, so bytes are counted straight into the histogram.
+constexpr size_t MIN_BANKED_BYTES = 4096;
+
+}  // namespace
+
+void AddByteCounts(std::span<const uint8_t> input, ByteHistogram& histogram) {
+  if (input.size() < MIN_BANKED_BYTES) {
+    for (uint8_t byte : input) {
+      ++histogram[byte];
+    }
+    return;
+  }
+
+  uint32_t banks[NUM_BANKS][256];
+  for (size_t begin = 0; begin < input.size(); begin += MAX_BLOCK_BYTES) {
+    const std::span<const uint8_t> block =
+        input.subspan(begin, std::min(MAX_BLOCK_BYTES, input.size() - begin));
+    std::memset(banks, 0, sizeof(banks));
+
+    // Reads a word at a time and counts each of its bytes in its own bank.
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= block.size(); i += sizeof(uint64_t)) {
+      uint64_t word;
+      std::memcpy(&word, block.data() + i, sizeof(word));
+#pragma GCC unroll 8
+      for (size_t bank = 0; bank < NUM_BANKS; ++bank) {
+        ++banks[bank][word >> (8 * bank) & 0xFF];
+      }
+    }
+    for (; i < block.size(); ++i) {
+      ++banks[0][block[i]];
+    }
+
+    for (size_t value = 0; value < histogram.size(); ++value) {
+      for (size_t bank = 0; bank < NUM_BANKS; ++bank) {
+        histogram[value] += banks[bank][value];
+      }
+    }
+  }
+}
+
+void AddStridedByteCounts(std::span<const uint8_t> input,
+                          std::span<ByteHistogram> histograms) {
+  const size_t stride = histograms.size();
+  if (stride == 0) {
+    return;
+  }
+
+  size_t row = 0;
+  for (; row + stride <= input.size(); row += stride) {
+    for (size_t column = 0; column < stride; ++column) {
+      ++histograms[column][input[row + column]];
+    }
+  }
+  for (size_t column = 0; row + column < input.size(); ++column) {
+    ++histograms[column][input[row + column]];
+  }
+}
+
+}  // namespace cryptopals::util
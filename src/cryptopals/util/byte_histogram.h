@@ -0,0 +1,27 @@
+// Counting the occurrences of each byte value in a buffer.
+
+#ifndef CRYPTOPALS_UTIL_BYTE_HISTOGRAM_H_
+#define CRYPTOPALS_UTIL_BYTE_HISTOGRAM_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace cryptopals::util {
+
+// The number of occurrences of each byte value, indexed by value.
+using ByteHistogram = std::array<size_t, 256>;
+
+// Adds the number of occurrences of each byte value in `input` to `histogram`.
+void AddByteCounts(std::span<const uint8_t> input, ByteHistogram& histogram);
+
+// Adds the bytes of `input` at offset i to `histograms[i % histograms.size()]`,
+// so that each histogram counts one column of `input` laid out in rows of
+// `histograms.size()` bytes. Does nothing if `histograms` is empty.
+void AddStridedByteCounts(std::span<const uint8_t> input,
+                          std::span<ByteHistogram> histograms);
+
+}  // namespace cryptopals::util
+
+#endif  // CRYPTOPALS_UTIL_BYTE_HISTOGRAM_H_
@@ -0,0 +1,60 @@
+#include "cryptopals/util/byte_histogram.h"
+
+#include <cstdint>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace cryptopals::util {
+namespace {
+
+TEST(ByteHistogramTest, CountsSmallInput) {
+  const std::vector<uint8_t> input = {'a', 'b', 'a', 0x00, 0xFF, 'a'};
+  ByteHistogram histogram = {};
+  AddByteCounts(input, histogram);
+
+  ByteHistogram expected = {};
+  expected['a'] = 3;
+  expected['b'] = 1;
+  expected[0x00] = 1;
+  expected[0xFF] = 1;
+  EXPECT_EQ(histogram, expected);
+}
+
+TEST(ByteHistogramTest, CountsLargeInputWithTail) {
+  std::vector<uint8_t> input(100003);
+  ByteHistogram expected = {};
+  for (size_t i = 0; i < input.size(); ++i) {
+    // Long runs of one value stress a single counter in every bank.
+    input[i] = i < 50000 ? 'e' : static_cast<uint8_t>(i * 31);
+    ++expected[input[i]];
+  }
+
+  // Counts are added to what the histogram already holds.
+  ByteHistogram histogram = {};
+  histogram['e'] = 5;
+  expected['e'] += 5;
+  AddByteCounts(input, histogram);
+  EXPECT_EQ(histogram, expected);
+}
+
+TEST(ByteHistogramTest, CountsColumns) {
+  std::vector<uint8_t> input(1003);
+  for (size_t i = 0; i < input.size(); ++i) {
+    input[i] = static_cast<uint8_t>(i * 31 + i / 7);
+  }
+
+  for (size_t stride : {1, 2, 7, 40}) {
+    std::vector<ByteHistogram> expected(stride, ByteHistogram{});
+    for (size_t i = 0; i < input.size(); ++i) {
+      ++expected[i % stride][input[i]];
+    }
+
+    std::vector<ByteHistogram> histograms(stride, ByteHistogram{});
+    AddStridedByteCounts(input, histograms);
+    EXPECT_EQ(histograms, expected) << "stride=" << stride;
+  }
+}
+
+}  // namespace
+}  // namespace cryptopals::util
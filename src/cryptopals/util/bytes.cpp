@@ -1,49 +1,18 @@
 #include "cryptopals/util/bytes.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <string>
 #include <string_view>
-#include <vector>
 
-#include "cryptopals/util/algorithm.h"
+#include "absl/status/status.h"
+#include "absl/status/status_macros.h"
+#include "absl/status/statusor.h"
+#include "cryptopals/util/codecs.h"
+#include "cryptopals/util/logging.h"
+#include "cryptopals/util/xor_kernel.h"
 
 namespace cryptopals::util {
-namespace {
-
-constexpr std::string_view hex_chars = "0123456789abcdef";
-constexpr std::string_view base64_chars =
-    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/=";
-
-// For each variable {1}_{2}_ratio, it represents the number of {1} required to
-// form a length that is a multiple of {2}. A hex digit represents 4 bits, a
-// base64 digit represents 6 bits, and a byte represents 8 bits.
-constexpr size_t hex_bytes_ratio = 2;     // 4 * {2} == 8 == 1 mod 8
-constexpr size_t bytes_base64_ratio = 3;  // 8 * {3} == 24 == 4 mod 6
-constexpr size_t base64_bytes_ratio = 4;  // 6 * {4} == 24 == 3 mod 8
-
-// Calculates the number of bytes needed to decode a hex string of `length`
-// chars, including padding.
-inline constexpr size_t HexToBytesSize(size_t length) {
-  return CeilingMultiple(length, hex_bytes_ratio) / hex_bytes_ratio;
-}
-
-// Calculates the number of chars needed to hex-encode a vector of `length`
-// bytes.
-inline constexpr size_t BytesToHexSize(size_t length) { return length * 2; }
-
-// Calculates the number of bytes needed to decode a base64 string of `length`
-// chars, including padding.
-inline constexpr size_t Base64ToBytesSize(size_t length) {
-  return CeilingMultiple(length, base64_bytes_ratio) / base64_bytes_ratio;
-}
-
-// Calculates the number of chars needed to base64-encode a vector of `length`
-// bytes, including padding.
-inline constexpr size_t BytesToBase64Size(size_t length) {
-  return CeilingMultiple(length, bytes_base64_ratio) / bytes_base64_ratio;
-}
-
-}  // namespace
 
 Bytes Bytes::CreateFromFormat(const std::string_view input,
                               cryptopals::BytesEncodedFormat format) {
@@ -62,56 +31,28 @@ Bytes Bytes::CreateFromFormat(const std::string_view input,
 }
 
 Bytes Bytes::CreateFromBase64(const std::string_view input) {
-  Bytes bytes;
-  bytes.data_.reserve(Base64ToBytesSize(input.size()));
+  Bytes bytes(Base64DecodedMaxSize(input.size()));
   bytes.format_ = cryptopals::BytesEncodedFormat::BASE64;
 
-  // This mask ensures that any padding characters '=' get treated as all 0's.
-  const uint32_t sextet_mask = 0x3F;
-
-  for (size_t i = 0; i < input.size(); i += base64_bytes_ratio) {
-    size_t chars_left = input.size() - i;
-    // For each chunk of {4} encoded characters, compress the four characters
-    // into three bytes. For example,
-    //   AAAAAA BBBBBB CCCCCC DDDDDD becomes AAAAAABB BBBBCCCC CCDDDDDD
-    uint32_t chunk = (base64_chars.find(input.at(i)) & sextet_mask) << 18;
-    if (chars_left > 1) {
-      chunk |= (base64_chars.find(input.at(i + 1)) & sextet_mask) << 12;
-    }
-    if (chars_left > 2) {
-      chunk |= (base64_chars.find(input.at(i + 2)) & sextet_mask) << 6;
-    }
-    if (chars_left > 3) {
-      chunk |= base64_chars.find(input.at(i + 3)) & sextet_mask;
-    }
-
-    bytes.data_.push_back(chunk >> 16 & 0xFF);
-    if (chars_left > 1 &&
-        (chars_left <= 2 || input.at(i + 2) != base64_chars.back())) {
-      bytes.data_.push_back(chunk >> 8 & 0xFF);
-    }
-    if (chars_left > 2 &&
-        (chars_left <= 3 || input.at(i + 3) != base64_chars.back())) {
-      bytes.data_.push_back(chunk & 0xFF);
-    }
+  absl::StatusOr<size_t> size = DecodeBase64(input, bytes.data_);
+  if (!size.ok()) {
+    LOG(ERROR) << "Error decoding base64: " << size.status();
+    return Bytes();
   }
-
+  bytes.data_.resize(*size);
   return bytes;
 }
 
 Bytes Bytes::CreateFromHex(const std::string_view input) {
-  Bytes bytes;
-  bytes.data_.reserve(HexToBytesSize(input.size()));
+  Bytes bytes(HexDecodedSize(input.size()));
   bytes.format_ = cryptopals::BytesEncodedFormat::HEX;
 
-  for (size_t i = 0; i < input.size(); i += hex_bytes_ratio) {
-    byte_type byte = hex_chars.find(input.at(i)) << 4;
-    if (i + 1 < input.size()) {
-      byte |= hex_chars.find(input.at(i + 1));
-    }
-    bytes.data_.push_back(byte);
+  absl::StatusOr<size_t> size = DecodeHex(input, bytes.data_);
+  if (!size.ok()) {
+    LOG(ERROR) << "Error decoding hex: " << size.status();
+    return Bytes();
   }
-
+  bytes.data_.resize(*size);
   return bytes;
 }
 
@@ -121,6 +62,66 @@ Bytes Bytes::CreateFromRaw(const std::string_view input) {
   return bytes;
 }
 
+absl::StatusOr<Bytes> Bytes::DecodeFromFormat(
+    std::string_view input, cryptopals::BytesEncodedFormat format) {
+  Bytes bytes;
+  bytes.format_ = format;
+  RETURN_IF_ERROR(bytes.AppendFromFormat(input, format));
+  return bytes;
+}
+
+absl::StatusOr<size_t> Bytes::DecodeFromFormat(
+    std::string_view input, cryptopals::BytesEncodedFormat format,
+    std::span<uint8_t> output) {
+  switch (format) {
+    case cryptopals::BytesEncodedFormat::BASE64:
+      return DecodeBase64(input, output, STRICT_DECODE_OPTIONS);
+    case cryptopals::BytesEncodedFormat::HEX:
+      return DecodeHex(input, output, STRICT_DECODE_OPTIONS);
+    case cryptopals::BytesEncodedFormat::RAW:
+      if (output.size() < input.size()) {
+        return absl::InvalidArgumentError("Output is too small for raw input");
+      }
+      std::copy(input.begin(), input.end(), output.begin());
+      return input.size();
+    default:
+      return absl::InvalidArgumentErrorBuilder()
+             << "Unsupported bytes format: "
+             << cryptopals::BytesEncodedFormat_Name(format);
+  }
+}
+
+size_t Bytes::DecodedSize(std::string_view input,
+                          cryptopals::BytesEncodedFormat format) {
+  switch (format) {
+    case cryptopals::BytesEncodedFormat::BASE64:
+      return Base64DecodedSize(input, STRICT_DECODE_OPTIONS);
+    case cryptopals::BytesEncodedFormat::HEX:
+      return HexDecodedSize(input, STRICT_DECODE_OPTIONS);
+    case cryptopals::BytesEncodedFormat::RAW:
+      return input.size();
+    default:
+      return 0;
+  }
+}
+
+absl::Status Bytes::AppendFromFormat(std::string_view input,
+                                     cryptopals::BytesEncodedFormat format) {
+  const size_t old_size = data_.size();
+  const size_t new_size = old_size + DecodedSize(input, format);
+  data_.reserve(new_size);
+  data_.resize(new_size);
+
+  absl::StatusOr<size_t> size = DecodeFromFormat(
+      input, format, std::span<uint8_t>(data_).subspan(old_size));
+  if (!size.ok()) {
+    data_.resize(old_size);
+    return size.status();
+  }
+  data_.resize(old_size + *size);
+  return absl::OkStatus();
+}
+
 std::string Bytes::ToFormat(cryptopals::BytesEncodedFormat format) const {
   switch (format) {
     case cryptopals::BytesEncodedFormat::BASE64:
@@ -135,51 +136,14 @@ std::string Bytes::ToFormat(cryptopals::BytesEncodedFormat format) const {
 }
 
 std::string Bytes::ToBase64() const {
-  std::string result;
-  result.reserve(BytesToBase64Size(data_.size()));
-
-  for (size_t i = 0; i < data_.size(); i += bytes_base64_ratio) {
-    size_t bytes_left = data_.size() - i;
-    // For each chunk of {3} bytes, decompress the three 8-bit values into four
-    // 6-bit values. For example,
-    //   AAAAAAAA BBBBBBBB CCCCCCCC becomes 00AAAAAA 00AABBBB 00BBBBCC 00CCCCCC
-    uint32_t chunk = (data_[i] >> 2) << 24;
-    chunk |= (data_[i] & 0x03) << 20;
-    if (bytes_left > 1) {
-      chunk |= (data_[i + 1] >> 4) << 16;
-      chunk |= (data_[i + 1] & 0x0F) << 10;
-    }
-    if (bytes_left > 2) {
-      chunk |= (data_[i + 2] >> 6) << 8;
-      chunk |= (data_[i + 2] & 0x3F);
-    }
-
-    result.append(1, base64_chars.at(chunk >> 24 & 0xFF));
-    result.append(1, base64_chars.at(chunk >> 16 & 0xFF));
-    if (bytes_left > 1) {
-      result.append(1, base64_chars.at(chunk >> 8 & 0xFF));
-    }
-
-    if (bytes_left > 2) {
-      result.append(1, base64_chars.at(chunk & 0xFF));
-    }
-  }
-
-  // Add any padding chars if necessary.
-  result.append((4 - result.size() % 4) % 4, base64_chars.back());
-
+  std::string result(Base64EncodedSize(data_.size()), '\0');
+  EncodeBase64(data_, result);
   return result;
 }
 
 std::string Bytes::ToHex() const {
-  std::string result;
-  result.reserve(BytesToHexSize(data_.size()));
-
-  for (byte_type byte : data_) {
-    result.append(1, hex_chars.at(byte >> 4));
-    result.append(1, hex_chars.at(byte & 0x0F));
-  }
-
+  std::string result(HexEncodedSize(data_.size()), '\0');
+  EncodeHex(data_, result);
   return result;
 }
 
@@ -188,11 +152,7 @@ std::string Bytes::ToRaw(void) const {
 }
 
 Bytes& Bytes::operator^=(const Bytes& rhs) {
-  size_t i = 0;
-  for (byte_type& byte : data_) {
-    byte ^= rhs.data_.at(i % rhs.data_.size());
-    ++i;
-  }
+  XorWithRepeatingKey(data_, rhs.data_);
   return *this;
 }
 
@@ -1,12 +1,16 @@
 #ifndef CRYPTOPALS_UTIL_BYTES_H_
 #define CRYPTOPALS_UTIL_BYTES_H_
 
+#include <algorithm>
 #include <compare>
 #include <cstdint>
+#include <span>
 #include <string_view>
 #include <type_traits>
-#include <vector>
 
+#include "absl/container/inlined_vector.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
 #include "cryptopals/proto/cryptopals_enums.pb.h"
 
 namespace cryptopals::util {
@@ -14,7 +18,13 @@ namespace cryptopals::util {
 class Bytes {
  public:
   using byte_type = uint8_t;
-  using data_type = std::vector<byte_type>;
+
+  // The number of bytes stored inside the object itself. Larger payloads are
+  // moved to the heap. Keys, AES words and blocks, and most of the values
+  // created while cracking a cipher fit inline, so they never allocate.
+  static constexpr size_t INLINE_CAPACITY = 32;
+
+  using data_type = absl::InlinedVector<byte_type, INLINE_CAPACITY>;
 
   // The constructors are only made public to support default constructors for
   // aggregates. Prefer using a Create* function below to initialize a single
@@ -29,15 +39,36 @@ class Bytes {
   Bytes(InputIt first, InputIt last) : data_(first, last) {}
 
   // Create a Bytes object from an input string `input` with the encoding
-  // `format`. The Bytes object is padded with 0s to the nearest byte.
-  // Convenience functions are also provided for each supported format. The
-  // format used to create the Bytes object is saved to `format_`.
+  // `format`. The Bytes object is padded with 0s to the nearest byte. Input
+  // with a malformed char is logged and yields an empty object. Convenience
+  // functions are also provided for each supported format. The format used to
+  // create the Bytes object is saved to `format_`.
   static Bytes CreateFromFormat(const std::string_view input,
                                 cryptopals::BytesEncodedFormat format);
   static Bytes CreateFromBase64(const std::string_view input);
   static Bytes CreateFromHex(const std::string_view input);
   static Bytes CreateFromRaw(const std::string_view input);
 
+  // Strict counterparts of CreateFromFormat(). ASCII whitespace in hex and
+  // base64 input is skipped. A malformed char, an odd number of hex digits,
+  // unpadded base64, or an unsupported `format` is an error instead.
+  static absl::StatusOr<Bytes> DecodeFromFormat(
+      std::string_view input, cryptopals::BytesEncodedFormat format);
+  // Decodes into `output`, which must hold at least DecodedSize(input, format)
+  // bytes, and returns the number of bytes written.
+  static absl::StatusOr<size_t> DecodeFromFormat(
+      std::string_view input, cryptopals::BytesEncodedFormat format,
+      std::span<uint8_t> output);
+  // Returns the exact number of bytes that DecodeFromFormat() produces for a
+  // well-formed `input`.
+  static size_t DecodedSize(std::string_view input,
+                            cryptopals::BytesEncodedFormat format);
+
+  // Decodes `input` as DecodeFromFormat() does and appends the result to this
+  // object, growing it at most once. This object is unchanged on error.
+  absl::Status AppendFromFormat(std::string_view input,
+                                cryptopals::BytesEncodedFormat format);
+
   // Create a Bytes object from any integral type.
   template <typename T, typename = std::enable_if_t<std::is_integral_v<T>>>
   static Bytes CreateFromIntegral(const T input) {
@@ -79,14 +110,17 @@ class Bytes {
 
   // Support for comparing Bytes objects.
   friend std::weak_ordering operator<=>(const Bytes& lhs, const Bytes& rhs) {
-    return lhs.data_ <=> rhs.data_;
+    return std::lexicographical_compare_three_way(
+        lhs.data_.begin(), lhs.data_.end(), rhs.data_.begin(),
+        rhs.data_.end());
   }
   friend inline bool operator==(const Bytes& lhs, const Bytes& rhs) {
     return lhs.data_ == rhs.data_;
   }
 
   // Applies the XOR operation to the bytes object. The `rhs` operand is
-  // repeated so that it is the same length as this object.
+  // repeated so that it is the same length as this object. An empty `rhs`
+  // leaves this object unchanged.
   Bytes& operator^=(const Bytes& rhs);
 
   // Returns the XOR of `lhs` and `rhs`. The length of the result is equal to
@@ -127,7 +161,8 @@ class Bytes {
   }
 
  private:
-  // A vector to hold the raw data contained in this class.
+  // A vector to hold the raw data contained in this class. Small payloads are
+  // stored inline (see INLINE_CAPACITY).
   data_type data_;
   // A type to hold the encoded format (used in printing).
   cryptopals::BytesEncodedFormat format_ = cryptopals::HEX;
@@ -1,5 +1,8 @@
 #include "cryptopals/util/bytes.h"
 
+#include <utility>
+
+#include "googletest/status_matchers.h"
 #include "gtest/gtest.h"
 
 namespace cryptopals::util {
@@ -43,4 +46,48 @@ TEST(BytesTest, XorTest) {
   EXPECT_EQ(lhs ^ rhs, expected_result);
 }
 
+TEST(BytesTest, GrowsBeyondInlineCapacity) {
+  Bytes bytes = Bytes::CreateFromRaw("YELLOW SUBMARINE");
+  Bytes copy = bytes;
+  for (int i = 0; i < 3; ++i) {
+    bytes.Append(copy);
+  }
+  EXPECT_EQ(bytes.size(), 4 * copy.size());
+  EXPECT_GT(bytes.size(), Bytes::INLINE_CAPACITY);
+  EXPECT_EQ(bytes.ToRaw(),
+            "YELLOW SUBMARINEYELLOW SUBMARINEYELLOW SUBMARINEYELLOW SUBMARINE");
+
+  // Moving and shrinking keep the contents in either storage mode.
+  Bytes moved = std::move(bytes);
+  moved.Resize(20);
+  EXPECT_EQ(moved.ToRaw(), "YELLOW SUBMARINEYELL");
+  EXPECT_LT(copy, moved);
+  EXPECT_GT(Bytes::CreateFromHex("ff"), moved);
+}
+
+TEST(BytesTest, DecodeFromFormat) {
+  ASSERT_OK_AND_ASSIGN(Bytes bytes,
+                       Bytes::DecodeFromFormat("SGVsbG8s\nIHdv\ncmxk\n",
+                                               cryptopals::BASE64));
+  EXPECT_EQ(bytes.ToRaw(), "Hello, world");
+
+  EXPECT_EQ(Bytes::DecodeFromFormat("abc", cryptopals::HEX).status().code(),
+            absl::StatusCode::kInvalidArgument);
+  EXPECT_EQ(Bytes::DecodeFromFormat("ab", cryptopals::BytesEncodedFormat(99))
+                .status()
+                .code(),
+            absl::StatusCode::kInvalidArgument);
+}
+
+TEST(BytesTest, AppendFromFormat) {
+  Bytes bytes = Bytes::CreateFromRaw("Hello");
+  ASSERT_OK(bytes.AppendFromFormat("2c 20 77 6f 72 6c 64", cryptopals::HEX));
+  EXPECT_EQ(bytes.ToRaw(), "Hello, world");
+
+  // A failed append leaves the object unchanged.
+  EXPECT_EQ(bytes.AppendFromFormat("2c2x", cryptopals::HEX).code(),
+            absl::StatusCode::kInvalidArgument);
+  EXPECT_EQ(bytes.ToRaw(), "Hello, world");
+}
+
 }  // namespace cryptopals::util
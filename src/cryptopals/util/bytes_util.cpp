@@ -1,19 +1,21 @@
 #include "cryptopals/util/bytes_util.h"
 
+#include <algorithm>
+
 namespace cryptopals::util {
 
-std::vector<Bytes> SplitBytes(const Bytes& input, size_t n) {
-  std::vector<Bytes> result;
+std::vector<BytesView> SplitBytes(BytesView input, size_t n) {
+  std::vector<BytesView> result;
+  result.reserve((input.size() + n - 1) / n);
 
-  for (int i = 0; i < input.size(); i += n) {
-    auto last = std::min(input.size(), i + n);
-    result.emplace_back(input.begin() + i, input.begin() + last);
+  for (size_t i = 0; i < input.size(); i += n) {
+    result.push_back(input.subview(i, std::min(n, input.size() - i)));
   }
 
   return result;
 }
 
-std::vector<Bytes> SplitAndTransposeBytes(const Bytes& input, size_t n) {
+std::vector<Bytes> SplitAndTransposeBytes(BytesView input, size_t n) {
   std::vector<Bytes> result(n);
 
   for (int i = 0; i < input.size(); i += n) {
@@ -21,7 +23,7 @@ std::vector<Bytes> SplitAndTransposeBytes(const Bytes& input, size_t n) {
       if (i + j >= input.size()) {
         break;
       }
-      result[j].push_back(input.at(i + j));
+      result[j].push_back(input[i + j]);
     }
   }
 
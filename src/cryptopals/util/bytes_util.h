@@ -4,17 +4,19 @@
 #include <vector>
 
 #include "cryptopals/util/bytes.h"
+#include "cryptopals/util/bytes_view.h"
 
 namespace cryptopals::util {
 
-// Splits `input` into a vector of bytes, each of length `n`. For example,
-// SplitBytes("ABCDEFGHIJ", 4) returns {"ABCD", "EFGH", "IJ"}.
-std::vector<Bytes> SplitBytes(const Bytes& input, size_t n);
+// Splits `input` into a vector of views, each of length `n`. For example,
+// SplitBytes("ABCDEFGHIJ", 4) returns {"ABCD", "EFGH", "IJ"}. The views point
+// into `input`, so the bytes behind `input` must outlive the result.
+std::vector<BytesView> SplitBytes(BytesView input, size_t n);
 
 // Splits `input` into a vector of bytes, where each new bytes object contains
 // every `n`th byte. For example, SplitAndTransposeBytes("ABCDEFGHIJ", 4)
 // returns {"AEI", "BFJ", "CG", "DH"}.
-std::vector<Bytes> SplitAndTransposeBytes(const Bytes& input, size_t n);
+std::vector<Bytes> SplitAndTransposeBytes(BytesView input, size_t n);
 
 // Performs the reverse operation of SplitAndTransposeBytes. Note that this
 // algorithm assumes that the first element of the vector is the longest.
@@ -0,0 +1,46 @@
+#include "cryptopals/util/bytes_util.h"
+
+#include <vector>
+
+#include "cryptopals/util/bytes.h"
+#include "cryptopals/util/bytes_view.h"
+#include "gtest/gtest.h"
+
+namespace cryptopals::util {
+
+TEST(BytesUtilTest, SplitBytesReturnsViewsIntoInput) {
+  Bytes input = Bytes::CreateFromRaw("ABCDEFGHIJ");
+  std::vector<BytesView> result = SplitBytes(input, 4);
+
+  ASSERT_EQ(result.size(), 3);
+  EXPECT_EQ(result[0].ToRaw(), "ABCD");
+  EXPECT_EQ(result[1].ToRaw(), "EFGH");
+  EXPECT_EQ(result[2].ToRaw(), "IJ");
+  EXPECT_EQ(result[1].data(), &*input.begin() + 4);
+}
+
+TEST(BytesUtilTest, SplitAndJoinTransposeBytes) {
+  Bytes input = Bytes::CreateFromRaw("ABCDEFGHIJ");
+  std::vector<Bytes> result = SplitAndTransposeBytes(input, 4);
+
+  ASSERT_EQ(result.size(), 4);
+  EXPECT_EQ(result[0].ToRaw(), "AEI");
+  EXPECT_EQ(result[1].ToRaw(), "BFJ");
+  EXPECT_EQ(result[2].ToRaw(), "CG");
+  EXPECT_EQ(result[3].ToRaw(), "DH");
+  EXPECT_EQ(JoinAndTransposeBytes(result), input);
+}
+
+TEST(BytesViewTest, ViewsCompareByContents) {
+  Bytes bytes = Bytes::CreateFromRaw("YELLOW SUBMARINE");
+  BytesView view = bytes;
+
+  EXPECT_EQ(view.size(), bytes.size());
+  EXPECT_EQ(view, bytes);
+  EXPECT_EQ(view.subview(7), Bytes::CreateFromRaw("SUBMARINE"));
+  EXPECT_EQ(view.first(6).ToBytes(), Bytes::CreateFromRaw("YELLOW"));
+  EXPECT_LT(view.last(9), view.first(6));
+  EXPECT_NE(view.first(6), view.last(6));
+}
+
+}  // namespace cryptopals::util
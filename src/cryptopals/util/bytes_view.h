@@ -0,0 +1,95 @@
+#ifndef CRYPTOPALS_UTIL_BYTES_VIEW_H_
+#define CRYPTOPALS_UTIL_BYTES_VIEW_H_
+
+#include <algorithm>
+#include <compare>
+#include <cstdint>
+#include <ostream>
+#include <span>
+#include <string_view>
+
+#include "cryptopals/util/bytes.h"
+
+namespace cryptopals::util {
+
+// A non-owning, read-only view of a contiguous range of bytes, such as a Bytes
+// object, a slice of one, or a memory-mapped file. A BytesView is a pointer and
+// a length, so it is cheap to copy and should be passed by value. The viewed
+// bytes must outlive the view.
+class BytesView {
+ public:
+  using byte_type = Bytes::byte_type;
+  using const_iterator = std::span<const byte_type>::iterator;
+
+  // Creates an empty view.
+  constexpr BytesView() = default;
+
+  // Creates a view of the bytes [`data`, `data` + `size`).
+  constexpr BytesView(const byte_type* data, size_t size)
+      : bytes_(data, size) {}
+
+  // Creates a view of `span`.
+  constexpr BytesView(std::span<const byte_type> span) : bytes_(span) {}
+
+  // Creates a view of every byte of `bytes`. The view is invalidated when
+  // `bytes` is resized or destroyed.
+  BytesView(const Bytes& bytes) : bytes_(bytes.begin(), bytes.size()) {}
+
+  // Copies the viewed bytes into a new Bytes object.
+  Bytes ToBytes() const { return Bytes(bytes_.begin(), bytes_.end()); }
+
+  // Returns a std::string_view of the viewed bytes.
+  std::string_view ToRaw() const {
+    return std::string_view(reinterpret_cast<const char*>(bytes_.data()),
+                            bytes_.size());
+  }
+
+  // Returns a view of `count` bytes starting at `offset`. When `count` is
+  // omitted, the view extends to the end of this view.
+  constexpr BytesView subview(size_t offset,
+                              size_t count = std::dynamic_extent) const {
+    return BytesView(bytes_.subspan(offset, count));
+  }
+
+  // Returns a view of the first or last `count` bytes.
+  constexpr BytesView first(size_t count) const {
+    return BytesView(bytes_.first(count));
+  }
+  constexpr BytesView last(size_t count) const {
+    return BytesView(bytes_.last(count));
+  }
+
+  // Support for comparing BytesView objects by their contents.
+  friend std::weak_ordering operator<=>(BytesView lhs, BytesView rhs) {
+    return std::lexicographical_compare_three_way(lhs.begin(), lhs.end(),
+                                                  rhs.begin(), rhs.end());
+  }
+  friend bool operator==(BytesView lhs, BytesView rhs) {
+    return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+  }
+
+  // Support for streamed printing of BytesView objects, in hex.
+  friend std::ostream& operator<<(std::ostream& os, BytesView obj) {
+    os << obj.ToBytes().ToHex();
+    return os;
+  }
+
+  // The following functions support using a BytesView object like a
+  // std::span<const uint8_t>.
+  constexpr operator std::span<const byte_type>() const { return bytes_; }
+  constexpr const_iterator begin() const { return bytes_.begin(); }
+  constexpr const_iterator end() const { return bytes_.end(); }
+  constexpr const byte_type* data() const { return bytes_.data(); }
+  constexpr size_t size() const { return bytes_.size(); }
+  constexpr bool empty() const { return bytes_.empty(); }
+  constexpr byte_type operator[](size_t pos) const { return bytes_[pos]; }
+  constexpr byte_type front() const { return bytes_.front(); }
+  constexpr byte_type back() const { return bytes_.back(); }
+
+ private:
+  std::span<const byte_type> bytes_;
+};
+
+}  // namespace cryptopals::util
+
+#endif  // CRYPTOPALS_UTIL_BYTES_VIEW_H_
@@ -0,0 +1,590 @@
+#include "cryptopals/util/codecs.h"
+
+#include <algorithm>
+#include <array>
+#include <string>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+#include "absl/status/status.h"
+#include "absl/status/status_macros.h"
+#include "absl/strings/escaping.h"
+#include "cryptopals/util/cpu_features.h"
+
+namespace cryptopals::util {
+namespace {
+
+constexpr std::string_view hex_chars = "0123456789abcdef";
+constexpr std::string_view base64_chars =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+constexpr char base64_padding = '=';
+
+// Marks a char that is not part of an alphabet in a decode table.
+constexpr uint8_t INVALID_VALUE = 0xFF;
+
+// Maps every char to its value in hex, accepting both cases.
+constexpr std::array<uint8_t, 256> hex_values = []() {
+  std::array<uint8_t, 256> values;
+  values.fill(INVALID_VALUE);
+  for (size_t i = 0; i < hex_chars.size(); ++i) {
+    values[static_cast<uint8_t>(hex_chars[i])] = i;
+    if (hex_chars[i] >= 'a') {
+      values[static_cast<uint8_t>(hex_chars[i] - 'a' + 'A')] = i;
+    }
+  }
+  return values;
+}();
+
+// Maps every char to its value in base64. The padding char is not included.
+constexpr std::array<uint8_t, 256> base64_values = []() {
+  std::array<uint8_t, 256> values;
+  values.fill(INVALID_VALUE);
+  for (size_t i = 0; i < base64_chars.size(); ++i) {
+    values[static_cast<uint8_t>(base64_chars[i])] = i;
+  }
+  return values;
+}();
+
+absl::Status MalformedCharError(std::string_view encoding,
+                                std::string_view input, size_t position) {
+  return absl::InvalidArgumentErrorBuilder()
+         << "Invalid " << encoding << " character '"
+         << absl::CHexEscape(std::string(1, input[position]))
+         << "' at position " << position;
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+
+// The functions below are compiled for processors with AVX2 regardless of the
+// flags used for the rest of the build. They are only reached after
+// HasAvx2() has been checked. Each one converts as many whole blocks as it can
+// and returns the number of input units consumed; the portable code handles
+// the rest, including locating any malformed char.
+
+__attribute__((target("avx2"))) size_t EncodeHexAvx2(const uint8_t* input,
+                                                     size_t size,
+                                                     char* output) {
+  const __m256i lut = _mm256_setr_epi8(
+      '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e',
+      'f', '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd',
+      'e', 'f');
+  const __m256i low_nibble = _mm256_set1_epi8(0x0F);
+
+  size_t i = 0;
+  for (; i + 32 <= size; i += 32) {
+    __m256i bytes =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i));
+    __m256i high = _mm256_shuffle_epi8(
+        lut, _mm256_and_si256(_mm256_srli_epi16(bytes, 4), low_nibble));
+    __m256i low = _mm256_shuffle_epi8(lut, _mm256_and_si256(bytes, low_nibble));
+    // The unpacks interleave within each 128-bit lane, so the lanes are put
+    // back in order before storing.
+    __m256i first = _mm256_unpacklo_epi8(high, low);
+    __m256i second = _mm256_unpackhi_epi8(high, low);
+    __m256i* out = reinterpret_cast<__m256i*>(output + 2 * i);
+    _mm256_storeu_si256(out, _mm256_permute2x128_si256(first, second, 0x20));
+    _mm256_storeu_si256(out + 1,
+                        _mm256_permute2x128_si256(first, second, 0x31));
+  }
+  return i;
+}
+
+// Converts the 32 hex digits in `chars` to their values. Returns false if any
+// of them is malformed.
+__attribute__((target("avx2"))) bool HexDigitsToValues(__m256i chars,
+                                                       __m256i* values) {
+  __m256i is_digit =
+      _mm256_and_si256(_mm256_cmpgt_epi8(chars, _mm256_set1_epi8('0' - 1)),
+                       _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), chars));
+  __m256i lower = _mm256_or_si256(chars, _mm256_set1_epi8(0x20));
+  __m256i is_letter =
+      _mm256_and_si256(_mm256_cmpgt_epi8(lower, _mm256_set1_epi8('a' - 1)),
+                       _mm256_cmpgt_epi8(_mm256_set1_epi8('f' + 1), lower));
+  if (_mm256_movemask_epi8(_mm256_or_si256(is_digit, is_letter)) != -1) {
+    return false;
+  }
+  *values = _mm256_blendv_epi8(
+      _mm256_sub_epi8(lower, _mm256_set1_epi8('a' - 10)),
+      _mm256_sub_epi8(chars, _mm256_set1_epi8('0')), is_digit);
+  return true;
+}
+
+__attribute__((target("avx2"))) size_t DecodeHexAvx2(const char* input,
+                                                     size_t size,
+                                                     uint8_t* output) {
+  // Combines each pair of digits into a 16-bit lane as high * 16 + low.
+  const __m256i weights = _mm256_set1_epi16(0x0110);
+
+  size_t i = 0;
+  for (; i + 64 <= size; i += 64) {
+    const __m256i* in = reinterpret_cast<const __m256i*>(input + i);
+    __m256i first, second;
+    if (!HexDigitsToValues(_mm256_loadu_si256(in), &first) ||
+        !HexDigitsToValues(_mm256_loadu_si256(in + 1), &second)) {
+      break;
+    }
+    __m256i bytes =
+        _mm256_packus_epi16(_mm256_maddubs_epi16(first, weights),
+                            _mm256_maddubs_epi16(second, weights));
+    bytes = _mm256_permute4x64_epi64(bytes, 0xD8);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i / 2), bytes);
+  }
+  return i;
+}
+
+// Encodes 24 bytes per iteration into 32 chars, following W. Muła and
+// D. Lemire, "Faster Base64 Encoding and Decoding Using AVX2 Instructions".
+__attribute__((target("avx2"))) size_t EncodeBase64Avx2(const uint8_t* input,
+                                                        size_t size,
+                                                        char* output) {
+  // Places each group of three bytes s0 s1 s2 in a 32-bit lane as s1 s0 s2 s1.
+  const __m256i shuffle =
+      _mm256_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1, 10,
+                      11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1);
+  // Offsets from each sextet to its char, indexed as computed below.
+  const __m256i offsets = _mm256_setr_epi8(
+      'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+      '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0,
+      'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+      '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+
+  size_t i = 0;
+  size_t j = 0;
+  // Each lane loads 16 bytes but only uses 12 of them.
+  for (; i + 28 <= size; i += 24, j += 32) {
+    __m256i bytes = _mm256_inserti128_si256(
+        _mm256_castsi128_si256(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i))),
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i + 12)), 1);
+    bytes = _mm256_shuffle_epi8(bytes, shuffle);
+
+    // Moves the four sextets of every lane into the low bits of its bytes.
+    __m256i sextets = _mm256_or_si256(
+        _mm256_mulhi_epu16(
+            _mm256_and_si256(bytes, _mm256_set1_epi32(0x0FC0FC00)),
+            _mm256_set1_epi32(0x04000040)),
+        _mm256_mullo_epi16(
+            _mm256_and_si256(bytes, _mm256_set1_epi32(0x003F03F0)),
+            _mm256_set1_epi32(0x01000010)));
+
+    // Sextets below 26 select index 13, 26-51 select 0, and 52-63 select
+    // 1-12.
+    __m256i index = _mm256_subs_epu8(sextets, _mm256_set1_epi8(51));
+    __m256i is_upper = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), sextets);
+    index = _mm256_or_si256(
+        index, _mm256_and_si256(is_upper, _mm256_set1_epi8(13)));
+    __m256i chars =
+        _mm256_add_epi8(sextets, _mm256_shuffle_epi8(offsets, index));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + j), chars);
+  }
+  return i;
+}
+
+// Decodes 32 chars per iteration into 24 bytes. Stops at the first block with
+// a char outside the alphabet, which includes padding.
+__attribute__((target("avx2"))) size_t DecodeBase64Avx2(const char* input,
+                                                        size_t size,
+                                                        uint8_t* output) {
+  // A char is valid when the bits looked up by its low and high nibbles do not
+  // overlap.
+  const __m256i lut_low = _mm256_setr_epi8(
+      0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A,
+      0x1B, 0x1B, 0x1B, 0x1A, 0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+      0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+  const __m256i lut_high = _mm256_setr_epi8(
+      0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10,
+      0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+      0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+  // Offsets from each char to its sextet, indexed by the high nibble ('/'
+  // shares its nibble with '+' and is moved to index 1).
+  const __m256i lut_roll =
+      _mm256_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0,
+                       0, 0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0,
+                       0, 0);
+  const __m256i mask_2f = _mm256_set1_epi8(0x2F);
+  const __m256i gather = _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13,
+                                          12, -1, -1, -1, -1, 2, 1, 0, 6, 5,
+                                          4, 10, 9, 8, 14, 13, 12, -1, -1, -1,
+                                          -1);
+
+  size_t i = 0;
+  size_t j = 0;
+  for (; i + 32 <= size; i += 32, j += 24) {
+    __m256i chars =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i));
+    __m256i high_nibbles =
+        _mm256_and_si256(_mm256_srli_epi32(chars, 4), mask_2f);
+    __m256i low = _mm256_shuffle_epi8(lut_low, _mm256_and_si256(chars, mask_2f));
+    __m256i high = _mm256_shuffle_epi8(lut_high, high_nibbles);
+    if (!_mm256_testz_si256(low, high)) {
+      break;
+    }
+    __m256i is_slash = _mm256_cmpeq_epi8(chars, mask_2f);
+    __m256i sextets = _mm256_add_epi8(
+        chars, _mm256_shuffle_epi8(lut_roll,
+                                   _mm256_add_epi8(is_slash, high_nibbles)));
+
+    // Merges the sextets of every 32-bit lane into 24 bits, then gathers the
+    // three bytes of each lane in big-endian order.
+    __m256i merged = _mm256_madd_epi16(
+        _mm256_maddubs_epi16(sextets, _mm256_set1_epi32(0x01400140)),
+        _mm256_set1_epi32(0x00011000));
+    __m256i bytes = _mm256_permutevar8x32_epi32(
+        _mm256_shuffle_epi8(merged, gather),
+        _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(output + j),
+                     _mm256_castsi256_si128(bytes));
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(output + j + 16),
+                     _mm256_extracti128_si256(bytes, 1));
+  }
+  return i;
+}
+
+#else
+
+size_t EncodeHexAvx2(const uint8_t*, size_t, char*) { return 0; }
+size_t DecodeHexAvx2(const char*, size_t, uint8_t*) { return 0; }
+size_t EncodeBase64Avx2(const uint8_t*, size_t, char*) { return 0; }
+size_t DecodeBase64Avx2(const char*, size_t, uint8_t*) { return 0; }
+
+#endif
+
+// Matches the chars std::isspace() accepts in the "C" locale.
+bool IsWhitespace(char c) { return c == ' ' || (c >= '\t' && c <= '\r'); }
+
+// Returns the number of chars in `input` that are decoded.
+size_t CountEncodedChars(std::string_view input,
+                         const DecodeOptions& options) {
+  if (!options.skip_whitespace) {
+    return input.size();
+  }
+  return std::count_if(input.begin(), input.end(),
+                       [](char c) { return !IsWhitespace(c); });
+}
+
+// Calls `decode_run` with the bounds [begin, end) of each run of `input`
+// between whitespace, or once with all of `input` if whitespace is not
+// skipped. Stops at the first error.
+template <typename DecodeRunFunc>
+absl::Status ForEachRun(std::string_view input, const DecodeOptions& options,
+                        DecodeRunFunc decode_run) {
+  if (!options.skip_whitespace) {
+    return decode_run(0, input.size());
+  }
+  size_t i = 0;
+  while (i < input.size()) {
+    while (i < input.size() && IsWhitespace(input[i])) {
+      ++i;
+    }
+    const size_t begin = i;
+    while (i < input.size() && !IsWhitespace(input[i])) {
+      ++i;
+    }
+    if (begin < i) {
+      RETURN_IF_ERROR(decode_run(begin, i));
+    }
+  }
+  return absl::OkStatus();
+}
+
+// Decodes hex digits into `output` one run at a time. A digit left unpaired at
+// the end of a run is paired with the first digit of the next one.
+class HexDecoder {
+ public:
+  HexDecoder(std::string_view input, std::span<uint8_t> output)
+      : input_(input), output_(output) {}
+
+  // Decodes input_[begin, end), which has no whitespace.
+  absl::Status DecodeRun(size_t begin, size_t end) {
+    size_t i = begin;
+    if (has_pending_ && i < end) {
+      RETURN_IF_ERROR(AddDigit(i++));
+    }
+
+    // Whole pairs that fit in the output take the fast paths. Anything they
+    // stop at goes through AddDigit(), which reports the exact error.
+    size_t num_pairs = std::min((end - i) / 2, output_.size() - size_);
+    if (HasAvx2()) {
+      size_t num_chars =
+          DecodeHexAvx2(input_.data() + i, num_pairs * 2, output_.data() + size_);
+      i += num_chars;
+      size_ += num_chars / 2;
+      num_pairs -= num_chars / 2;
+    }
+    for (; num_pairs > 0; --num_pairs, i += 2) {
+      uint8_t high = hex_values[static_cast<uint8_t>(input_[i])];
+      uint8_t low = hex_values[static_cast<uint8_t>(input_[i + 1])];
+      if ((high | low) == INVALID_VALUE) {
+        break;
+      }
+      output_[size_++] = high << 4 | low;
+    }
+
+    for (; i < end; ++i) {
+      RETURN_IF_ERROR(AddDigit(i));
+    }
+    return absl::OkStatus();
+  }
+
+  // Flushes an unpaired last digit and returns the number of bytes written.
+  absl::StatusOr<size_t> Finish(const DecodeOptions& options) {
+    if (has_pending_) {
+      if (options.strict) {
+        return absl::InvalidArgumentError(
+            "Hex input has an odd number of digits");
+      }
+      // A trailing odd digit is padded with 0 to the nearest byte.
+      RETURN_IF_ERROR(Write(pending_ << 4));
+    }
+    return size_;
+  }
+
+ private:
+  absl::Status AddDigit(size_t position) {
+    uint8_t value = hex_values[static_cast<uint8_t>(input_[position])];
+    if (value == INVALID_VALUE) {
+      return MalformedCharError("hex", input_, position);
+    }
+    if (!has_pending_) {
+      pending_ = value;
+      has_pending_ = true;
+      return absl::OkStatus();
+    }
+    has_pending_ = false;
+    return Write(pending_ << 4 | value);
+  }
+
+  absl::Status Write(uint8_t byte) {
+    if (size_ == output_.size()) {
+      return absl::InvalidArgumentError("Output is too small for hex input");
+    }
+    output_[size_++] = byte;
+    return absl::OkStatus();
+  }
+
+  const std::string_view input_;
+  const std::span<uint8_t> output_;
+  size_t size_ = 0;
+  uint8_t pending_ = 0;
+  bool has_pending_ = false;
+};
+
+// Decodes base64 into `output` one run at a time. A group of four chars may be
+// split across runs. '=' may only fill the last one or two chars of the last
+// group.
+class Base64Decoder {
+ public:
+  Base64Decoder(std::string_view input, std::span<uint8_t> output)
+      : input_(input), output_(output) {}
+
+  // Decodes input_[begin, end), which has no whitespace.
+  absl::Status DecodeRun(size_t begin, size_t end) {
+    size_t i = begin;
+    while (num_chars_ > 0 && i < end) {
+      RETURN_IF_ERROR(AddChar(i++));
+    }
+
+    // Whole groups that fit in the output take the fast paths. Anything they
+    // stop at, including padding, goes through AddChar(), which reports the
+    // exact error.
+    size_t num_groups = 0;
+    if (!padded_) {
+      num_groups = std::min((end - i) / 4, (output_.size() - size_) / 3);
+    }
+    if (HasAvx2()) {
+      size_t num_chars = DecodeBase64Avx2(input_.data() + i, num_groups * 4,
+                                          output_.data() + size_);
+      i += num_chars;
+      size_ += num_chars / 4 * 3;
+      num_groups -= num_chars / 4;
+    }
+    for (; num_groups > 0; --num_groups, i += 4) {
+      // For each chunk of 4 encoded characters, compress the four characters
+      // into three bytes. For example,
+      //   AAAAAA BBBBBB CCCCCC DDDDDD becomes AAAAAABB BBBBCCCC CCDDDDDD
+      uint8_t a = base64_values[static_cast<uint8_t>(input_[i])];
+      uint8_t b = base64_values[static_cast<uint8_t>(input_[i + 1])];
+      uint8_t c = base64_values[static_cast<uint8_t>(input_[i + 2])];
+      uint8_t d = base64_values[static_cast<uint8_t>(input_[i + 3])];
+      if ((a | b | c | d) == INVALID_VALUE) {
+        break;
+      }
+      uint32_t chunk = a << 18 | b << 12 | c << 6 | d;
+      output_[size_] = chunk >> 16;
+      output_[size_ + 1] = chunk >> 8 & 0xFF;
+      output_[size_ + 2] = chunk & 0xFF;
+      size_ += 3;
+    }
+
+    for (; i < end; ++i) {
+      RETURN_IF_ERROR(AddChar(i));
+    }
+    return absl::OkStatus();
+  }
+
+  // Flushes an incomplete last group and returns the number of bytes written.
+  absl::StatusOr<size_t> Finish(const DecodeOptions& options) {
+    if (num_chars_ > 0) {
+      if (options.strict) {
+        return absl::InvalidArgumentError(
+            "Base64 input ends with an incomplete group");
+      }
+      // An unpadded last group of n chars decodes to n bytes, as if it were
+      // filled with 'A'.
+      size_t num_bytes = num_chars_;
+      if (num_padding_ > 0) {
+        num_bytes = num_chars_ - num_padding_ - 1;
+      }
+      RETURN_IF_ERROR(WriteChunk(num_bytes));
+    }
+    return size_;
+  }
+
+ private:
+  absl::Status AddChar(size_t position) {
+    const char c = input_[position];
+    if (padded_) {
+      return MalformedCharError("base64", input_, position);
+    }
+    if (c == base64_padding) {
+      if (num_chars_ < 2) {
+        return MalformedCharError("base64", input_, position);
+      }
+      ++num_padding_;
+    } else {
+      uint8_t value = base64_values[static_cast<uint8_t>(c)];
+      if (value == INVALID_VALUE || num_padding_ > 0) {
+        return MalformedCharError("base64", input_, position);
+      }
+      chunk_ |= value << (18 - 6 * num_chars_);
+    }
+
+    if (++num_chars_ == 4) {
+      RETURN_IF_ERROR(WriteChunk(3 - num_padding_));
+      padded_ = num_padding_ > 0;
+      num_chars_ = 0;
+      chunk_ = 0;
+    }
+    return absl::OkStatus();
+  }
+
+  // Writes the first `num_bytes` bytes of the current group.
+  absl::Status WriteChunk(size_t num_bytes) {
+    if (output_.size() - size_ < num_bytes) {
+      return absl::InvalidArgumentError("Output is too small for base64 input");
+    }
+    for (size_t k = 0; k < num_bytes; ++k) {
+      output_[size_++] = chunk_ >> (16 - 8 * k) & 0xFF;
+    }
+    return absl::OkStatus();
+  }
+
+  const std::string_view input_;
+  const std::span<uint8_t> output_;
+  size_t size_ = 0;
+  // The value of the group being decoded, its number of chars so far, and how
+  // many of them are padding.
+  uint32_t chunk_ = 0;
+  size_t num_chars_ = 0;
+  size_t num_padding_ = 0;
+  // Set once a padded group is complete, after which the input must end.
+  bool padded_ = false;
+};
+
+}  // namespace
+
+void EncodeHex(std::span<const uint8_t> input, std::span<char> output) {
+  size_t i = HasAvx2() ? EncodeHexAvx2(input.data(), input.size(),
+                                       output.data())
+                       : 0;
+  for (; i < input.size(); ++i) {
+    output[2 * i] = hex_chars[input[i] >> 4];
+    output[2 * i + 1] = hex_chars[input[i] & 0x0F];
+  }
+}
+
+size_t HexDecodedSize(std::string_view input, const DecodeOptions& options) {
+  return HexDecodedSize(CountEncodedChars(input, options));
+}
+
+absl::StatusOr<size_t> DecodeHex(std::string_view input,
+                                 std::span<uint8_t> output,
+                                 const DecodeOptions& options) {
+  HexDecoder decoder(input, output);
+  RETURN_IF_ERROR(ForEachRun(input, options, [&](size_t begin, size_t end) {
+    return decoder.DecodeRun(begin, end);
+  }));
+  return decoder.Finish(options);
+}
+
+void EncodeBase64(std::span<const uint8_t> input, std::span<char> output) {
+  size_t i = HasAvx2() ? EncodeBase64Avx2(input.data(), input.size(),
+                                          output.data())
+                       : 0;
+  size_t j = i / 3 * 4;
+  for (; i + 3 <= input.size(); i += 3, j += 4) {
+    // For each chunk of 3 bytes, decompress the three 8-bit values into four
+    // 6-bit values. For example,
+    //   AAAAAAAA BBBBBBBB CCCCCCCC becomes 00AAAAAA 00AABBBB 00BBBBCC 00CCCCCC
+    uint32_t chunk = input[i] << 16 | input[i + 1] << 8 | input[i + 2];
+    output[j] = base64_chars[chunk >> 18];
+    output[j + 1] = base64_chars[chunk >> 12 & 0x3F];
+    output[j + 2] = base64_chars[chunk >> 6 & 0x3F];
+    output[j + 3] = base64_chars[chunk & 0x3F];
+  }
+
+  size_t bytes_left = input.size() - i;
+  if (bytes_left == 0) {
+    return;
+  }
+  uint32_t chunk = input[i] << 16;
+  if (bytes_left > 1) {
+    chunk |= input[i + 1] << 8;
+  }
+  output[j] = base64_chars[chunk >> 18];
+  output[j + 1] = base64_chars[chunk >> 12 & 0x3F];
+  output[j + 2] =
+      bytes_left > 1 ? base64_chars[chunk >> 6 & 0x3F] : base64_padding;
+  output[j + 3] = base64_padding;
+}
+
+size_t Base64DecodedSize(std::string_view input,
+                         const DecodeOptions& options) {
+  const size_t num_chars = CountEncodedChars(input, options);
+
+  // Counts the padding at the end, ignoring any whitespace after it.
+  size_t num_padding = 0;
+  for (size_t i = input.size(); i > 0 && num_padding < 2; --i) {
+    if (input[i - 1] == base64_padding) {
+      ++num_padding;
+    } else if (!options.skip_whitespace || !IsWhitespace(input[i - 1])) {
+      break;
+    }
+  }
+
+  const size_t num_groups = num_chars / 4;
+  const size_t num_left = num_chars % 4;
+  if (num_left == 0) {
+    return num_groups * 3 - std::min(num_padding, num_groups * 3);
+  }
+  // Matches Base64Decoder::Finish() for an incomplete last group.
+  size_t num_last = num_left;
+  if (num_padding > 0) {
+    num_last = num_left > num_padding ? num_left - num_padding - 1 : 0;
+  }
+  return num_groups * 3 + num_last;
+}
+
+absl::StatusOr<size_t> DecodeBase64(std::string_view input,
+                                    std::span<uint8_t> output,
+                                    const DecodeOptions& options) {
+  Base64Decoder decoder(input, output);
+  RETURN_IF_ERROR(ForEachRun(input, options, [&](size_t begin, size_t end) {
+    return decoder.DecodeRun(begin, end);
+  }));
+  return decoder.Finish(options);
+}
+
+}  // namespace cryptopals::util
@@ -0,0 +1,85 @@
+// Hex and base64 encoders and decoders that work on caller-provided buffers.
+// Whole blocks are converted with AVX2 when the processor supports it and with
+// lookup tables otherwise.
+
+#ifndef CRYPTOPALS_UTIL_CODECS_H_
+#define CRYPTOPALS_UTIL_CODECS_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+#include "absl/status/statusor.h"
+
+namespace cryptopals::util {
+
+// Returns the number of chars needed to hex-encode `size` bytes.
+inline constexpr size_t HexEncodedSize(size_t size) { return size * 2; }
+
+// Returns the number of bytes decoded from `size` hex chars. A trailing odd
+// digit fills the high nibble of one more byte.
+inline constexpr size_t HexDecodedSize(size_t size) { return (size + 1) / 2; }
+
+// Returns the number of chars needed to base64-encode `size` bytes, including
+// padding.
+inline constexpr size_t Base64EncodedSize(size_t size) {
+  return (size + 2) / 3 * 4;
+}
+
+// Returns the largest number of bytes that `size` base64 chars decode to.
+inline constexpr size_t Base64DecodedMaxSize(size_t size) {
+  return (size + 3) / 4 * 3;
+}
+
+struct DecodeOptions {
+  // Rejects input that does not end on a whole byte: an odd number of hex
+  // digits, or base64 whose last group has fewer than four chars.
+  bool strict = false;
+  // Skips ASCII whitespace anywhere in the input, including inside a group.
+  bool skip_whitespace = false;
+};
+
+// The options for decoding text read from files and flags.
+inline constexpr DecodeOptions STRICT_DECODE_OPTIONS = {
+    .strict = true,
+    .skip_whitespace = true,
+};
+
+// Writes the lowercase hex encoding of `input` to `output`, which must hold
+// exactly HexEncodedSize(input.size()) chars.
+void EncodeHex(std::span<const uint8_t> input, std::span<char> output);
+
+// Returns the exact number of bytes that DecodeHex() writes for a well-formed
+// `input`.
+size_t HexDecodedSize(std::string_view input, const DecodeOptions& options);
+
+// Decodes the hex digits in `input` (either case) into `output`, which must
+// hold at least HexDecodedSize(input, options) bytes. Returns the number of
+// bytes written, or InvalidArgument naming the first malformed char. The
+// contents of `output` are unspecified after an error.
+absl::StatusOr<size_t> DecodeHex(std::string_view input,
+                                 std::span<uint8_t> output,
+                                 const DecodeOptions& options = {});
+
+// Writes the padded base64 encoding of `input` to `output`, which must hold
+// exactly Base64EncodedSize(input.size()) chars.
+void EncodeBase64(std::span<const uint8_t> input, std::span<char> output);
+
+// Returns the exact number of bytes that DecodeBase64() writes for a
+// well-formed `input`.
+size_t Base64DecodedSize(std::string_view input, const DecodeOptions& options);
+
+// Decodes the base64 string `input` into `output`, which must hold at least
+// Base64DecodedSize(input, options) bytes. '=' may only pad the last group of
+// four chars. Unless `options.strict` is set, an unpadded last group of n chars
+// decodes to n bytes, as if it were filled with 'A'. Returns the number of
+// bytes written, or InvalidArgument naming the first malformed char. The
+// contents of `output` are unspecified after an error.
+absl::StatusOr<size_t> DecodeBase64(std::string_view input,
+                                    std::span<uint8_t> output,
+                                    const DecodeOptions& options = {});
+
+}  // namespace cryptopals::util
+
+#endif
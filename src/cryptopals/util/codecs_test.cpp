@@ -0,0 +1,164 @@
+#include "cryptopals/util/codecs.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "absl/strings/escaping.h"
+#include "absl/strings/str_cat.h"
+#include "cryptopals/util/test_data.h"
+#include "googletest/status_matchers.h"
+#include "gtest/gtest.h"
+
+namespace cryptopals::util {
+namespace {
+
+// Long enough to exercise several vector blocks plus a tail.
+constexpr size_t MAX_TEST_SIZE = 200;
+
+std::string AsString(const std::vector<uint8_t>& bytes) {
+  return std::string(bytes.begin(), bytes.end());
+}
+
+TEST(CodecsTest, HexRoundTrip) {
+  for (size_t size = 0; size <= MAX_TEST_SIZE; ++size) {
+    std::vector<uint8_t> bytes = PatternedBytes(size);
+    std::string hex(HexEncodedSize(size), '\0');
+    EncodeHex(bytes, hex);
+    EXPECT_EQ(hex, absl::BytesToHexString(AsString(bytes)));
+
+    std::vector<uint8_t> decoded(HexDecodedSize(hex.size()));
+    ASSERT_OK_AND_ASSIGN(size_t decoded_size, DecodeHex(hex, decoded));
+    EXPECT_EQ(decoded_size, size);
+    EXPECT_EQ(decoded, bytes);
+  }
+}
+
+TEST(CodecsTest, DecodeHexAcceptsEitherCaseAndOddLength) {
+  std::vector<uint8_t> decoded(3);
+  ASSERT_OK_AND_ASSIGN(size_t size, DecodeHex("aBcDe", decoded));
+  EXPECT_EQ(size, 3);
+  EXPECT_EQ(decoded, std::vector<uint8_t>({0xAB, 0xCD, 0xE0}));
+}
+
+TEST(CodecsTest, DecodeHexReportsMalformedChar) {
+  std::vector<uint8_t> bytes = PatternedBytes(MAX_TEST_SIZE / 2);
+  std::string hex(HexEncodedSize(bytes.size()), '\0');
+  EncodeHex(bytes, hex);
+  std::vector<uint8_t> decoded(bytes.size());
+
+  for (size_t position : {0, 1, 63, 64, 150, 199}) {
+    std::string malformed = hex;
+    malformed[position] = 'g';
+    absl::StatusOr<size_t> size = DecodeHex(malformed, decoded);
+    ASSERT_EQ(size.status().code(), absl::StatusCode::kInvalidArgument);
+    EXPECT_NE(size.status().message().find(absl::StrCat("position ", position)),
+              std::string::npos)
+        << size.status();
+  }
+}
+
+TEST(CodecsTest, Base64RoundTrip) {
+  for (size_t size = 0; size <= MAX_TEST_SIZE; ++size) {
+    std::vector<uint8_t> bytes = PatternedBytes(size);
+    std::string base64(Base64EncodedSize(size), '\0');
+    EncodeBase64(bytes, base64);
+    EXPECT_EQ(base64, absl::Base64Escape(AsString(bytes)));
+
+    std::vector<uint8_t> decoded(Base64DecodedMaxSize(base64.size()));
+    ASSERT_OK_AND_ASSIGN(size_t decoded_size, DecodeBase64(base64, decoded));
+    decoded.resize(decoded_size);
+    EXPECT_EQ(decoded, bytes);
+  }
+}
+
+TEST(CodecsTest, DecodeBase64Padding) {
+  std::vector<uint8_t> decoded(Base64DecodedMaxSize(8));
+  EXPECT_EQ(DecodeBase64("AA==", decoded).value_or(0), 1);
+  EXPECT_EQ(DecodeBase64("ABA=", decoded).value_or(0), 2);
+  // An unpadded last group decodes as if it were filled with 'A'.
+  EXPECT_EQ(DecodeBase64("ABC", decoded).value_or(0), 3);
+  EXPECT_EQ(DecodeBase64("ABCDA", decoded).value_or(0), 4);
+
+  for (std::string_view malformed : {"A===", "AA=A", "AA==AAAA", "=AAA"}) {
+    EXPECT_EQ(DecodeBase64(malformed, decoded).status().code(),
+              absl::StatusCode::kInvalidArgument)
+        << malformed;
+  }
+}
+
+TEST(CodecsTest, DecodeBase64ReportsMalformedChar) {
+  std::vector<uint8_t> bytes = PatternedBytes(MAX_TEST_SIZE);
+  std::string base64(Base64EncodedSize(bytes.size()), '\0');
+  EncodeBase64(bytes, base64);
+  std::vector<uint8_t> decoded(Base64DecodedMaxSize(base64.size()));
+
+  for (size_t position : {0, 5, 31, 32, 100, 260}) {
+    std::string malformed = base64;
+    malformed[position] = '-';
+    absl::StatusOr<size_t> size = DecodeBase64(malformed, decoded);
+    ASSERT_EQ(size.status().code(), absl::StatusCode::kInvalidArgument);
+    EXPECT_NE(size.status().message().find(absl::StrCat("position ", position)),
+              std::string::npos)
+        << size.status();
+  }
+}
+
+TEST(CodecsTest, DecodeSkipsWhitespace) {
+  const DecodeOptions options = {.skip_whitespace = true};
+  std::vector<uint8_t> bytes = PatternedBytes(MAX_TEST_SIZE);
+  std::string base64(Base64EncodedSize(bytes.size()), '\0');
+  EncodeBase64(bytes, base64);
+  std::string hex(HexEncodedSize(bytes.size()), '\0');
+  EncodeHex(bytes, hex);
+
+  // Breaks lines at odd positions so groups and pairs are split.
+  for (std::string* encoded : {&base64, &hex}) {
+    for (size_t i = 37; i < encoded->size(); i += 38) {
+      encoded->insert(i, i % 3 == 0 ? "\r\n" : " \t");
+    }
+    encoded->append("\n");
+  }
+
+  std::vector<uint8_t> decoded(Base64DecodedSize(base64, options));
+  ASSERT_EQ(decoded.size(), bytes.size());
+  ASSERT_OK_AND_ASSIGN(size_t size, DecodeBase64(base64, decoded, options));
+  EXPECT_EQ(size, bytes.size());
+  EXPECT_EQ(decoded, bytes);
+
+  decoded.assign(HexDecodedSize(hex, options), 0);
+  ASSERT_EQ(decoded.size(), bytes.size());
+  ASSERT_OK_AND_ASSIGN(size, DecodeHex(hex, decoded, options));
+  EXPECT_EQ(size, bytes.size());
+  EXPECT_EQ(decoded, bytes);
+
+  // Whitespace is malformed unless it is skipped.
+  EXPECT_EQ(DecodeHex("ab cd", decoded).status().code(),
+            absl::StatusCode::kInvalidArgument);
+}
+
+TEST(CodecsTest, DecodeStrict) {
+  std::vector<uint8_t> decoded(Base64DecodedMaxSize(8));
+  EXPECT_EQ(DecodeHex("abc", decoded, STRICT_DECODE_OPTIONS).status().code(),
+            absl::StatusCode::kInvalidArgument);
+  EXPECT_EQ(DecodeBase64("ABC", decoded, STRICT_DECODE_OPTIONS).status().code(),
+            absl::StatusCode::kInvalidArgument);
+  EXPECT_EQ(
+      DecodeBase64("AB=", decoded, STRICT_DECODE_OPTIONS).status().code(),
+      absl::StatusCode::kInvalidArgument);
+  EXPECT_EQ(
+      DecodeBase64("ABCD AB=\n=", decoded, STRICT_DECODE_OPTIONS).value_or(0),
+      4);
+  EXPECT_EQ(Base64DecodedSize("ABCD AB=\n=", STRICT_DECODE_OPTIONS), 4);
+}
+
+TEST(CodecsTest, DecodeRejectsSmallOutput) {
+  std::vector<uint8_t> decoded(1);
+  EXPECT_EQ(DecodeHex("abcd", decoded).status().code(),
+            absl::StatusCode::kInvalidArgument);
+  EXPECT_EQ(DecodeBase64("AAAA", decoded).status().code(),
+            absl::StatusCode::kInvalidArgument);
+}
+
+}  // namespace
+}  // namespace cryptopals::util
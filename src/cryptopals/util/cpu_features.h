@@ -0,0 +1,22 @@
+// Runtime detection of optional instruction sets. Code compiled for one of
+// them with __attribute__((target(...))) must only run once the matching
+// check here has passed.
+
+#ifndef CRYPTOPALS_UTIL_CPU_FEATURES_H_
+#define CRYPTOPALS_UTIL_CPU_FEATURES_H_
+
+namespace cryptopals::util {
+
+// Returns true if the processor and operating system support AVX2.
+inline bool HasAvx2() {
+#if defined(__x86_64__) || defined(__i386__)
+  static const bool has_avx2 = __builtin_cpu_supports("avx2");
+  return has_avx2;
+#else
+  return false;
+#endif
+}
+
+}  // namespace cryptopals::util
+
+#endif  // CRYPTOPALS_UTIL_CPU_FEATURES_H_
@@ -0,0 +1,110 @@
+#include "cryptopals/util/hamming_distance.h"
+
+#include <bit>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+#include "cryptopals/util/cpu_features.h"
+#include "cryptopals/util/logging.h"
+
+namespace cryptopals::util {
+namespace {
+
+// Each function below returns the number of bytes it compared and adds the
+// distance over them to `distance`. The caller finishes the remaining tail.
+
+constexpr size_t AVX2_BYTES = 32;
+
+#if defined(__x86_64__) || defined(__i386__)
+
+// The number of vectors whose per-byte counts, at most 8 each, are summed
+// before they are widened. 31 vectors stay below 256 per byte.
+constexpr size_t AVX2_MAX_VECTORS_PER_BATCH = 31;
+
+// Compiled for processors with AVX2 regardless of the flags used for the rest
+// of the build, and only reached after HasAvx2() has been checked. Bits are
+// counted a nibble at a time with a shuffle, and the byte counts are summed
+// into 64-bit lanes with a sum of absolute differences against zero.
+__attribute__((target("avx2"))) size_t HammingDistanceAvx2(
+    const uint8_t* lhs, const uint8_t* rhs, size_t size, uint64_t& distance) {
+  const __m256i nibble_counts =
+      _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4, 0, 1, 1,
+                       2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+  const __m256i low_nibbles = _mm256_set1_epi8(0x0F);
+
+  __m256i totals = _mm256_setzero_si256();
+  size_t i = 0;
+  while (i + AVX2_BYTES <= size) {
+    __m256i byte_counts = _mm256_setzero_si256();
+    for (size_t vectors = 0;
+         vectors < AVX2_MAX_VECTORS_PER_BATCH && i + AVX2_BYTES <= size;
+         ++vectors, i += AVX2_BYTES) {
+      const __m256i difference = _mm256_xor_si256(
+          _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lhs + i)),
+          _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rhs + i)));
+      byte_counts = _mm256_add_epi8(
+          byte_counts,
+          _mm256_add_epi8(
+              _mm256_shuffle_epi8(nibble_counts,
+                                  _mm256_and_si256(difference, low_nibbles)),
+              _mm256_shuffle_epi8(
+                  nibble_counts,
+                  _mm256_and_si256(_mm256_srli_epi16(difference, 4),
+                                   low_nibbles))));
+    }
+    totals = _mm256_add_epi64(
+        totals, _mm256_sad_epu8(byte_counts, _mm256_setzero_si256()));
+  }
+
+  distance += static_cast<uint64_t>(_mm256_extract_epi64(totals, 0)) +
+              static_cast<uint64_t>(_mm256_extract_epi64(totals, 1)) +
+              static_cast<uint64_t>(_mm256_extract_epi64(totals, 2)) +
+              static_cast<uint64_t>(_mm256_extract_epi64(totals, 3));
+  return i;
+}
+
+#else
+
+size_t HammingDistanceAvx2(const uint8_t*, const uint8_t*, size_t, uint64_t&) {
+  return 0;
+}
+
+#endif
+
+// The portable version of the above, working on 64-bit words.
+constexpr size_t WORD_BYTES = sizeof(uint64_t);
+
+size_t HammingDistanceWords(const uint8_t* lhs, const uint8_t* rhs,
+                            size_t size, uint64_t& distance) {
+  size_t i = 0;
+  for (; i + WORD_BYTES <= size; i += WORD_BYTES) {
+    uint64_t lhs_word, rhs_word;
+    std::memcpy(&lhs_word, lhs + i, WORD_BYTES);
+    std::memcpy(&rhs_word, rhs + i, WORD_BYTES);
+    distance += std::popcount(lhs_word ^ rhs_word);
+  }
+  return i;
+}
+
+}  // namespace
+
+uint64_t HammingDistance(std::span<const uint8_t> lhs,
+                         std::span<const uint8_t> rhs) {
+  CHECK_EQ(lhs.size(), rhs.size());
+  uint64_t distance = 0;
+  size_t i = lhs.size() >= AVX2_BYTES && HasAvx2()
+                 ? HammingDistanceAvx2(lhs.data(), rhs.data(), lhs.size(),
+                                       distance)
+                 : 0;
+  i += HammingDistanceWords(lhs.data() + i, rhs.data() + i, lhs.size() - i,
+                            distance);
+  for (; i < lhs.size(); ++i) {
+    distance += std::popcount(static_cast<uint8_t>(lhs[i] ^ rhs[i]));
+  }
+  return distance;
+}
+
+}  // namespace cryptopals::util
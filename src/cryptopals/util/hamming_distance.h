@@ -0,0 +1,19 @@
+// Counting the bits that differ between two buffers.
+
+#ifndef CRYPTOPALS_UTIL_HAMMING_DISTANCE_H_
+#define CRYPTOPALS_UTIL_HAMMING_DISTANCE_H_
+
+#include <cstdint>
+#include <span>
+
+namespace cryptopals::util {
+
+// Returns the number of bits that differ between `lhs` and `rhs`, which must
+// have the same size. The buffers may overlap, so the distance between
+// consecutive blocks of one buffer is the distance between two offsets of it.
+uint64_t HammingDistance(std::span<const uint8_t> lhs,
+                         std::span<const uint8_t> rhs);
+
+}  // namespace cryptopals::util
+
+#endif  // CRYPTOPALS_UTIL_HAMMING_DISTANCE_H_
@@ -0,0 +1,63 @@
+#include "cryptopals/util/hamming_distance.h"
+
+#include <bit>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "cryptopals/util/test_data.h"
+#include "gtest/gtest.h"
+
+namespace cryptopals::util {
+namespace {
+
+uint64_t BytewiseHammingDistance(std::span<const uint8_t> lhs,
+                                 std::span<const uint8_t> rhs) {
+  uint64_t distance = 0;
+  for (size_t i = 0; i < lhs.size(); ++i) {
+    distance += std::popcount(static_cast<uint8_t>(lhs[i] ^ rhs[i]));
+  }
+  return distance;
+}
+
+TEST(HammingDistanceTest, Example) {
+  std::string_view lhs = "this is a test";
+  std::string_view rhs = "wokka wokka!!!";
+  EXPECT_EQ(HammingDistance(
+                std::span(reinterpret_cast<const uint8_t*>(lhs.data()),
+                          lhs.size()),
+                std::span(reinterpret_cast<const uint8_t*>(rhs.data()),
+                          rhs.size())),
+            37);
+}
+
+// Covers inputs shorter than a word, with and without a tail, and long enough
+// for the vector counts to be widened several times.
+TEST(HammingDistanceTest, MatchesBytewiseDistance) {
+  const std::vector<uint8_t> lhs = PatternedBytes(5000, 13);
+  const std::vector<uint8_t> rhs = PatternedBytes(5000, 91);
+  for (size_t size : {0, 1, 7, 8, 31, 32, 33, 100, 993, 992, 1000, 5000}) {
+    std::span<const uint8_t> lhs_span = std::span(lhs).first(size);
+    std::span<const uint8_t> rhs_span = std::span(rhs).last(size);
+    EXPECT_EQ(HammingDistance(lhs_span, rhs_span),
+              BytewiseHammingDistance(lhs_span, rhs_span))
+        << "size=" << size;
+  }
+}
+
+TEST(HammingDistanceTest, AllBitsDiffer) {
+  const std::vector<uint8_t> zeros(4000, 0x00);
+  const std::vector<uint8_t> ones(4000, 0xFF);
+  EXPECT_EQ(HammingDistance(zeros, ones), 8 * 4000);
+  EXPECT_EQ(HammingDistance(ones, ones), 0);
+}
+
+TEST(HammingDistanceTest, OverlappingBuffers) {
+  const std::vector<uint8_t> bytes = PatternedBytes(300, 13);
+  std::span<const uint8_t> span = bytes;
+  EXPECT_EQ(HammingDistance(span.first(290), span.last(290)),
+            BytewiseHammingDistance(span.first(290), span.last(290)));
+}
+
+}  // namespace
+}  // namespace cryptopals::util
@@ -12,6 +12,11 @@
 #include "absl/strings/str_join.h"
 #include "absl/time/time.h"
 #include "cryptopals/util/logging.h"
+#include "cryptopals/util/thread_pool.h"
+
+ABSL_FLAG(size_t, threads, 0,
+          "the number of threads used for parallel work, including the main "
+          "thread; 0 uses one per hardware thread");
 
 namespace cryptopals::util {
 namespace {
@@ -66,6 +71,11 @@ void InitCryptopals(std::string_view usage, int argc, char** argv) {
   absl::SetProgramUsageMessage(usage);
   absl::ParseCommandLine(argc, argv);
   InitLogging(argc, argv);
+
+  absl::Status status =
+      ThreadPool::SetDefaultNumThreads(absl::GetFlag(FLAGS_threads));
+  CHECK(status.ok()) << status;
+  LOG(INFO) << "Threads: " << ThreadPool::DefaultNumThreads();
 }
 
 }  // namespace cryptopals::util
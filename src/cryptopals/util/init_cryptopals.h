@@ -5,7 +5,8 @@
 
 namespace cryptopals::util {
 
-// Initializes common binary utilities for Cryptopals.
+// Initializes common binary utilities for Cryptopals: parses the flags, sets up
+// logging, and sizes the shared ThreadPool from --threads.
 void InitCryptopals(std::string_view usage, int argc, char** argv);
 
 }  // namespace cryptopals::util
@@ -0,0 +1,151 @@
+#include "cryptopals/util/mapped_file.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <utility>
+
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+
+namespace cryptopals::util {
+namespace {
+
+// The number of bytes read at a time from files that cannot be mapped.
+constexpr size_t READ_CHUNK_BYTES = 1 << 16;
+
+// Closes a file descriptor when it goes out of scope.
+class ScopedFd {
+ public:
+  explicit ScopedFd(int fd) : fd_(fd) {}
+  ~ScopedFd() {
+    if (fd_ >= 0) {
+      close(fd_);
+    }
+  }
+
+  ScopedFd(const ScopedFd&) = delete;
+  ScopedFd& operator=(const ScopedFd&) = delete;
+
+  int get() const { return fd_; }
+
+ private:
+  int fd_;
+};
+
+// Returns the error status for the failure of `operation` on `path`, as
+// reported by errno.
+absl::Status FileError(const char* operation, const std::string& path) {
+  const int error_number = errno;
+  return absl::Status(absl::ErrnoToStatusCode(error_number),
+                      absl::StrCat("Failed to ", operation, " ", path, ": ",
+                                   std::strerror(error_number)));
+}
+
+}  // namespace
+
+absl::StatusOr<MappedFile> MappedFile::Create(const std::string& path) {
+  ScopedFd fd(open(path.c_str(), O_RDONLY | O_CLOEXEC));
+  if (fd.get() < 0) {
+    return FileError("open", path);
+  }
+  struct stat file_stat;
+  if (fstat(fd.get(), &file_stat) != 0) {
+    return FileError("stat", path);
+  }
+
+  MappedFile mapped_file;
+  if (S_ISREG(file_stat.st_mode)) {
+    const size_t size = static_cast<size_t>(file_stat.st_size);
+    // Empty files cannot be mapped, and have no contents to map anyway.
+    if (size == 0) {
+      return mapped_file;
+    }
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd.get(), 0);
+    if (mapping != MAP_FAILED) {
+      // The hint only affects read-ahead, so a failure is not an error.
+      madvise(mapping, size, MADV_SEQUENTIAL);
+      mapped_file.mapping_ = mapping;
+      mapped_file.mapping_size_ = size;
+      mapped_file.contents_ =
+          std::string_view(static_cast<const char*>(mapping), size);
+      return mapped_file;
+    }
+  }
+
+  // Pipes, terminals and files on filesystems without mmap support are read
+  // into memory instead.
+  while (true) {
+    const size_t offset = mapped_file.buffer_.size();
+    mapped_file.buffer_.resize(offset + READ_CHUNK_BYTES);
+    const ssize_t bytes_read =
+        read(fd.get(), mapped_file.buffer_.data() + offset, READ_CHUNK_BYTES);
+    if (bytes_read < 0) {
+      if (errno == EINTR) {
+        mapped_file.buffer_.resize(offset);
+        continue;
+      }
+      return FileError("read", path);
+    }
+    mapped_file.buffer_.resize(offset + static_cast<size_t>(bytes_read));
+    if (bytes_read == 0) {
+      break;
+    }
+  }
+  mapped_file.contents_ = std::string_view(mapped_file.buffer_.data(),
+                                           mapped_file.buffer_.size());
+  return mapped_file;
+}
+
+MappedFile::MappedFile(MappedFile&& other)
+    : mapping_(std::exchange(other.mapping_, nullptr)),
+      mapping_size_(std::exchange(other.mapping_size_, 0)),
+      released_size_(std::exchange(other.released_size_, 0)),
+      buffer_(std::move(other.buffer_)),
+      contents_(std::exchange(other.contents_, {})) {}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) {
+  if (this != &other) {
+    Reset();
+    mapping_ = std::exchange(other.mapping_, nullptr);
+    mapping_size_ = std::exchange(other.mapping_size_, 0);
+    released_size_ = std::exchange(other.released_size_, 0);
+    buffer_ = std::move(other.buffer_);
+    contents_ = std::exchange(other.contents_, {});
+  }
+  return *this;
+}
+
+MappedFile::~MappedFile() { Reset(); }
+
+void MappedFile::ReleaseBefore(size_t offset) {
+  if (mapping_ == nullptr) {
+    return;
+  }
+  const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  const size_t end = std::min(offset, mapping_size_) / page_size * page_size;
+  if (end > released_size_) {
+    // The mapping is never written, so dropped pages are read again from the
+    // file if they are needed. Like the read-ahead hint, a failure only costs
+    // memory.
+    madvise(static_cast<char*>(mapping_) + released_size_,
+            end - released_size_, MADV_DONTNEED);
+    released_size_ = end;
+  }
+}
+
+void MappedFile::Reset() {
+  if (mapping_ != nullptr) {
+    munmap(mapping_, mapping_size_);
+    mapping_ = nullptr;
+    mapping_size_ = 0;
+    released_size_ = 0;
+  }
+}
+
+}  // namespace cryptopals::util
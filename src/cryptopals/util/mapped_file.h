@@ -0,0 +1,56 @@
+#ifndef CRYPTOPALS_UTIL_MAPPED_FILE_H_
+#define CRYPTOPALS_UTIL_MAPPED_FILE_H_
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "absl/status/statusor.h"
+
+namespace cryptopals::util {
+
+// The read-only contents of a file, mapped into memory so that they are paged
+// in on demand instead of copied. Files that cannot be mapped, such as pipes,
+// are read into a buffer instead. Views of contents() stay valid until the
+// MappedFile is destroyed, including across moves.
+class MappedFile {
+ public:
+  // Maps the file at `path`, hinting to the kernel that it will be read
+  // sequentially. Returns an error status if the file cannot be opened or
+  // read.
+  static absl::StatusOr<MappedFile> Create(const std::string& path);
+
+  MappedFile(MappedFile&& other);
+  MappedFile& operator=(MappedFile&& other);
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  std::string_view contents() const { return contents_; }
+
+  // Tells the kernel that the contents before `offset` will not be read again
+  // soon, so that the whole pages holding them can be dropped from memory.
+  // Views of them stay valid: reading them again pages them back in from the
+  // file. Does nothing for contents that were read into a buffer.
+  void ReleaseBefore(size_t offset);
+
+ private:
+  MappedFile() = default;
+
+  // Unmaps the file, if it was mapped.
+  void Reset();
+
+  // The mapped pages, or null if the contents are held in `buffer_`.
+  void* mapping_ = nullptr;
+  size_t mapping_size_ = 0;
+  // The size of the prefix of the mapping released by ReleaseBefore().
+  size_t released_size_ = 0;
+  std::vector<char> buffer_;
+  std::string_view contents_;
+};
+
+}  // namespace cryptopals::util
+
+#endif  // CRYPTOPALS_UTIL_MAPPED_FILE_H_
@@ -0,0 +1,70 @@
+#include "cryptopals/util/mapped_file.h"
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <utility>
+
+#include "absl/status/status.h"
+#include "googletest/status_matchers.h"
+#include "gtest/gtest.h"
+
+namespace cryptopals::util {
+namespace {
+
+std::string WriteTestFile(const std::string& name,
+                          const std::string& contents) {
+  std::string path = ::testing::TempDir() + name;
+  std::ofstream(path, std::ios::binary) << contents;
+  return path;
+}
+
+TEST(MappedFileTest, MapsContents) {
+  std::string contents(100000, '\0');
+  for (size_t i = 0; i < contents.size(); ++i) {
+    contents[i] = static_cast<char>(i * 7 + i / 300);
+  }
+  const std::string path = WriteTestFile("mapped_file_test_contents", contents);
+
+  ASSERT_OK_AND_ASSIGN(MappedFile file, MappedFile::Create(path));
+  EXPECT_EQ(file.contents(), contents);
+
+  // Views of the contents stay valid when the file is moved.
+  std::string_view view = file.contents();
+  MappedFile moved_file = std::move(file);
+  EXPECT_EQ(moved_file.contents().data(), view.data());
+  EXPECT_EQ(view, contents);
+  std::remove(path.c_str());
+}
+
+TEST(MappedFileTest, ContentsStayValidAfterRelease) {
+  std::string contents(3 * 4096 + 100, '\0');
+  for (size_t i = 0; i < contents.size(); ++i) {
+    contents[i] = static_cast<char>(i * 13 + i / 500);
+  }
+  const std::string path = WriteTestFile("mapped_file_test_release", contents);
+
+  ASSERT_OK_AND_ASSIGN(MappedFile file, MappedFile::Create(path));
+  file.ReleaseBefore(5000);
+  file.ReleaseBefore(100);
+  file.ReleaseBefore(contents.size() + 1);
+  EXPECT_EQ(file.contents(), contents);
+  std::remove(path.c_str());
+}
+
+TEST(MappedFileTest, EmptyFile) {
+  const std::string path = WriteTestFile("mapped_file_test_empty", "");
+  ASSERT_OK_AND_ASSIGN(MappedFile file, MappedFile::Create(path));
+  EXPECT_TRUE(file.contents().empty());
+  std::remove(path.c_str());
+}
+
+TEST(MappedFileTest, MissingFile) {
+  EXPECT_EQ(MappedFile::Create(::testing::TempDir() + "mapped_file_test_none")
+                .status()
+                .code(),
+            absl::StatusCode::kNotFound);
+}
+
+}  // namespace
+}  // namespace cryptopals::util
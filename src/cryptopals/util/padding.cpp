@@ -27,4 +27,23 @@ absl::Status RemovePkcs7Padding(Bytes& input) {
   return absl::OkStatus();
 }
 
+void FillPkcs7Padding(std::span<uint8_t> block, size_t size) {
+  const uint8_t padding_size = block.size() - size;
+  std::fill(block.begin() + size, block.end(), padding_size);
+}
+
+absl::StatusOr<size_t> GetPkcs7PaddingSize(std::span<const uint8_t> block) {
+  if (block.empty()) {
+    return absl::InvalidArgumentError("block is empty");
+  }
+
+  const size_t padding_size = block.back();
+  if (padding_size == 0 || padding_size > block.size() ||
+      !std::all_of(block.end() - padding_size, block.end(),
+                   [=](uint8_t i) { return i == padding_size; })) {
+    return absl::InvalidArgumentError("input has malformed PKCS#7 padding");
+  }
+  return padding_size;
+}
+
 }  // namespace cryptopals::util
@@ -4,8 +4,10 @@
 #define CRYPTOPALS_UTIL_PADDING_H_
 
 #include <cstdint>
+#include <span>
 
 #include "absl/status/status.h"
+#include "absl/status/statusor.h"
 #include "cryptopals/util/bytes.h"
 
 namespace cryptopals::util {
@@ -16,6 +18,14 @@ void AddPkcs7Padding(Bytes& input, uint8_t block_size);
 // Removes PKCS#7 padding from `input`.
 absl::Status RemovePkcs7Padding(Bytes& input);
 
+// Fills `block` after its first `size` bytes with PKCS#7 padding. `size` must
+// be smaller than the size of `block`.
+void FillPkcs7Padding(std::span<uint8_t> block, size_t size);
+
+// Returns the number of PKCS#7 padding bytes at the end of `block`, which must
+// be the last block of a padded message.
+absl::StatusOr<size_t> GetPkcs7PaddingSize(std::span<const uint8_t> block);
+
 }  // namespace cryptopals::util
 
 #endif
@@ -1,5 +1,8 @@
 #include "cryptopals/util/padding.h"
 
+#include <span>
+#include <string_view>
+
 #include "googletest/status_matchers.h"
 #include "gtest/gtest.h"
 
@@ -35,5 +38,26 @@ TEST(PaddingTest, AddAndRemovePkcs7Padding) {
   EXPECT_EQ(input, expected_result);
 }
 
+TEST(PaddingTest, FillAndGetPkcs7PaddingSize) {
+  Bytes block = Bytes::CreateFromRaw("YELLOW SUBMARINE");
+  block.Resize(20);
+  std::span<uint8_t> block_span(block.begin(), block.size());
+
+  FillPkcs7Padding(block_span, 16);
+  EXPECT_EQ(block, Bytes::CreateFromRaw("YELLOW SUBMARINE\x04\x04\x04\x04"));
+  ASSERT_OK_AND_ASSIGN(size_t padding_size, GetPkcs7PaddingSize(block_span));
+  EXPECT_EQ(padding_size, 4);
+}
+
+TEST(PaddingTest, GetPkcs7PaddingSizeRejectsMalformedPadding) {
+  for (std::string_view input : {std::string_view("YELLOW SUBMARINE\x04\x04"),
+                                 std::string_view("YELLOW SUBMARINE\0", 17),
+                                 std::string_view("YELLOW\x20")}) {
+    Bytes block = Bytes::CreateFromRaw(input);
+    std::span<const uint8_t> block_span(block.begin(), block.size());
+    EXPECT_FALSE(GetPkcs7PaddingSize(block_span).ok()) << input;
+  }
+}
+
 }  // namespace
 }  // namespace cryptopals::util
@@ -0,0 +1,199 @@
+#include "cryptopals/util/record_pipeline.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "cryptopals/util/bounded_queue.h"
+
+namespace cryptopals::util {
+namespace {
+
+// A record on its way through the pipeline.
+struct Record {
+  // The first error for the record. The writer stops at it.
+  absl::Status status;
+
+  // The record as read, which `pin` keeps valid until it is decoded.
+  std::string_view text;
+  std::shared_ptr<const void> pin;
+
+  // The output for the record.
+  std::string output;
+};
+
+// Every queue carries records in order followed by std::nullopt, which marks
+// the end of the records.
+using RecordQueue = BoundedQueue<std::optional<Record>>;
+
+// Decodes and computes `record`, and drops its pin.
+void ProcessRecord(const DecodeRecordFunc& decode,
+                   const ComputeRecordFunc& compute, Record& record) {
+  absl::StatusOr<Bytes> input = decode(record.text);
+  record.text = {};
+  record.pin.reset();
+  if (!input.ok()) {
+    record.status = std::move(input).status();
+    return;
+  }
+  record.status = compute(*input, &record.output);
+}
+
+// Lowers `first_error` to `index` unless it is already lower.
+void LowerFirstError(std::atomic<size_t>& first_error, size_t index) {
+  size_t current = first_error.load(std::memory_order_relaxed);
+  while (index < current && !first_error.compare_exchange_weak(
+                                current, index, std::memory_order_relaxed)) {
+  }
+}
+
+}  // namespace
+
+absl::StatusOr<Bytes> DecodeRawRecord(std::string_view record) {
+  return Bytes::CreateFromRaw(record);
+}
+
+DecodeRecordFunc DecodeRecordFromFormat(cryptopals::BytesEncodedFormat format) {
+  return [format](std::string_view record) {
+    return Bytes::DecodeFromFormat(record, format);
+  };
+}
+
+absl::Status RunRecordPipeline(RecordReader& records,
+                               const DecodeRecordFunc& decode,
+                               const ComputeRecordFunc& compute,
+                               std::ostream& output,
+                               const RecordPipelineOptions& options) {
+  ThreadPool& pool =
+      options.pool != nullptr ? *options.pool : ThreadPool::Default();
+  const size_t max_batch_records = std::max<size_t>(options.queue_capacity, 1);
+  RecordQueue read_queue(options.queue_capacity);
+  RecordQueue computed_queue(options.queue_capacity);
+
+  // Set once a record fails, after which the reader stops.
+  std::atomic<bool> failed = false;
+
+  std::thread reader([&] {
+    while (!failed.load(std::memory_order_relaxed)) {
+      Record record;
+      absl::StatusOr<std::optional<std::string_view>> text = records.Next();
+      if (!text.ok()) {
+        record.status = std::move(text).status();
+      } else if (!text->has_value()) {
+        break;
+      } else {
+        // The reader moves on without waiting for the record to be decoded,
+        // so the record pins the batch it is in rather than being copied out
+        // of it.
+        record.text = **text;
+        record.pin = records.Pin();
+      }
+      const bool read_failed = !record.status.ok();
+      read_queue.Push(std::move(record));
+      if (read_failed) {
+        break;
+      }
+    }
+    read_queue.Push(std::nullopt);
+  });
+
+  absl::Status status;
+  std::thread writer([&] {
+    std::string batch;
+    while (true) {
+      std::optional<std::optional<Record>> ready = computed_queue.TryPop();
+      if (!ready.has_value()) {
+        // Nothing more is ready, so what is written so far is shown now
+        // rather than when the batch fills.
+        output.write(batch.data(), batch.size());
+        output.flush();
+        batch.clear();
+        ready = computed_queue.Pop();
+      }
+      if (!ready->has_value()) {
+        break;
+      }
+      Record& record = **ready;
+      if (!record.status.ok()) {
+        // The record is the last one passed on.
+        status = std::move(record.status);
+        continue;
+      }
+      batch += record.output;
+      if (batch.size() >= options.output_batch_bytes) {
+        output.write(batch.data(), batch.size());
+        batch.clear();
+      }
+    }
+    output.write(batch.data(), batch.size());
+    output.flush();
+  });
+
+  std::vector<Record> batch;
+  bool read_ended = false;
+  while (!read_ended && !failed.load(std::memory_order_relaxed)) {
+    // Takes the records that are ready, waiting for the first one only.
+    batch.clear();
+    std::optional<Record> next = read_queue.Pop();
+    while (true) {
+      if (!next.has_value()) {
+        read_ended = true;
+        break;
+      }
+      batch.push_back(*std::move(next));
+      if (batch.size() == max_batch_records) {
+        break;
+      }
+      std::optional<std::optional<Record>> ready = read_queue.TryPop();
+      if (!ready.has_value()) {
+        break;
+      }
+      next = *std::move(ready);
+    }
+
+    // Records after the first error in the batch are not worth computing, but
+    // those before it are still written.
+    std::atomic<size_t> first_error = batch.size();
+    ParallelFor(
+        batch.size(), 1,
+        [&](size_t begin, size_t end) {
+          for (size_t i = begin; i < end; ++i) {
+            if (i > first_error.load(std::memory_order_relaxed)) {
+              return;
+            }
+            Record& record = batch[i];
+            if (record.status.ok()) {
+              ProcessRecord(decode, compute, record);
+            }
+            if (!record.status.ok()) {
+              LowerFirstError(first_error, i);
+            }
+          }
+        },
+        pool);
+
+    const size_t num_written =
+        std::min(batch.size(), first_error.load(std::memory_order_relaxed) + 1);
+    for (size_t i = 0; i < num_written; ++i) {
+      computed_queue.Push(std::move(batch[i]));
+    }
+    if (first_error.load(std::memory_order_relaxed) < batch.size()) {
+      failed.store(true, std::memory_order_relaxed);
+    }
+  }
+  computed_queue.Push(std::nullopt);
+
+  // The reader may be waiting for room after an error.
+  while (!read_ended) {
+    read_ended = !read_queue.Pop().has_value();
+  }
+  reader.join();
+  writer.join();
+  return status;
+}
+
+}  // namespace cryptopals::util
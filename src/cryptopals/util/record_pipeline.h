@@ -0,0 +1,70 @@
+#ifndef CRYPTOPALS_UTIL_RECORD_PIPELINE_H_
+#define CRYPTOPALS_UTIL_RECORD_PIPELINE_H_
+
+#include <cstddef>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "cryptopals/proto/cryptopals_enums.pb.h"
+#include "cryptopals/util/bytes.h"
+#include "cryptopals/util/record_reader.h"
+#include "cryptopals/util/thread_pool.h"
+
+namespace cryptopals::util {
+
+struct RecordPipelineOptions {
+  // The pool that decodes and computes the records along with the calling
+  // thread, or ThreadPool::Default() if null.
+  ThreadPool* pool = nullptr;
+
+  // The number of records that each queue between two stages holds, and the
+  // most records computed in one batch.
+  size_t queue_capacity = 256;
+
+  // Output is written once this many bytes are ready, or sooner if the writer
+  // would otherwise wait for the next record.
+  size_t output_batch_bytes = 1 << 16;
+};
+
+// Decodes a record into the input of the compute stage.
+using DecodeRecordFunc =
+    std::function<absl::StatusOr<Bytes>(std::string_view record)>;
+
+// Appends the output for the decoded `input` of one record to `output`,
+// including any trailing newline.
+using ComputeRecordFunc =
+    std::function<absl::Status(const Bytes& input, std::string* output)>;
+
+// Keeps `record` as raw bytes, such as a plaintext to encrypt.
+absl::StatusOr<Bytes> DecodeRawRecord(std::string_view record);
+
+// Returns a DecodeRecordFunc that decodes records from `format`.
+DecodeRecordFunc DecodeRecordFromFormat(cryptopals::BytesEncodedFormat format);
+
+// Runs every record of `records` through a pipeline of stages connected by
+// BoundedQueues:
+// - a reader, on a thread of its own, that pins each record of `records` in
+//   place with RecordReader::Pin();
+// - the calling thread, which takes the records that are ready in batches and
+//   calls `decode` and then `compute` on the records of each batch, in any
+//   order, with ParallelFor() on `options.pool`;
+// - a writer, on a thread of its own, that writes the outputs to `output` in
+//   the order of the records, in batches.
+// The reader and the writer mostly wait for I/O, so the records are worked on
+// by the threads of --threads alone. Reading, computing and writing overlap,
+// and the queues bound the number of records in flight. Returns the first
+// error in the order of the records, after writing the outputs of every record
+// before it; no records after it are written.
+absl::Status RunRecordPipeline(RecordReader& records,
+                               const DecodeRecordFunc& decode,
+                               const ComputeRecordFunc& compute,
+                               std::ostream& output,
+                               const RecordPipelineOptions& options = {});
+
+}  // namespace cryptopals::util
+
+#endif  // CRYPTOPALS_UTIL_RECORD_PIPELINE_H_
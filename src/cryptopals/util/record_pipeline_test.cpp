@@ -0,0 +1,114 @@
+#include "cryptopals/util/record_pipeline.h"
+
+#include <chrono>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "cryptopals/util/thread_pool.h"
+#include "googletest/status_matchers.h"
+#include "gtest/gtest.h"
+
+namespace cryptopals::util {
+namespace {
+
+constexpr size_t NUM_RECORDS = 500;
+
+std::vector<std::string> TestRecords() {
+  std::vector<std::string> records;
+  for (size_t i = 0; i < NUM_RECORDS; ++i) {
+    records.push_back(absl::StrCat(i * 7919 % 1000));
+  }
+  return records;
+}
+
+std::vector<char*> Args(std::vector<std::string>& records) {
+  std::vector<char*> args;
+  for (std::string& record : records) {
+    args.push_back(record.data());
+  }
+  return args;
+}
+
+// Reverses the input, taking longer for some records so that they finish out
+// of order.
+absl::Status ReverseSlowly(const Bytes& input, std::string* output) {
+  std::string text = input.ToRaw();
+  if (text.back() == '3') {
+    std::this_thread::sleep_for(std::chrono::microseconds(200));
+  }
+  absl::StrAppend(output, std::string(text.rbegin(), text.rend()), "\n");
+  return absl::OkStatus();
+}
+
+TEST(RecordPipelineTest, WritesOutputsInOrder) {
+  std::vector<std::string> records = TestRecords();
+  std::vector<char*> args = Args(records);
+  std::string expected;
+  for (const std::string& record : records) {
+    absl::StrAppend(&expected, std::string(record.rbegin(), record.rend()),
+                    "\n");
+  }
+
+  for (size_t num_threads : {0, 3}) {
+    ThreadPool pool(num_threads);
+    ASSERT_OK_AND_ASSIGN(
+        RecordReader reader,
+        RecordReader::Create(args, cryptopals::InputMethod::STDIN));
+    std::ostringstream output;
+    ASSERT_OK(RunRecordPipeline(reader, DecodeRawRecord, ReverseSlowly, output,
+                                {.pool = &pool,
+                                 .queue_capacity = 4,
+                                 .output_batch_bytes = 100}));
+    EXPECT_EQ(output.str(), expected) << num_threads;
+  }
+}
+
+TEST(RecordPipelineTest, StopsAtFirstError) {
+  std::vector<std::string> records = TestRecords();
+  records[300] = "decode error";
+  records[200] = "compute error";
+  records[100] = "";
+  std::vector<char*> args = Args(records);
+  ASSERT_OK_AND_ASSIGN(
+      RecordReader reader,
+      RecordReader::Create(args, cryptopals::InputMethod::STDIN));
+
+  ThreadPool pool(3);
+  std::ostringstream output;
+  absl::Status status = RunRecordPipeline(
+      reader,
+      [](std::string_view record) -> absl::StatusOr<Bytes> {
+        if (record == "decode error") {
+          return absl::InvalidArgumentError("decode error");
+        }
+        return Bytes::CreateFromRaw(record);
+      },
+      [](const Bytes& input, std::string* output) {
+        std::string text = input.ToRaw();
+        if (text == "compute error") {
+          return absl::InternalError(text);
+        }
+        // Records may have no output.
+        if (!text.empty()) {
+          absl::StrAppend(output, text, "\n");
+        }
+        return absl::OkStatus();
+      },
+      output, {.pool = &pool, .queue_capacity = 8});
+
+  EXPECT_EQ(status, absl::InternalError("compute error"));
+  std::string expected;
+  for (size_t i = 0; i < 200; ++i) {
+    if (i != 100) {
+      absl::StrAppend(&expected, records[i], "\n");
+    }
+  }
+  EXPECT_EQ(output.str(), expected);
+}
+
+}  // namespace
+}  // namespace cryptopals::util
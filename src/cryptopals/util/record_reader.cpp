@@ -0,0 +1,265 @@
+#include "cryptopals/util/record_reader.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <utility>
+
+#include "absl/status/status_macros.h"
+#include "absl/strings/str_cat.h"
+#include "cryptopals/util/string_utils.h"
+
+namespace cryptopals::util {
+namespace {
+
+// The file name that stands for standard input.
+constexpr std::string_view STDIN_FILE_NAME = "-";
+
+// Returns the error status for the failure of `operation` on `path`, as
+// reported by errno.
+absl::Status FileError(const char* operation, const char* path) {
+  const int error_number = errno;
+  return absl::Status(absl::ErrnoToStatusCode(error_number),
+                      absl::StrCat("Failed to ", operation, " ", path, ": ",
+                                   std::strerror(error_number)));
+}
+
+}  // namespace
+
+absl::StatusOr<RecordReader> RecordReader::Create(
+    std::span<char* const> args, cryptopals::InputMethod method,
+    size_t buffer_bytes) {
+  switch (method) {
+    case cryptopals::InputMethod::STDIN:
+    case cryptopals::InputMethod::CIPHERTEXT_FILE:
+    case cryptopals::InputMethod::MULTI_CIPHERTEXT_FILE:
+      break;
+    default:
+      return absl::InvalidArgumentErrorBuilder()
+             << "Unsupported input method: " << InputMethod_Name(method);
+  }
+  return RecordReader(args, method, std::max<size_t>(buffer_bytes, 1));
+}
+
+RecordReader::RecordReader(RecordReader&& other)
+    : args_(other.args_),
+      method_(other.method_),
+      buffer_bytes_(other.buffer_bytes_),
+      next_arg_(other.next_arg_),
+      batch_(std::move(other.batch_)),
+      next_record_(other.next_record_),
+      mapped_file_(std::move(other.mapped_file_)),
+      mapped_offset_(other.mapped_offset_),
+      fd_(std::exchange(other.fd_, -1)),
+      end_of_file_(other.end_of_file_),
+      buffer_(std::move(other.buffer_)),
+      buffer_begin_(other.buffer_begin_),
+      buffer_end_(other.buffer_end_) {}
+
+RecordReader::~RecordReader() { CloseFile(); }
+
+absl::StatusOr<std::optional<std::string_view>> RecordReader::Next() {
+  if (next_record_ == batch_.size()) {
+    RETURN_IF_ERROR(FillBatch());
+    if (batch_.empty()) {
+      return std::nullopt;
+    }
+  }
+  return batch_[next_record_++];
+}
+
+std::shared_ptr<const void> RecordReader::Pin() const {
+  if (mapped_file_ != nullptr) {
+    return mapped_file_;
+  }
+  // Records of the STDIN method are the arguments, which need no pinning.
+  return buffer_;
+}
+
+absl::StatusOr<std::vector<std::string_view>> RecordReader::NextBatch() {
+  if (next_record_ == batch_.size()) {
+    RETURN_IF_ERROR(FillBatch());
+  }
+  std::vector<std::string_view> records(batch_.begin() + next_record_,
+                                        batch_.end());
+  next_record_ = batch_.size();
+  return records;
+}
+
+absl::Status RecordReader::FillBatch() {
+  batch_.clear();
+  next_record_ = 0;
+
+  switch (method_) {
+    case cryptopals::InputMethod::STDIN: {
+      for (; next_arg_ < args_.size(); ++next_arg_) {
+        batch_.emplace_back(args_[next_arg_]);
+      }
+      return absl::OkStatus();
+    }
+    case cryptopals::InputMethod::CIPHERTEXT_FILE: {
+      // Each file is a single record, so only one is held at a time.
+      mapped_file_.reset();
+      if (next_arg_ < args_.size()) {
+        const char* path = args_[next_arg_++];
+        ASSIGN_OR_RETURN(MappedFile mapped_file,
+                         MappedFile::Create(path == STDIN_FILE_NAME
+                                                ? "/dev/stdin"
+                                                : path));
+        mapped_file_ = std::make_shared<MappedFile>(std::move(mapped_file));
+        // Line breaks are kept; Bytes::DecodeFromFormat() skips them.
+        batch_.push_back(mapped_file_->contents());
+      }
+      return absl::OkStatus();
+    }
+    default: {
+      while (true) {
+        if (mapped_file_ != nullptr) {
+          if (FillBatchFromMapping()) {
+            return absl::OkStatus();
+          }
+          CloseFile();
+        } else if (fd_ >= 0) {
+          ASSIGN_OR_RETURN(bool filled, FillBatchFromLines());
+          if (filled) {
+            return absl::OkStatus();
+          }
+          CloseFile();
+        }
+        if (next_arg_ == args_.size()) {
+          return absl::OkStatus();
+        }
+        RETURN_IF_ERROR(OpenNextFile());
+      }
+    }
+  }
+}
+
+bool RecordReader::FillBatchFromMapping() {
+  // The records of the previous window are no longer valid, so its pages can
+  // be dropped.
+  mapped_file_->ReleaseBefore(mapped_offset_);
+
+  const std::string_view contents = mapped_file_->contents();
+  if (mapped_offset_ == contents.size()) {
+    return false;
+  }
+  size_t end = std::min(mapped_offset_ + buffer_bytes_, contents.size());
+  if (end < contents.size()) {
+    // Extends the window to the end of the line that it stops in.
+    const size_t newline = contents.find('\n', end - 1);
+    end = newline == std::string_view::npos ? contents.size() : newline + 1;
+  }
+  batch_ = SplitLines(contents.substr(mapped_offset_, end - mapped_offset_));
+  mapped_offset_ = end;
+  return true;
+}
+
+absl::StatusOr<bool> RecordReader::FillBatchFromLines() {
+  while (true) {
+    const std::string_view unread(buffer_->data() + buffer_begin_,
+                                  buffer_end_ - buffer_begin_);
+    const size_t last_newline = unread.rfind('\n');
+    if (last_newline != std::string_view::npos) {
+      batch_ = SplitLines(unread.substr(0, last_newline + 1));
+      buffer_begin_ += last_newline + 1;
+      return true;
+    }
+    if (end_of_file_) {
+      if (unread.empty()) {
+        return false;
+      }
+      // The last line of a file does not need to end with a newline.
+      batch_.push_back(unread);
+      buffer_begin_ = buffer_end_;
+      return true;
+    }
+
+    // Moves the start of the next line to the front of the buffer to make
+    // room for the rest of it, and only grows the buffer when that line does
+    // not fit. Records pinned in the buffer keep it, and the line moves to a
+    // new buffer instead.
+    const size_t buffer_size = unread.size() == buffer_->size()
+                                   ? 2 * buffer_->size()
+                                   : buffer_->size();
+    if (buffer_.use_count() == 1) {
+      std::memmove(buffer_->data(), unread.data(), unread.size());
+      buffer_->resize(buffer_size);
+    } else {
+      auto buffer = std::make_shared<std::vector<char>>(buffer_size);
+      std::memcpy(buffer->data(), unread.data(), unread.size());
+      buffer_ = std::move(buffer);
+    }
+    buffer_begin_ = 0;
+    buffer_end_ = unread.size();
+
+    const ssize_t bytes_read = read(fd_, buffer_->data() + buffer_end_,
+                                    buffer_->size() - buffer_end_);
+    if (bytes_read < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return FileError("read", args_[next_arg_ - 1]);
+    }
+    if (bytes_read == 0) {
+      end_of_file_ = true;
+    }
+    buffer_end_ += static_cast<size_t>(bytes_read);
+  }
+}
+
+absl::Status RecordReader::OpenNextFile() {
+  CloseFile();
+  const char* path = args_[next_arg_++];
+  if (path == STDIN_FILE_NAME) {
+    fd_ = STDIN_FILENO;
+  } else {
+    struct stat file_stat;
+    if (stat(path, &file_stat) != 0) {
+      return FileError("stat", path);
+    }
+    if (S_ISREG(file_stat.st_mode)) {
+      ASSIGN_OR_RETURN(MappedFile mapped_file, MappedFile::Create(path));
+      mapped_file_ = std::make_shared<MappedFile>(std::move(mapped_file));
+      mapped_offset_ = 0;
+      return absl::OkStatus();
+    }
+    fd_ = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd_ < 0) {
+      return FileError("open", path);
+    }
+  }
+  // The buffer is only needed for files that are not mapped.
+  if (buffer_.use_count() != 1 || buffer_->size() < buffer_bytes_) {
+    buffer_ = std::make_shared<std::vector<char>>(buffer_bytes_);
+  }
+  end_of_file_ = false;
+  buffer_begin_ = 0;
+  buffer_end_ = 0;
+  return absl::OkStatus();
+}
+
+void RecordReader::CloseFile() {
+  mapped_file_.reset();
+  if (fd_ >= 0 && fd_ != STDIN_FILENO) {
+    close(fd_);
+  }
+  fd_ = -1;
+}
+
+absl::Status ForEachRecord(
+    RecordReader& reader, absl::FunctionRef<absl::Status(std::string_view)> f) {
+  while (true) {
+    ASSIGN_OR_RETURN(std::optional<std::string_view> record, reader.Next());
+    if (!record.has_value()) {
+      return absl::OkStatus();
+    }
+    RETURN_IF_ERROR(f(*record));
+  }
+}
+
+}  // namespace cryptopals::util
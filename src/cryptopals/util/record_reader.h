@@ -0,0 +1,121 @@
+#ifndef CRYPTOPALS_UTIL_RECORD_READER_H_
+#define CRYPTOPALS_UTIL_RECORD_READER_H_
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "absl/functional/function_ref.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "cryptopals/proto/cryptopals_enums.pb.h"
+#include "cryptopals/util/mapped_file.h"
+
+namespace cryptopals::util {
+
+// Reads the inputs of a tool one record at a time, as the tool asks for them.
+// The records depend on the input method: each command line argument for
+// STDIN, each named file for CIPHERTEXT_FILE, and each line of the named
+// files for MULTI_CIPHERTEXT_FILE. A file named "-" is standard input.
+//
+// The lines of a regular file are views into a mapping of the file, returned a
+// window of `buffer_bytes` at a time. The pages of the windows already returned
+// are released as the reader moves on, so memory use does not grow with the
+// size of the input. The lines of pipes and of standard input are read through
+// a buffer of bounded size that is refilled as records are consumed, so that
+// records are returned as soon as they arrive. Both the window and the buffer
+// only grow to hold a single line longer than them.
+class RecordReader {
+ public:
+  // The default size of the read-ahead buffer for lines.
+  static constexpr size_t DEFAULT_BUFFER_BYTES = 1 << 20;
+
+  // Creates a reader of the records given by `args` with `method`. The reader
+  // refers to `args`, which must outlive it. Files are opened as they are
+  // reached. Returns an error status if the method is not supported.
+  static absl::StatusOr<RecordReader> Create(
+      std::span<char* const> args, cryptopals::InputMethod method,
+      size_t buffer_bytes = DEFAULT_BUFFER_BYTES);
+
+  RecordReader(RecordReader&& other);
+  RecordReader& operator=(RecordReader&& other) = delete;
+  ~RecordReader();
+
+  // Returns the next record, or std::nullopt after the last one. The record
+  // stays valid until the next call to Next() or NextBatch(), unless it is
+  // pinned with Pin().
+  absl::StatusOr<std::optional<std::string_view>> Next();
+
+  // Returns the records that can be read without waiting for more input, or
+  // waits for at least one if none can. Returns no records after the last one.
+  // The records stay valid until the next call to Next() or NextBatch(),
+  // unless they are pinned with Pin().
+  absl::StatusOr<std::vector<std::string_view>> NextBatch();
+
+  // Returns a handle that keeps the records returned so far valid for as long
+  // as it is held, so that they can be used after the reader moves on without
+  // being copied. The handle holds the buffer or the mapping of the file that
+  // the records are in, which the reader then leaves alone.
+  std::shared_ptr<const void> Pin() const;
+
+ private:
+  RecordReader(std::span<char* const> args, cryptopals::InputMethod method,
+               size_t buffer_bytes)
+      : args_(args), method_(method), buffer_bytes_(buffer_bytes) {}
+
+  // Fills `batch_` with the next records, leaving it empty after the last one.
+  absl::Status FillBatch();
+
+  // Fills `batch_` with the lines of the next window of the mapped file, and
+  // releases the windows before it. Returns false once the file is exhausted.
+  bool FillBatchFromMapping();
+
+  // Fills `batch_` with the complete lines of the current file in the buffer,
+  // reading more of the file if there are none. Returns false without reading
+  // anything once the current file is exhausted.
+  absl::StatusOr<bool> FillBatchFromLines();
+
+  // Opens the next file for reading lines, closing the current one. Regular
+  // files are mapped, and other files are read through the buffer.
+  absl::Status OpenNextFile();
+
+  // Closes the current file, unless it is standard input.
+  void CloseFile();
+
+  std::span<char* const> args_;
+  cryptopals::InputMethod method_;
+  size_t buffer_bytes_;
+  size_t next_arg_ = 0;
+
+  // The records returned by the last NextBatch(), and the position of the next
+  // one returned by Next().
+  std::vector<std::string_view> batch_;
+  size_t next_record_ = 0;
+
+  // The file holding the current CIPHERTEXT_FILE record, or the regular file
+  // that lines are read from, and the offset of the next window of lines.
+  std::shared_ptr<MappedFile> mapped_file_;
+  size_t mapped_offset_ = 0;
+
+  // The file that lines are read from otherwise, or -1 if there is none, and
+  // the bytes in [buffer_begin_, buffer_end_) of `buffer_` that have been read
+  // from it but not yet returned. A new buffer replaces one that is pinned.
+  int fd_ = -1;
+  bool end_of_file_ = false;
+  std::shared_ptr<std::vector<char>> buffer_;
+  size_t buffer_begin_ = 0;
+  size_t buffer_end_ = 0;
+};
+
+// Calls `f` with every record of `reader` in order, and returns the first
+// error from `f` or from reading.
+absl::Status ForEachRecord(RecordReader& reader,
+                           absl::FunctionRef<absl::Status(std::string_view)> f);
+
+}  // namespace cryptopals::util
+
+#endif  // CRYPTOPALS_UTIL_RECORD_READER_H_
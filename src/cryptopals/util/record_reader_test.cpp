@@ -0,0 +1,218 @@
+#include "cryptopals/util/record_reader.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "googletest/status_matchers.h"
+#include "gtest/gtest.h"
+
+namespace cryptopals::util {
+namespace {
+
+std::string WriteTestFile(const std::string& name,
+                          const std::string& contents) {
+  std::string path = ::testing::TempDir() + name;
+  std::ofstream(path, std::ios::binary) << contents;
+  return path;
+}
+
+// Returns every record of `reader`, copied.
+std::vector<std::string> ReadAll(RecordReader& reader) {
+  std::vector<std::string> records;
+  absl::Status status = ForEachRecord(reader, [&](std::string_view record) {
+    records.emplace_back(record);
+    return absl::OkStatus();
+  });
+  EXPECT_TRUE(status.ok()) << status;
+  return records;
+}
+
+TEST(RecordReaderTest, ReadsLinesThroughSmallWindow) {
+  std::string contents;
+  std::vector<std::string> lines;
+  for (size_t i = 0; i < 200; ++i) {
+    // Some lines are longer than the window, which has to grow for them.
+    lines.push_back(std::string(i % 37, static_cast<char>('a' + i % 26)));
+    contents += lines.back() + "\n";
+  }
+  std::string path = WriteTestFile("record_reader_test_lines", contents);
+  std::vector<char*> args = {path.data(), path.data()};
+
+  ASSERT_OK_AND_ASSIGN(
+      RecordReader reader,
+      RecordReader::Create(args, cryptopals::InputMethod::MULTI_CIPHERTEXT_FILE,
+                           /*buffer_bytes=*/16));
+  std::vector<std::string> expected = lines;
+  expected.insert(expected.end(), lines.begin(), lines.end());
+  EXPECT_EQ(ReadAll(reader), expected);
+  std::remove(path.c_str());
+}
+
+TEST(RecordReaderTest, ReadsPipedLinesThroughSmallBuffer) {
+  std::string contents;
+  std::vector<std::string> lines;
+  for (size_t i = 0; i < 200; ++i) {
+    // Some lines are longer than the buffer, which has to grow for them.
+    lines.push_back(std::string(i % 37, static_cast<char>('a' + i % 26)));
+    contents += lines.back() + "\n";
+  }
+  std::string path = ::testing::TempDir() + "record_reader_test_piped_lines";
+  std::remove(path.c_str());
+  ASSERT_EQ(mkfifo(path.c_str(), 0600), 0);
+  std::thread writer([&] {
+    std::ofstream(path, std::ios::binary) << contents;
+  });
+
+  std::vector<char*> args = {path.data()};
+  ASSERT_OK_AND_ASSIGN(
+      RecordReader reader,
+      RecordReader::Create(args, cryptopals::InputMethod::MULTI_CIPHERTEXT_FILE,
+                           /*buffer_bytes=*/16));
+  EXPECT_EQ(ReadAll(reader), lines);
+  writer.join();
+  std::remove(path.c_str());
+}
+
+TEST(RecordReaderTest, PinnedRecordsOutliveTheirBatch) {
+  std::string contents;
+  std::vector<std::string> lines;
+  for (size_t i = 0; i < 200; ++i) {
+    lines.push_back(std::string(i % 37, static_cast<char>('a' + i % 26)));
+    contents += lines.back() + "\n";
+  }
+  std::string path = WriteTestFile("record_reader_test_pinned", contents);
+  std::string fifo_path =
+      ::testing::TempDir() + "record_reader_test_pinned_piped";
+  std::remove(fifo_path.c_str());
+  ASSERT_EQ(mkfifo(fifo_path.c_str(), 0600), 0);
+  std::thread writer([&] {
+    std::ofstream(fifo_path, std::ios::binary) << contents;
+  });
+
+  // The mapped file is read in windows and the pipe through a buffer, both
+  // small enough that every record outlives several batches.
+  std::vector<char*> args = {path.data(), fifo_path.data()};
+  ASSERT_OK_AND_ASSIGN(
+      RecordReader reader,
+      RecordReader::Create(args, cryptopals::InputMethod::MULTI_CIPHERTEXT_FILE,
+                           /*buffer_bytes=*/16));
+  std::vector<std::string_view> records;
+  std::vector<std::shared_ptr<const void>> pins;
+  while (true) {
+    ASSERT_OK_AND_ASSIGN(std::optional<std::string_view> record,
+                         reader.Next());
+    if (!record.has_value()) {
+      break;
+    }
+    records.push_back(*record);
+    pins.push_back(reader.Pin());
+  }
+  writer.join();
+
+  std::vector<std::string> expected = lines;
+  expected.insert(expected.end(), lines.begin(), lines.end());
+  EXPECT_EQ(std::vector<std::string>(records.begin(), records.end()),
+            expected);
+  std::remove(path.c_str());
+  std::remove(fifo_path.c_str());
+}
+
+TEST(RecordReaderTest, FollowsGetlineSemantics) {
+  std::string path = WriteTestFile("record_reader_test_getline", "a\r\n\n\nb");
+  std::vector<char*> args = {path.data()};
+  ASSERT_OK_AND_ASSIGN(
+      RecordReader reader,
+      RecordReader::Create(args,
+                           cryptopals::InputMethod::MULTI_CIPHERTEXT_FILE));
+  EXPECT_EQ(ReadAll(reader), std::vector<std::string>({"a\r", "", "", "b"}));
+
+  std::string empty_path =
+      WriteTestFile("record_reader_test_getline_empty", "");
+  std::vector<char*> empty_args = {empty_path.data()};
+  ASSERT_OK_AND_ASSIGN(
+      RecordReader empty_reader,
+      RecordReader::Create(empty_args,
+                           cryptopals::InputMethod::MULTI_CIPHERTEXT_FILE));
+  EXPECT_TRUE(ReadAll(empty_reader).empty());
+  std::remove(path.c_str());
+  std::remove(empty_path.c_str());
+}
+
+TEST(RecordReaderTest, ReadsWholeFilesAndArguments) {
+  std::string path =
+      WriteTestFile("record_reader_test_whole", "line 1\nline 2\n");
+  std::vector<char*> args = {path.data(), path.data()};
+  ASSERT_OK_AND_ASSIGN(
+      RecordReader reader,
+      RecordReader::Create(args, cryptopals::InputMethod::CIPHERTEXT_FILE));
+  EXPECT_EQ(ReadAll(reader), std::vector<std::string>(2, "line 1\nline 2\n"));
+
+  ASSERT_OK_AND_ASSIGN(
+      RecordReader argument_reader,
+      RecordReader::Create(args, cryptopals::InputMethod::STDIN));
+  EXPECT_EQ(ReadAll(argument_reader), std::vector<std::string>(2, path));
+  std::remove(path.c_str());
+}
+
+TEST(RecordReaderTest, ReportsMissingFile) {
+  std::string path = ::testing::TempDir() + "record_reader_test_missing";
+  std::vector<char*> args = {path.data()};
+  for (cryptopals::InputMethod method :
+       {cryptopals::InputMethod::CIPHERTEXT_FILE,
+        cryptopals::InputMethod::MULTI_CIPHERTEXT_FILE}) {
+    ASSERT_OK_AND_ASSIGN(RecordReader reader,
+                         RecordReader::Create(args, method));
+    EXPECT_EQ(reader.Next().status().code(), absl::StatusCode::kNotFound);
+  }
+}
+
+TEST(RecordReaderTest, ReturnsLinesAsTheyArrive) {
+  std::string path = ::testing::TempDir() + "record_reader_test_fifo";
+  std::remove(path.c_str());
+  ASSERT_EQ(mkfifo(path.c_str(), 0600), 0);
+
+  // The writer waits for the first line to be read before writing the second,
+  // so reading would never finish if the reader waited for the end of input.
+  int line_read[2];
+  ASSERT_EQ(pipe(line_read), 0);
+  std::thread writer([&] {
+    int fd = open(path.c_str(), O_WRONLY);
+    ASSERT_GE(fd, 0);
+    ASSERT_EQ(write(fd, "first\nsec", 9), 9);
+    char signal;
+    ASSERT_EQ(read(line_read[0], &signal, 1), 1);
+    ASSERT_EQ(write(fd, "ond\n", 4), 4);
+    close(fd);
+  });
+
+  std::vector<char*> args = {path.data()};
+  ASSERT_OK_AND_ASSIGN(
+      RecordReader reader,
+      RecordReader::Create(args,
+                           cryptopals::InputMethod::MULTI_CIPHERTEXT_FILE));
+  ASSERT_OK_AND_ASSIGN(std::optional<std::string_view> record, reader.Next());
+  EXPECT_EQ(record, "first");
+  ASSERT_EQ(write(line_read[1], "x", 1), 1);
+  ASSERT_OK_AND_ASSIGN(record, reader.Next());
+  EXPECT_EQ(record, "second");
+  ASSERT_OK_AND_ASSIGN(record, reader.Next());
+  EXPECT_EQ(record, std::nullopt);
+
+  writer.join();
+  close(line_read[0]);
+  close(line_read[1]);
+  std::remove(path.c_str());
+}
+
+}  // namespace
+}  // namespace cryptopals::util
@@ -1,13 +1,89 @@
 #include "cryptopals/util/string_utils.h"
 
 #include <algorithm>
+#include <bit>
 #include <cctype>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+#include "cryptopals/util/cpu_features.h"
 
 namespace cryptopals::util {
+namespace {
+
+// Adds the lines of `text` that end in the first `size` bytes to `lines`,
+// given that the current line starts at `line_begin`, and returns the number
+// of bytes scanned. The caller scans the remaining tail.
+//
+// Compiled for processors with AVX2 regardless of the flags used for the rest
+// of the build, and only reached after HasAvx2() has been checked. A vector
+// of bytes is compared with '\n' at once, and the newlines in it are visited
+// through the bits of the comparison mask.
+#if defined(__x86_64__) || defined(__i386__)
+
+constexpr size_t AVX2_BYTES = 32;
+
+__attribute__((target("avx2"))) size_t SplitLinesAvx2(
+    std::string_view text, size_t& line_begin,
+    std::vector<std::string_view>& lines) {
+  const __m256i newlines = _mm256_set1_epi8('\n');
+  size_t i = 0;
+  for (; i + AVX2_BYTES <= text.size(); i += AVX2_BYTES) {
+    uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(
+        _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(
+                              text.data() + i)),
+                          newlines)));
+    while (mask != 0) {
+      const size_t newline = i + std::countr_zero(mask);
+      lines.push_back(text.substr(line_begin, newline - line_begin));
+      line_begin = newline + 1;
+      mask &= mask - 1;
+    }
+  }
+  return i;
+}
+
+#else
+
+size_t SplitLinesAvx2(std::string_view, size_t&,
+                      std::vector<std::string_view>&) {
+  return 0;
+}
+
+#endif
+
+}  // namespace
 
 void StrToUpper(std::string* str) {
   std::transform(str->begin(), str->end(), str->begin(),
                  [](unsigned char c) { return std::toupper(c); });
 }
 
+std::vector<std::string_view> SplitLines(std::string_view text) {
+  std::vector<std::string_view> lines;
+  size_t line_begin = 0;
+  size_t i = HasAvx2() ? SplitLinesAvx2(text, line_begin, lines) : 0;
+
+  // memchr() is vectorized by most C libraries, which makes it a good
+  // fallback, and it finishes the tail after the vector loop.
+  while (i < text.size()) {
+    const void* newline = std::memchr(text.data() + i, '\n', text.size() - i);
+    if (newline == nullptr) {
+      break;
+    }
+    i = static_cast<const char*>(newline) - text.data();
+    lines.push_back(text.substr(line_begin, i - line_begin));
+    line_begin = ++i;
+  }
+
+  if (line_begin < text.size()) {
+    lines.push_back(text.substr(line_begin));
+  }
+  return lines;
+}
+
 }  // namespace cryptopals::util
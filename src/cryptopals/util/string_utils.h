@@ -2,11 +2,19 @@
 #define CRYPTOPALS_UTIL_STRING_UTILS_H_
 
 #include <string>
+#include <string_view>
+#include <vector>
 
 namespace cryptopals::util {
 
 void StrToUpper(std::string* str);
 
+// Returns the lines of `text` as views into it, without their '\n'. As with
+// std::getline(), a final '\n' does not start another line, but empty lines
+// elsewhere are kept. Newlines are found with AVX2 when the processor supports
+// it.
+std::vector<std::string_view> SplitLines(std::string_view text);
+
 }  // namespace cryptopals::util
 
 #endif  // CRYPTOPALS_UTIL_STRING_UTILS_H_
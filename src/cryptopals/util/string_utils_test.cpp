@@ -0,0 +1,55 @@
+#include "cryptopals/util/string_utils.h"
+
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace cryptopals::util {
+namespace {
+
+std::vector<std::string_view> GetlineLines(const std::string& text,
+                                           std::vector<std::string>& storage) {
+  std::istringstream stream(text);
+  std::string line;
+  while (std::getline(stream, line)) {
+    storage.push_back(line);
+  }
+  return std::vector<std::string_view>(storage.begin(), storage.end());
+}
+
+TEST(StringUtilsTest, StrToUpper) {
+  std::string str = "hex_Format1";
+  StrToUpper(&str);
+  EXPECT_EQ(str, "HEX_FORMAT1");
+}
+
+TEST(StringUtilsTest, SplitLinesMatchesGetline) {
+  // Lines of every length up to a few vectors, so that newlines fall at every
+  // position in a vector, plus empty lines and inputs without a final newline.
+  std::string text;
+  for (size_t length = 0; length < 100; ++length) {
+    text.append(length, static_cast<char>('a' + length % 26));
+    text += '\n';
+  }
+  for (std::string input :
+       {std::string(), std::string("\n"), std::string("abc"),
+        std::string("\n\nabc\n\n"), text, text + "tail",
+        std::string(1000, 'x')}) {
+    std::vector<std::string> storage;
+    EXPECT_EQ(SplitLines(input), GetlineLines(input, storage)) << input;
+  }
+}
+
+TEST(StringUtilsTest, SplitLinesReturnsViewsIntoText) {
+  const std::string text = "first\nsecond\r\n";
+  std::vector<std::string_view> lines = SplitLines(text);
+  ASSERT_EQ(lines.size(), 2);
+  EXPECT_EQ(lines[0].data(), text.data());
+  EXPECT_EQ(lines[1], "second\r");
+}
+
+}  // namespace
+}  // namespace cryptopals::util
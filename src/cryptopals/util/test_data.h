@@ -0,0 +1,24 @@
+#ifndef CRYPTOPALS_UTIL_TEST_DATA_H_
+#define CRYPTOPALS_UTIL_TEST_DATA_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace cryptopals::util {
+
+// Returns `size` bytes for tests that compare a kernel against a simple
+// bytewise loop. Each run of 256 bytes holds every byte value once, so the data
+// has no period shorter than a full run. Buffers made with different `seed`s
+// differ at every position.
+inline std::vector<uint8_t> PatternedBytes(size_t size, uint8_t seed = 13) {
+  std::vector<uint8_t> bytes(size);
+  for (size_t i = 0; i < size; ++i) {
+    bytes[i] = static_cast<uint8_t>(i * 167 + seed);
+  }
+  return bytes;
+}
+
+}  // namespace cryptopals::util
+
+#endif  // CRYPTOPALS_UTIL_TEST_DATA_H_
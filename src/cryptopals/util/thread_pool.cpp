@@ -0,0 +1,188 @@
+#include "cryptopals/util/thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <utility>
+
+#include "absl/synchronization/blocking_counter.h"
+
+namespace cryptopals::util {
+namespace {
+
+// The number of ranges handed out per participating thread. A few ranges per
+// thread even out the load when some ranges finish faster than others.
+constexpr size_t TASKS_PER_THREAD = 4;
+
+// The pool and queue of the worker running on this thread, if any.
+thread_local const ThreadPool* current_pool = nullptr;
+thread_local size_t current_worker = 0;
+
+// The number of threads set with ThreadPool::SetDefaultNumThreads(), or 0 for
+// one per hardware thread.
+std::atomic<size_t> default_num_threads = 0;
+
+// Set once ThreadPool::Default() has created its pool.
+std::atomic<bool> default_pool_created = false;
+
+}  // namespace
+
+ThreadPool::ThreadPool(size_t num_threads) {
+  queues_.reserve(num_threads);
+  for (size_t i = 0; i < num_threads; ++i) {
+    queues_.push_back(std::make_unique<TaskQueue>());
+  }
+  workers_.reserve(num_threads);
+  for (size_t i = 0; i < num_threads; ++i) {
+    workers_.emplace_back(&ThreadPool::WorkerLoop, this, i);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    absl::MutexLock lock(&mutex_);
+    stopping_ = true;
+  }
+  for (std::thread& worker : workers_) {
+    worker.join();
+  }
+}
+
+ThreadPool& ThreadPool::Default() {
+  static ThreadPool* const pool = [] {
+    default_pool_created = true;
+    return new ThreadPool(DefaultNumThreads() - 1);
+  }();
+  return *pool;
+}
+
+absl::Status ThreadPool::SetDefaultNumThreads(size_t num_threads) {
+  const size_t previous_num_threads = DefaultNumThreads();
+  default_num_threads = num_threads;
+  if (default_pool_created && DefaultNumThreads() != previous_num_threads) {
+    default_num_threads = previous_num_threads;
+    return absl::FailedPreconditionError(
+        "The default thread pool has already been created");
+  }
+  return absl::OkStatus();
+}
+
+size_t ThreadPool::DefaultNumThreads() {
+  const size_t num_threads = default_num_threads;
+  if (num_threads != 0) {
+    return num_threads;
+  }
+  return std::max<size_t>(std::thread::hardware_concurrency(), 1);
+}
+
+void ThreadPool::Schedule(std::function<void()> task) {
+  if (queues_.empty()) {
+    // Without workers, nothing would ever run the task.
+    task();
+    return;
+  }
+  const size_t queue = current_pool == this
+                           ? current_worker
+                           : next_queue_++ % queues_.size();
+  {
+    absl::MutexLock lock(&queues_[queue]->mutex);
+    queues_[queue]->tasks.push_back(std::move(task));
+  }
+  absl::MutexLock lock(&mutex_);
+  ++num_pending_;
+}
+
+void ThreadPool::WorkerLoop(size_t worker) {
+  current_pool = this;
+  current_worker = worker;
+  while (true) {
+    {
+      absl::MutexLock lock(&mutex_);
+      mutex_.Await(absl::Condition(
+          +[](ThreadPool* pool) ABSL_EXCLUSIVE_LOCKS_REQUIRED(pool->mutex_) {
+            return pool->stopping_ || pool->num_pending_ != 0;
+          },
+          this));
+      if (num_pending_ == 0) {
+        return;
+      }
+      // Claims one of the queued tasks, which TakeTask() then finds.
+      --num_pending_;
+    }
+    TakeTask(worker)();
+  }
+}
+
+std::function<void()> ThreadPool::TakeTask(size_t worker) {
+  // A task is counted only after it is queued, so a claimed task is in some
+  // queue, although another worker may take it first and leave a different
+  // one to find on the next pass.
+  while (true) {
+    {
+      TaskQueue& own_queue = *queues_[worker];
+      absl::MutexLock lock(&own_queue.mutex);
+      if (!own_queue.tasks.empty()) {
+        std::function<void()> task = std::move(own_queue.tasks.back());
+        own_queue.tasks.pop_back();
+        return task;
+      }
+    }
+    for (size_t i = 1; i < queues_.size(); ++i) {
+      TaskQueue& victim = *queues_[(worker + i) % queues_.size()];
+      absl::MutexLock lock(&victim.mutex);
+      if (!victim.tasks.empty()) {
+        std::function<void()> task = std::move(victim.tasks.front());
+        victim.tasks.pop_front();
+        return task;
+      }
+    }
+  }
+}
+
+void ParallelFor(size_t num_items, size_t min_items_per_task,
+                 absl::FunctionRef<void(size_t begin, size_t end)> f,
+                 ThreadPool& pool) {
+  if (num_items == 0) {
+    return;
+  }
+
+  const size_t max_tasks = (pool.num_threads() + 1) * TASKS_PER_THREAD;
+  const size_t items_per_task = std::max(
+      {min_items_per_task, (num_items + max_tasks - 1) / max_tasks, size_t{1}});
+  const size_t num_tasks = (num_items + items_per_task - 1) / items_per_task;
+  if (num_tasks == 1 || pool.num_threads() == 0) {
+    f(0, num_items);
+    return;
+  }
+
+  // Ranges are claimed from a shared counter, so the calling thread can finish
+  // the whole loop by itself if the workers are busy, and the call only waits
+  // for ranges that were actually claimed. This keeps nested calls from
+  // waiting on a pool that is blocked on them. Helpers that start after the
+  // loop is done find nothing to claim, so they never touch `f` and only need
+  // the shared counters to stay alive.
+  struct SharedState {
+    explicit SharedState(size_t num_tasks) : tasks_done(num_tasks) {}
+
+    std::atomic<size_t> next_task = 0;
+    absl::BlockingCounter tasks_done;
+  };
+  auto state = std::make_shared<SharedState>(num_tasks);
+  auto run_tasks = [state, num_items, num_tasks, items_per_task, f]() {
+    for (size_t task = state->next_task++; task < num_tasks;
+         task = state->next_task++) {
+      const size_t begin = task * items_per_task;
+      f(begin, std::min(begin + items_per_task, num_items));
+      state->tasks_done.DecrementCount();
+    }
+  };
+
+  const size_t num_helpers = std::min(pool.num_threads(), num_tasks - 1);
+  for (size_t i = 0; i < num_helpers; ++i) {
+    pool.Schedule(run_tasks);
+  }
+  run_tasks();
+  state->tasks_done.Wait();
+}
+
+}  // namespace cryptopals::util
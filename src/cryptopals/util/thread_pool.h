@@ -0,0 +1,128 @@
+#ifndef CRYPTOPALS_UTIL_THREAD_POOL_H_
+#define CRYPTOPALS_UTIL_THREAD_POOL_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/functional/function_ref.h"
+#include "absl/status/status.h"
+#include "absl/synchronization/mutex.h"
+
+namespace cryptopals::util {
+
+// A fixed set of worker threads that share scheduled tasks by work stealing.
+// Each worker has its own queue. A task scheduled from a worker goes to that
+// worker's queue, which the worker runs newest first so that nested work stays
+// on the same thread and in its caches. Tasks scheduled from other threads are
+// spread over the queues in turn. A worker whose queue is empty steals the
+// oldest task from another queue, so the workers stay busy without contending
+// on a single lock.
+class ThreadPool {
+ public:
+  // Starts `num_threads` workers. A pool with no workers is valid; work handed
+  // to ParallelFor() then runs entirely on the calling thread.
+  explicit ThreadPool(size_t num_threads);
+
+  // Waits for every scheduled task to finish and joins the workers.
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  // Returns the process-wide pool, which has DefaultNumThreads() - 1 workers to
+  // leave one thread for the caller, which takes part in ParallelFor().
+  static ThreadPool& Default();
+
+  // Sets the number of threads used for parallel work across the process,
+  // counting the calling thread, or restores one per hardware thread if
+  // `num_threads` is 0. Returns FailedPrecondition if Default() has already
+  // created its pool with a different number of threads.
+  static absl::Status SetDefaultNumThreads(size_t num_threads);
+
+  // Returns the number of threads used for parallel work across the process,
+  // as set by SetDefaultNumThreads().
+  static size_t DefaultNumThreads();
+
+  // Queues `task` to run on one of the workers.
+  void Schedule(std::function<void()> task);
+
+  size_t num_threads() const { return workers_.size(); }
+
+ private:
+  // The tasks scheduled on one worker.
+  struct TaskQueue {
+    absl::Mutex mutex;
+    std::deque<std::function<void()>> tasks ABSL_GUARDED_BY(mutex);
+  };
+
+  void WorkerLoop(size_t worker);
+
+  // Takes a task that was counted in `num_pending_`, trying the queue of
+  // `worker` first and stealing from the others after it.
+  std::function<void()> TakeTask(size_t worker);
+
+  std::vector<std::unique_ptr<TaskQueue>> queues_;
+  std::atomic<size_t> next_queue_ = 0;
+
+  // Workers sleep while there are no tasks to take.
+  absl::Mutex mutex_;
+  size_t num_pending_ ABSL_GUARDED_BY(mutex_) = 0;
+  bool stopping_ ABSL_GUARDED_BY(mutex_) = false;
+
+  std::vector<std::thread> workers_;
+};
+
+// Calls `f(begin, end)` over consecutive ranges that cover [0, `num_items`),
+// each holding at least `min_items_per_task` items except possibly the last.
+// Ranges run concurrently on `pool` and on the calling thread, and the call
+// returns once every range has been processed.
+void ParallelFor(size_t num_items, size_t min_items_per_task,
+                 absl::FunctionRef<void(size_t begin, size_t end)> f,
+                 ThreadPool& pool = ThreadPool::Default());
+
+// Maps the ranges that ParallelFor() hands out to values with `map(begin,
+// end)`, concurrently, and folds them with `reduce`, starting from `identity`,
+// in the order of the ranges. The result depends only on the ranges, which
+// depend on the number of threads in `pool`, and not on the order in which the
+// ranges finish.
+template <typename T>
+T ParallelReduce(
+    size_t num_items, size_t min_items_per_task, T identity,
+    std::type_identity_t<absl::FunctionRef<T(size_t begin, size_t end)>> map,
+    std::type_identity_t<absl::FunctionRef<T(T accumulator, T value)>> reduce,
+    ThreadPool& pool = ThreadPool::Default()) {
+  absl::Mutex mutex;
+  std::vector<std::pair<size_t, T>> values;
+  ParallelFor(
+      num_items, min_items_per_task,
+      [&](size_t begin, size_t end) {
+        T value = map(begin, end);
+        absl::MutexLock lock(&mutex);
+        values.emplace_back(begin, std::move(value));
+      },
+      pool);
+
+  std::sort(values.begin(), values.end(),
+            [](const std::pair<size_t, T>& lhs,
+               const std::pair<size_t, T>& rhs) {
+              return lhs.first < rhs.first;
+            });
+  T result = std::move(identity);
+  for (std::pair<size_t, T>& value : values) {
+    result = reduce(std::move(result), std::move(value.second));
+  }
+  return result;
+}
+
+}  // namespace cryptopals::util
+
+#endif  // CRYPTOPALS_UTIL_THREAD_POOL_H_
@@ -0,0 +1,133 @@
+#include "cryptopals/util/thread_pool.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/synchronization/notification.h"
+#include "gtest/gtest.h"
+
+namespace cryptopals::util {
+
+TEST(ThreadPoolTest, ScheduleRunsEveryTask) {
+  std::atomic<int> count = 0;
+  {
+    ThreadPool pool(3);
+    for (int i = 0; i < 100; ++i) {
+      pool.Schedule([&count]() { ++count; });
+    }
+  }
+  EXPECT_EQ(count, 100);
+}
+
+TEST(ThreadPoolTest, ParallelForCoversEveryItemOnce) {
+  ThreadPool pool(3);
+  for (size_t num_items : {0, 1, 7, 1000, 4097}) {
+    std::vector<std::atomic<int>> visits(num_items);
+    ParallelFor(
+        num_items, 16,
+        [&visits](size_t begin, size_t end) {
+          for (size_t i = begin; i < end; ++i) {
+            ++visits[i];
+          }
+        },
+        pool);
+    for (size_t i = 0; i < num_items; ++i) {
+      EXPECT_EQ(visits[i], 1) << "item " << i << " of " << num_items;
+    }
+  }
+}
+
+TEST(ThreadPoolTest, ParallelForHonorsMinimumRangeSize) {
+  ThreadPool pool(3);
+  std::atomic<int> ranges = 0;
+  ParallelFor(
+      100, 40, [&ranges](size_t begin, size_t end) { ++ranges; }, pool);
+  EXPECT_EQ(ranges, 3);
+}
+
+TEST(ThreadPoolTest, NestedParallelForCompletes) {
+  ThreadPool pool(1);
+  std::atomic<int> count = 0;
+  ParallelFor(
+      8, 1,
+      [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+          ParallelFor(
+              8, 1,
+              [&count](size_t begin, size_t end) { count += end - begin; },
+              pool);
+        }
+      },
+      pool);
+  EXPECT_EQ(count, 64);
+}
+
+TEST(ThreadPoolTest, TasksScheduledByWorkersAreStolen) {
+  std::atomic<int> count = 0;
+  {
+    ThreadPool pool(4);
+    // Every task is scheduled on the queue of the first worker, which stays
+    // busy, so the other workers have to steal them.
+    absl::Notification all_scheduled;
+    pool.Schedule([&] {
+      for (int i = 0; i < 100; ++i) {
+        pool.Schedule([&count]() { ++count; });
+      }
+      all_scheduled.Notify();
+      while (count < 100) {
+        std::this_thread::yield();
+      }
+    });
+    all_scheduled.WaitForNotification();
+  }
+  EXPECT_EQ(count, 100);
+}
+
+TEST(ThreadPoolTest, ParallelReduceFoldsRangesInOrder) {
+  ThreadPool pool(3);
+  for (size_t num_items : {0, 1, 7, 1000}) {
+    // Concatenating ranges is not commutative, so the result shows whether
+    // the ranges are folded in order.
+    std::vector<size_t> items = ParallelReduce(
+        num_items, 10, std::vector<size_t>(),
+        [](size_t begin, size_t end) {
+          std::vector<size_t> range;
+          for (size_t i = begin; i < end; ++i) {
+            range.push_back(i);
+          }
+          return range;
+        },
+        [](std::vector<size_t> items, std::vector<size_t> range) {
+          items.insert(items.end(), range.begin(), range.end());
+          return items;
+        },
+        pool);
+    ASSERT_EQ(items.size(), num_items);
+    for (size_t i = 0; i < num_items; ++i) {
+      EXPECT_EQ(items[i], i);
+    }
+  }
+}
+
+TEST(ThreadPoolTest, DefaultNumThreads) {
+  ASSERT_TRUE(ThreadPool::SetDefaultNumThreads(3).ok());
+  EXPECT_EQ(ThreadPool::DefaultNumThreads(), 3);
+  EXPECT_EQ(ThreadPool::Default().num_threads(), 2);
+  EXPECT_TRUE(ThreadPool::SetDefaultNumThreads(3).ok());
+  EXPECT_EQ(ThreadPool::SetDefaultNumThreads(5).code(),
+            absl::StatusCode::kFailedPrecondition);
+  EXPECT_EQ(ThreadPool::DefaultNumThreads(), 3);
+}
+
+TEST(ThreadPoolTest, ParallelForWithoutWorkers) {
+  ThreadPool pool(0);
+  size_t covered = 0;
+  ParallelFor(
+      50, 1, [&covered](size_t begin, size_t end) { covered += end - begin; },
+      pool);
+  EXPECT_EQ(covered, 50);
+}
+
+}  // namespace cryptopals::util
@@ -3,7 +3,6 @@
 
 #include <string>
 #include <string_view>
-#include <vector>
 
 #include "absl/status/statusor.h"
 #include "cryptopals/proto/cryptopals_enums.pb.h"
@@ -37,10 +36,6 @@ absl::StatusOr<EnumType> ParseEnumFromString(
   return result;
 }
 
-// Returns the input parsed from the provided input method.
-std::vector<std::string> GetInputsForMethod(std::vector<char*> inputs,
-                                            cryptopals::InputMethod method);
-
 }  // namespace cryptopals::util
 
 #endif  // CRYPTOPALS_UTIL_TOOL_HELPERS_H_
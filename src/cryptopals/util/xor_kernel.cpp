@@ -0,0 +1,163 @@
+#include "cryptopals/util/xor_kernel.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+#include "cryptopals/util/cpu_features.h"
+
+namespace cryptopals::util {
+namespace {
+
+// Short keys are repeated into a window one vector longer than the key, so
+// that a full vector of key can be loaded at any phase of the key. When the
+// key length divides the vector width the phase never changes and the same
+// register is reused; otherwise the phase rotates by the vector width modulo
+// the key length after each vector. Longer keys are applied segment by
+// segment, each segment lining up with the start of the key.
+//
+// Each function below returns the number of bytes it processed. The caller
+// finishes the remaining tail, which is shorter than a vector.
+
+#if defined(__x86_64__) || defined(__i386__)
+
+constexpr size_t AVX2_BYTES = 32;
+// Longer keys leave few enough bytes after their last whole vector that
+// applying them segment by segment is as fast as the window.
+constexpr size_t AVX2_MAX_WINDOW_KEY_BYTES = 2 * AVX2_BYTES;
+
+// The functions below are compiled for processors with AVX2 regardless of the
+// flags used for the rest of the build. They are only reached after
+// HasAvx2() has been checked.
+
+__attribute__((target("avx2"))) inline void XorVector(uint8_t* data,
+                                                      __m256i key) {
+  __m256i* block = reinterpret_cast<__m256i*>(data);
+  _mm256_storeu_si256(block, _mm256_xor_si256(_mm256_loadu_si256(block), key));
+}
+
+__attribute__((target("avx2"))) inline __m256i LoadVector(const uint8_t* key) {
+  return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(key));
+}
+
+__attribute__((target("avx2"))) size_t XorWithRepeatingKeyAvx2(
+    uint8_t* data, size_t size, const uint8_t* key, size_t key_size) {
+  if (key_size > AVX2_MAX_WINDOW_KEY_BYTES) {
+    for (size_t begin = 0; begin < size; begin += key_size) {
+      const size_t segment_size = std::min(key_size, size - begin);
+      size_t i = 0;
+      for (; i + AVX2_BYTES <= segment_size; i += AVX2_BYTES) {
+        XorVector(data + begin + i, LoadVector(key + i));
+      }
+      for (; i < segment_size; ++i) {
+        data[begin + i] ^= key[i];
+      }
+    }
+    return size;
+  }
+
+  uint8_t window[AVX2_MAX_WINDOW_KEY_BYTES + AVX2_BYTES];
+  for (size_t i = 0; i < sizeof(window); ++i) {
+    window[i] = key[i % key_size];
+  }
+
+  size_t i = 0;
+  const size_t step = AVX2_BYTES % key_size;
+  if (step == 0) {
+    const __m256i key_vector = LoadVector(window);
+    for (; i + 4 * AVX2_BYTES <= size; i += 4 * AVX2_BYTES) {
+      XorVector(data + i, key_vector);
+      XorVector(data + i + AVX2_BYTES, key_vector);
+      XorVector(data + i + 2 * AVX2_BYTES, key_vector);
+      XorVector(data + i + 3 * AVX2_BYTES, key_vector);
+    }
+    for (; i + AVX2_BYTES <= size; i += AVX2_BYTES) {
+      XorVector(data + i, key_vector);
+    }
+    return i;
+  }
+
+  size_t phase = 0;
+  for (; i + AVX2_BYTES <= size; i += AVX2_BYTES) {
+    XorVector(data + i, LoadVector(window + phase));
+    phase += step;
+    if (phase >= key_size) {
+      phase -= key_size;
+    }
+  }
+  return i;
+}
+
+#else
+
+size_t XorWithRepeatingKeyAvx2(uint8_t*, size_t, const uint8_t*, size_t) {
+  return 0;
+}
+
+#endif
+
+// The portable version of the above, working on 64-bit words.
+constexpr size_t WORD_BYTES = sizeof(uint64_t);
+
+inline void XorWord(uint8_t* data, const uint8_t* key) {
+  uint64_t data_word, key_word;
+  std::memcpy(&data_word, data, WORD_BYTES);
+  std::memcpy(&key_word, key, WORD_BYTES);
+  data_word ^= key_word;
+  std::memcpy(data, &data_word, WORD_BYTES);
+}
+
+size_t XorWithRepeatingKeyWords(uint8_t* data, size_t size, const uint8_t* key,
+                                size_t key_size) {
+  if (key_size >= WORD_BYTES) {
+    for (size_t begin = 0; begin < size; begin += key_size) {
+      const size_t segment_size = std::min(key_size, size - begin);
+      size_t i = 0;
+      for (; i + WORD_BYTES <= segment_size; i += WORD_BYTES) {
+        XorWord(data + begin + i, key + i);
+      }
+      for (; i < segment_size; ++i) {
+        data[begin + i] ^= key[i];
+      }
+    }
+    return size;
+  }
+
+  uint8_t window[2 * WORD_BYTES];
+  for (size_t i = 0; i < sizeof(window); ++i) {
+    window[i] = key[i % key_size];
+  }
+
+  size_t i = 0;
+  size_t phase = 0;
+  const size_t step = WORD_BYTES % key_size;
+  for (; i + WORD_BYTES <= size; i += WORD_BYTES) {
+    XorWord(data + i, window + phase);
+    phase += step;
+    if (phase >= key_size) {
+      phase -= key_size;
+    }
+  }
+  return i;
+}
+
+}  // namespace
+
+void XorWithRepeatingKey(std::span<uint8_t> data,
+                         std::span<const uint8_t> key) {
+  if (key.empty()) {
+    return;
+  }
+  size_t i = HasAvx2() ? XorWithRepeatingKeyAvx2(data.data(), data.size(),
+                                                 key.data(), key.size())
+                       : XorWithRepeatingKeyWords(data.data(), data.size(),
+                                                  key.data(), key.size());
+  for (; i < data.size(); ++i) {
+    data[i] ^= key[i % key.size()];
+  }
+}
+
+}  // namespace cryptopals::util
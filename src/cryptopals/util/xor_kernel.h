@@ -0,0 +1,18 @@
+// The XOR kernel behind Bytes::operator^= and the XOR ciphers.
+
+#ifndef CRYPTOPALS_UTIL_XOR_KERNEL_H_
+#define CRYPTOPALS_UTIL_XOR_KERNEL_H_
+
+#include <cstdint>
+#include <span>
+
+namespace cryptopals::util {
+
+// XORs `data` in place with `key` repeated to the length of `data`. An empty
+// `key` leaves `data` unchanged. `key` may be `data` itself, but may not
+// otherwise overlap it.
+void XorWithRepeatingKey(std::span<uint8_t> data, std::span<const uint8_t> key);
+
+}  // namespace cryptopals::util
+
+#endif  // CRYPTOPALS_UTIL_XOR_KERNEL_H_
@@ -0,0 +1,44 @@
+#include "cryptopals/util/xor_kernel.h"
+
+#include <cstdint>
+#include <vector>
+
+#include "cryptopals/util/test_data.h"
+#include "gtest/gtest.h"
+
+namespace cryptopals::util {
+namespace {
+
+// Covers keys that divide the vector width, keys that do not, and keys
+// longer than a vector, over data with and without a tail.
+TEST(XorKernelTest, MatchesBytewiseXor) {
+  for (size_t key_size = 1; key_size <= 70; ++key_size) {
+    const std::vector<uint8_t> key = PatternedBytes(key_size, 91);
+    for (size_t size : {0, 1, 7, 31, 32, 33, 100, 128, 257, 1000}) {
+      std::vector<uint8_t> data = PatternedBytes(size, 13);
+      std::vector<uint8_t> expected = data;
+      for (size_t i = 0; i < size; ++i) {
+        expected[i] ^= key[i % key_size];
+      }
+
+      XorWithRepeatingKey(data, key);
+      EXPECT_EQ(data, expected) << "key_size=" << key_size << " size=" << size;
+    }
+  }
+}
+
+TEST(XorKernelTest, EmptyKey) {
+  std::vector<uint8_t> data = PatternedBytes(40, 13);
+  const std::vector<uint8_t> expected = data;
+  XorWithRepeatingKey(data, {});
+  EXPECT_EQ(data, expected);
+}
+
+TEST(XorKernelTest, KeyIsData) {
+  std::vector<uint8_t> data = PatternedBytes(100, 13);
+  XorWithRepeatingKey(data, data);
+  EXPECT_EQ(data, std::vector<uint8_t>(100, 0));
+}
+
+}  // namespace
+}  // namespace cryptopals::util